@@ -0,0 +1,46 @@
+#ifndef RAYLIB_LUA_ALLOC_H
+#define RAYLIB_LUA_ALLOC_H
+
+#include <stddef.h>
+#include <lua.h>
+
+/**
+ * @brief Shared size-class pool allocator for Lua and raylib.
+ *
+ * Requests of up to 256 bytes are served from per-class free lists carved out
+ * of 64 KiB slabs (16-byte granularity); larger ones go to the system
+ * allocator. The pools are process-wide and thread-safe, so the Lua state and
+ * raylib (including the audio thread) can share them.
+ *
+ * Opt-in: a host passes pool_lua_alloc to lua_newstate, or a script calls
+ * EnablePoolAllocator() to chain it in front of the state's allocator.
+ * raylib itself only uses the pools when it is rebuilt with
+ * -DRL_MALLOC=pool_malloc -DRL_CALLOC=pool_calloc -DRL_REALLOC=pool_realloc
+ * -DRL_FREE=pool_free (see POOL_ALLOC_DEFS in the makefile).
+ */
+
+/** @brief malloc-compatible entry points, usable as raylib's RL_MALLOC & co. */
+void *pool_malloc(size_t size);
+void *pool_calloc(size_t count, size_t size);
+void *pool_realloc(void *ptr, size_t size);
+void pool_free(void *ptr);
+
+/**
+ * @brief lua_Alloc over the pools.
+ *
+ * `ud` is NULL when a host passes it straight to lua_newstate; blocks that
+ * did not come from a pool then go to realloc/free.
+ */
+void *pool_lua_alloc(void *ud, void *ptr, size_t osize, size_t nsize);
+
+/**
+ * @brief Closes the current allocation-statistics frame (called by EndDrawing).
+ */
+void pool_end_frame(void);
+
+/**
+ * @brief Adds GetAllocatorStats and EnablePoolAllocator to the module table on top of the stack.
+ */
+void register_alloc(lua_State *L);
+
+#endif
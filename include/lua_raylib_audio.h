@@ -5,10 +5,6 @@
 
 extern lua_State *globalLuaState;
 
-void audioStreamProcessorWrapper(void *buffer, unsigned int frames);
-void audioMixedProcessorWrapper(void *buffer, unsigned int frames);
-void audioStreamCallbackWrapper(void *buffer, unsigned int frames);
-
 /**
  * @brief Loads a sound from a file into memory.
  * 
@@ -531,14 +527,16 @@ int lua_IsSoundValid(lua_State *L);
  * 
  * @note The parameters must be provided as follows:
  *       - `sound` (Sound) - The Sound object to update.
- *       - `data` (string) - The new sound data to update the sound with.
- *       - `dataSize` (integer) - The size of the data buffer.
+ *       - `data` (string|SampleBuffer) - The new sound data, in the sound's format (32-bit float stereo).
+ *       - `frameCount` (integer) - The number of frames to copy; optional for a SampleBuffer, which is
+ *         read in place after checking its format and that the sound holds that many frames.
  * 
  * @usage
  * ```lua
  * local sound = raylib.LoadSound("resources/sound.wav")
- * local newData = raylib.GenerateCustomAudioData(44100, 2, 16) -- Simulating new sound data
- * raylib.UpdateSound(sound, newData, #newData)
+ * local frames = raylib.SampleBuffer(4410, 2)
+ * frames:sine(440, 44100, 0.5)
+ * raylib.UpdateSound(sound, frames)
  * ```
  */
 int lua_UpdateSound(lua_State *L);
@@ -702,9 +700,10 @@ int lua_WaveFormat(lua_State *L);
 /**
  * @brief Loads wave samples.
  * 
- * This function extracts raw sample data from a Wave object. 
- * The returned data is an array of float samples, with each sample normalized 
- * between -1.0f and 1.0f.
+ * This function extracts the sample data of a Wave object as a 32-bit float
+ * SampleBuffer (`frames`, `channels`, `#samples` frames) that owns the memory:
+ * freed when collected, or earlier by UnloadWaveSamples. Samples are read and
+ * written 1-based and interleaved, normalized between -1.0 and 1.0.
  * 
  * @param L A pointer to the current Lua state. This allows access to the Lua stack and other Lua-related operations.
  * 
@@ -717,10 +716,8 @@ int lua_WaveFormat(lua_State *L);
  * ```lua
  * local wave = raylib.LoadWave("resources/sound.wav")
  * local samples = raylib.LoadWaveSamples(wave)
+ * print(samples.frames, samples.channels, samples:get(1))
  * ```
- * 
- * @warning This function allocates memory for the samples. 
- * The memory should be released using `raylib.UnloadWaveSamples(samples)`.
  */
 int lua_LoadWaveSamples(lua_State *L);
 
@@ -735,7 +732,7 @@ int lua_LoadWaveSamples(lua_State *L);
  * @return int Always returns 0.
  * 
  * @note The parameters must be provided as follows:
- *       - `samples` (table) - The array of wave samples to unload.
+ *       - `samples` (SampleBuffer) - The samples returned by LoadWaveSamples.
  * 
  * @usage
  * ```lua
@@ -744,7 +741,6 @@ int lua_LoadWaveSamples(lua_State *L);
  * raylib.UnloadWaveSamples(samples)
  * ```
  * 
- * @warning Failing to unload wave samples can result in memory leaks.
  */
 int lua_UnloadWaveSamples(lua_State *L);
 
@@ -1064,14 +1060,16 @@ int lua_UnloadAudioStream(lua_State *L);
  * 
  * @note The parameters must be provided as follows:
  *       - `stream` (AudioStream) - The audio stream to update.
- *       - `data` (string) - A raw binary string containing the new audio data to be streamed.
- *       - `frameCount` (int) - The number of frames contained in the data.
+ *       - `data` (string|SampleBuffer) - Raw audio data in the stream's format, or a SampleBuffer
+ *         with the stream's sample size and channels, read in place.
+ *       - `frameCount` (int) - The number of frames contained in the data (optional for a SampleBuffer).
  * 
  * @usage
  * ```lua
  * local stream = raylib.LoadAudioStream(44100, 16, 2)
- * local audioData = "..." -- raw binary audio data
- * raylib.UpdateAudioStream(stream, audioData, 1024) -- Update the stream with 1024 frames of data
+ * local frames = raylib.SampleBuffer(1024, 2, 16)
+ * local phase = frames:sine(440, 44100, 0.5)
+ * raylib.UpdateAudioStream(stream, frames) -- Update the stream with 1024 frames of data
  * ```
  * 
  * @warning Make sure the amount of data matches the stream's format, or it may result in audio glitches or crashes.
@@ -1324,134 +1322,82 @@ int lua_SetAudioStreamPan(lua_State *L);
 int lua_SetAudioStreamBufferSizeDefault(lua_State *L);
 
 /**
- * @brief Sets a callback function for an audio stream.
+ * @brief Removed: Lua audio callbacks cannot run on the audio thread.
  * 
- * This function sets a custom callback function for an audio stream. The callback is invoked to provide audio samples 
- * for the stream, allowing for real-time synthesis or manipulation of audio data.
+ * raylib calls stream callbacks on miniaudio's thread, where entering the script's Lua state races
+ * with the main loop (and can run the garbage collector mid-callback). The binding is kept only so
+ * old scripts get a clear error.
  * 
  * @param L A pointer to the current Lua state. This allows access to the Lua stack and other Lua-related operations.
  * 
- * @return int Always returns 0, with no values pushed to the Lua stack.
- * 
- * @note The parameters must be provided as follows:
- *       - `stream` (AudioStream) - The audio stream to which the callback will be attached.
- *       - `callback` (function) - A Lua function that will be called to provide audio samples for the stream.
+ * @return int Never returns; always raises an error.
  * 
  * @usage
  * ```lua
  * local stream = raylib.LoadAudioStream(44100, 16, 2)
- * raylib.SetAudioStreamCallback(stream, function()
- *     -- Custom audio processing logic here
- * end)
- * print("Custom audio stream callback set.")
+ * local ring = raylib.AudioRing(stream)     -- instead of SetAudioStreamCallback
+ * ring:push(samples)                        -- from the main loop
  * ```
  * 
- * @warning The callback function must be lightweight and efficient to avoid introducing latency into the stream.
+ * @warning Use `AudioRing(stream)` to stream PCM generated by the script, or `Synth:attach(stream)`.
  */
 int lua_SetAudioStreamCallback(lua_State *L);
 
 /**
- * @brief Attaches a processor to an audio stream.
- * 
- * This function attaches a custom processor to an audio stream. The processor can modify audio data as it is streamed, 
- * allowing for effects such as filtering, equalization, and dynamic range compression.
+ * @brief Removed: Lua stream processors cannot run on the audio thread.
  * 
  * @param L A pointer to the current Lua state. This allows access to the Lua stack and other Lua-related operations.
  * 
- * @return int Always returns 0, with no values pushed to the Lua stack.
- * 
- * @note The parameters must be provided as follows:
- *       - `stream` (AudioStream) - The audio stream to which the processor will be attached.
- *       - `processor` (function) - A Lua function that processes audio samples in real time.
+ * @return int Never returns; always raises an error.
  * 
  * @usage
  * ```lua
- * local stream = raylib.LoadAudioStream(44100, 16, 2)
- * raylib.AttachAudioStreamProcessor(stream, function(samples)
- *     -- Apply an effect to the audio samples
- *     return samples
- * end)
- * print("Audio stream processor attached.")
+ * local graph = raylib.AudioGraph()
+ * graph:add("biquad", {type = "lowpass", freq = 800})
+ * graph:attach(stream)                      -- instead of AttachAudioStreamProcessor
  * ```
  * 
- * @warning Processor functions must be fast and efficient to avoid audio glitches or latency issues.
+ * @warning Use `AudioGraph:attach(stream | sound | music)`, which processes the stream natively.
  */
 int lua_AttachAudioStreamProcessor(lua_State *L);
 
 /**
- * @brief Detaches a processor from an audio stream.
- * 
- * This function detaches a previously attached processor from an audio stream. Once detached, the processor 
- * will no longer be called to process the stream's audio data.
+ * @brief Removed together with AttachAudioStreamProcessor.
  * 
  * @param L A pointer to the current Lua state. This allows access to the Lua stack and other Lua-related operations.
  * 
- * @return int Always returns 0, with no values pushed to the Lua stack.
- * 
- * @note The parameters must be provided as follows:
- *       - `stream` (AudioStream) - The audio stream from which the processor will be detached.
- *       - `processor` (function) - The specific Lua processor function to detach.
+ * @return int Never returns; always raises an error.
  * 
- * @usage
- * ```lua
- * local stream = raylib.LoadAudioStream(44100, 16, 2)
- * raylib.AttachAudioStreamProcessor(stream, customProcessor)
- * raylib.DetachAudioStreamProcessor(stream, customProcessor)
- * print("Processor detached from audio stream.")
- * ```
- * 
- * @warning If the specified processor is not attached to the stream, this function will have no effect.
+ * @warning Use `AudioGraph:detach()`.
  */
 int lua_DetachAudioStreamProcessor(lua_State *L);
 
 /**
- * @brief Attaches a processor to the mixed audio.
- * 
- * This function attaches a processor to the global mixed audio output. The processor can modify the final 
- * audio output before it is sent to the speakers. This is useful for effects like global equalization, 
- * reverb, or volume normalization.
+ * @brief Removed: Lua mixed processors cannot run on the audio thread.
  * 
  * @param L A pointer to the current Lua state. This allows access to the Lua stack and other Lua-related operations.
  * 
- * @return int Always returns 0, with no values pushed to the Lua stack.
- * 
- * @note The parameters must be provided as follows:
- *       - `processor` (function) - A Lua function that processes the mixed audio data.
+ * @return int Never returns; always raises an error.
  * 
  * @usage
  * ```lua
- * raylib.AttachAudioMixedProcessor(function(samples)
- *     -- Apply a low-pass filter to the mixed audio
- *     return samples
- * end)
- * print("Processor attached to mixed audio.")
+ * local graph = raylib.AudioGraph()
+ * graph:add("compressor", {threshold = -18})
+ * graph:attach()                            -- instead of AttachAudioMixedProcessor
  * ```
  * 
- * @warning The processor function must be efficient to avoid audio latency or glitches in the final mixed output.
+ * @warning Use `AudioGraph:attach()` with no target, which processes raylib's final mix natively.
  */
 int lua_AttachAudioMixedProcessor(lua_State *L);
 
 /**
- * @brief Detaches a processor from the mixed audio.
- * 
- * This function detaches a previously attached processor from the mixed audio output. Once detached, the 
- * processor will no longer be called to process the global mixed audio.
+ * @brief Removed together with AttachAudioMixedProcessor.
  * 
  * @param L A pointer to the current Lua state. This allows access to the Lua stack and other Lua-related operations.
  * 
- * @return int Always returns 0, with no values pushed to the Lua stack.
- * 
- * @note The parameters must be provided as follows:
- *       - `processor` (function) - The Lua processor function to be detached from the mixed audio.
- * 
- * @usage
- * ```lua
- * raylib.AttachAudioMixedProcessor(globalProcessor)
- * raylib.DetachAudioMixedProcessor(globalProcessor)
- * print("Processor detached from mixed audio.")
- * ```
+ * @return int Never returns; always raises an error.
  * 
- * @warning If the specified processor is not attached to the mixed audio, this function will have no effect.
+ * @warning Use `AudioGraph:detach()`.
  */
 int lua_DetachAudioMixedProcessor(lua_State *L);
 
@@ -366,6 +366,8 @@ int lua_GetMouseY(lua_State *L);
  * ```
  * 
  * @note This function is useful for creating interactive elements that track the mouse position.
+ * @note Pass a Vector2 (or table) as the optional argument to have it filled in place and
+ *       returned instead of a new table: `raylib.GetMousePosition(mousePos)`.
  * @warning The position is relative to the window, not the entire screen.
  */
 int lua_GetMousePosition(lua_State *L);
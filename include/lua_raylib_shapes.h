@@ -915,4 +915,61 @@ int lua_CheckCollisionLines(lua_State *L);
  */
 int lua_GetCollisionRec(lua_State *L);
 
+/**
+ * @brief Draws many filled rectangles in one call.
+ * 
+ * Same result as one DrawRectangleRec per rectangle, submitted as a single
+ * batch of quads.
+ * 
+ * @param L A pointer to the current Lua state. Expects 2 arguments:
+ *  - `Vec4Array rects`: One (x, y, width, height) per rectangle, or a flat Lua array of numbers.
+ *  - `Color colors`: One color for all, or one per rectangle as a PixelBuffer or a Lua array of colors.
+ * 
+ * @return int Always returns 0.
+ * 
+ * @usage
+ * ```lua
+ * local rects = raylib.Vec4Array()
+ * for i = 0, 99 do rects:push((i % 10) * 20, (i // 10) * 20, 18, 18) end
+ * raylib.DrawRectangles(rects, raylib.DARKGRAY)
+ * ```
+ */
+int lua_DrawRectangles(lua_State *L);
+
+/**
+ * @brief Draws many filled circles in one call.
+ * 
+ * @param L A pointer to the current Lua state. Expects 2 arguments:
+ *  - `Vec3Array circles`: One (centerX, centerY, radius) per circle, or a flat Lua array of numbers.
+ *  - `Color colors`: One color for all, or one per circle as a PixelBuffer or a Lua array of colors.
+ * 
+ * @return int Always returns 0.
+ * 
+ * @usage
+ * ```lua
+ * raylib.DrawCircles({ 100, 100, 10,  140, 100, 15 }, { raylib.RED, raylib.BLUE })
+ * ```
+ */
+int lua_DrawCircles(lua_State *L);
+
+/**
+ * @brief Draws many line segments in one call.
+ * 
+ * Without a thickness the segments are submitted as a single batch of GL
+ * lines, like DrawLineV; with one, each is drawn like DrawLineEx.
+ * 
+ * @param L A pointer to the current Lua state. Expects 2 or 3 arguments:
+ *  - `Vec4Array lines`: One (startX, startY, endX, endY) per segment, or a flat Lua array of numbers.
+ *  - `Color colors`: One color for all, or one per segment as a PixelBuffer or a Lua array of colors.
+ *  - `float thick` (optional): Line thickness.
+ * 
+ * @return int Always returns 0.
+ * 
+ * @usage
+ * ```lua
+ * raylib.DrawLines({ 0, 0, 100, 100,  0, 100, 100, 0 }, raylib.GREEN)
+ * ```
+ */
+int lua_DrawLines(lua_State *L);
+
 #endif
\ No newline at end of file
@@ -286,6 +286,42 @@ int lua_DrawTextEx(lua_State *L);
  */
 int lua_DrawTextPro(lua_State *L);
 
+/**
+ * @brief Sets how many string layouts the glyph layout cache keeps.
+ * 
+ * DrawText, DrawTextEx, DrawTextPro and the CommandBuffer text commands cache
+ * the glyph quads of each (font, text, size, spacing) they draw, so a string
+ * drawn again is emitted without re-decoding UTF-8 or re-walking glyph
+ * metrics. When the cache is full the least recently drawn layout is evicted.
+ * 
+ * @param L A pointer to the current Lua state. Expects 1 argument:
+ *  - `int capacity`: Maximum number of cached layouts (default 1024); 0 disables the cache.
+ * 
+ * @return int Always returns 0.
+ * 
+ * @usage
+ * ```lua
+ * raylib.SetTextLayoutCacheSize(4096)   -- a HUD with a few thousand labels
+ * ```
+ */
+int lua_SetTextLayoutCacheSize(lua_State *L);
+
+/**
+ * @brief Reports the glyph layout cache counters.
+ * 
+ * @param L A pointer to the current Lua state.
+ * 
+ * @return int Always returns 1 (table result) — `hits`, `misses`, `evictions`,
+ *         `entries`, `capacity` and `bytes` (memory held by the cached layouts).
+ * 
+ * @usage
+ * ```lua
+ * local s = raylib.GetTextLayoutCacheStats()
+ * print(("hit rate %.1f%%, %d KiB"):format(100 * s.hits / math.max(1, s.hits + s.misses), s.bytes // 1024))
+ * ```
+ */
+int lua_GetTextLayoutCacheStats(lua_State *L);
+
 /**
  * @brief Draws a single codepoint as text on the screen.
  * 
@@ -406,6 +442,7 @@ int lua_MeasureText(lua_State *L);
  * ```
  * 
  * @note Use this function to calculate how much space text will occupy on the screen.
+ * @note An optional 5th argument (Vector2 or table) receives the result in place and is returned.
  */
 int lua_MeasureTextEx(lua_State *L);
 
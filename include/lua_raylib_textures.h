@@ -111,7 +111,7 @@ int lua_UnloadTexture(lua_State *L);
  * 
  * @param L A pointer to the current Lua state. Expects 2 arguments:
  *  - `Texture2D texture`: The Texture2D object to update.
- *  - `void *data`: The new pixel data to update the texture.
+ *  - `void *data`: The new pixel data to update the texture (PixelBuffer, binary string or pointer).
  * 
  * @return int Always returns 0.
  * 
@@ -121,7 +121,8 @@ int lua_UnloadTexture(lua_State *L);
  * raylib.UpdateTexture(texture, pixelData) -- `pixelData` should be in the correct format.
  * ```
  * 
- * @note The format of `data` should match the pixel format of the texture.
+ * @note The format of `data` should match the pixel format of the texture. A PixelBuffer is
+ *       uploaded in place and checked to be RGBA8 and large enough for the texture.
  */
 int lua_UpdateTexture(lua_State *L);
 
@@ -1108,18 +1109,21 @@ int lua_ImageRotateCCW(lua_State *L);
 /**
  * @brief Loads the color data from an image.
  * 
- * This function extracts the color data from the image as an array of Color values.
+ * This function extracts the color data from the image as an RGBA8 PixelBuffer that owns
+ * the memory (freed when collected, or earlier by UnloadImageColors). Pixels are read and
+ * written as packed 0xRRGGBBAA integers, 1-based in row-major order.
  * 
  * @param L Lua state
- * @return int Always returns 1 (table of colors)
+ * @return int Always returns 1 (PixelBuffer with `width`, `height`, `#pb` pixels)
  * 
  * **Usage:**
  * ```lua
  * local image = raylib.LoadImage("source.png")
  * local colors = raylib.LoadImageColors(image) -- Extracts the image's color data
- * for i, color in ipairs(colors) do
- *     print(color.r, color.g, color.b, color.a)
+ * for i = 1, #colors do
+ *     colors:set(i, colors:get(i) | 0xFF)    -- force opaque
  * end
+ * raylib.UpdateTexture(texture, colors)      -- uploaded in place
  * ```
  */
 int lua_LoadImageColors(lua_State *L);
@@ -1130,14 +1134,14 @@ int lua_LoadImageColors(lua_State *L);
  * This function extracts a palette from the image as an array of Color values with a maximum size.
  * 
  * @param L Lua state
- * @return int Always returns 1 (table of colors)
+ * @return int Always returns 2 (PixelBuffer of colorsCount x 1 pixels, colorsCount)
  * 
  * **Usage:**
  * ```lua
  * local image = raylib.LoadImage("source.png")
  * local palette, colorsCount = raylib.LoadImagePalette(image, 16) -- Extracts a palette with up to 16 colors
- * for i, color in ipairs(palette) do
- *     print(color.r, color.g, color.b, color.a)
+ * for i = 1, colorsCount do
+ *     print(string.format("%08x", palette:get(i)))
  * end
  * ```
  */
@@ -1207,6 +1211,8 @@ int lua_GetImageAlphaBorder(lua_State *L);
  * local color = raylib.GetImageColor(image, 10, 20) -- Gets the color of the pixel at (10, 20)
  * print("Color:", color.r, color.g, color.b, color.a)
  * ```
+ *
+ * An optional 4th argument (a Color table) is overwritten and returned instead of allocating.
  */
 int lua_GetImageColor(lua_State *L);
 /**
@@ -1736,6 +1742,26 @@ int lua_DrawTextureRec(lua_State *L);
  */
 int lua_DrawTexturePro(lua_State *L);
 
+/**
+ * @brief Draws many sprites of one texture from a SpriteArray in a single call.
+ * 
+ * Each sprite is drawn exactly like DrawTexturePro with its own source, dest,
+ * origin, rotation and tint, but the quads go into the render batch in one C
+ * loop with the texture bound once.
+ * 
+ * @param L Lua state
+ * @return int Always returns 0
+ * 
+ * **Usage:**
+ * ```lua
+ * local sprites = raylib.SpriteArray()
+ * sprites:push(0, 0, 16, 16,  100, 100, 32, 32,  16, 16,  45, 0xFFFFFFFF)
+ * raylib.DrawTextureProBatch(texture, sprites)          -- all sprites
+ * raylib.DrawTextureProBatch(texture, sprites, 1, 10)   -- sprites 1..10
+ * ```
+ */
+int lua_DrawTextureProBatch(lua_State *L);
+
 /**
  * @brief Draws a texture using N-patch information.
  * 
@@ -1976,6 +2002,34 @@ int lua_ColorAlphaBlend(lua_State *L);
  */
 int lua_ColorLerp(lua_State *L);
 
+/**
+ * @brief Packed-integer variants of the color helpers above.
+ * 
+ * FadeInt, ColorFromNormalizedInt, ColorFromHSVInt, ColorTintInt, ColorBrightnessInt,
+ * ColorContrastInt, ColorAlphaInt, ColorAlphaBlendInt and ColorLerpInt take the same
+ * arguments as their table-returning counterparts but return the result as a
+ * non-negative 0xRRGGBBAA integer, which every Color parameter accepts. Use them in
+ * hot draw loops to avoid allocating a color table per call.
+ * 
+ * @param L Lua state
+ * @return int Always returns 1 (integer result)
+ * 
+ * **Usage:**
+ * ```lua
+ * local tint = raylib.ColorLerpInt(raylib.RED, raylib.BLUE, t) -- e.g. 0x7335A4FF
+ * raylib.DrawRectangle(10, 10, 100, 50, raylib.FadeInt(tint, 0.5))
+ * ```
+ */
+int lua_FadeInt(lua_State *L);
+int lua_ColorFromNormalizedInt(lua_State *L);
+int lua_ColorFromHSVInt(lua_State *L);
+int lua_ColorTintInt(lua_State *L);
+int lua_ColorBrightnessInt(lua_State *L);
+int lua_ColorContrastInt(lua_State *L);
+int lua_ColorAlphaInt(lua_State *L);
+int lua_ColorAlphaBlendInt(lua_State *L);
+int lua_ColorLerpInt(lua_State *L);
+
 /**
  * @brief Gets the integer representation of a Color.
  * 
@@ -4,6 +4,145 @@
 #include "raylib.h"
 #include <lua.h>
 
+/**
+ * @brief Packed point buffer behind the "Vec2Array", "Vec3Array" and "Vec4Array" userdata.
+ *
+ * `data` holds `count` points of `dims` floats each (2 for Vec2Array, 3 for
+ * Vec3Array, 4 for Vec4Array) laid out exactly like a Vector2[] / Vector3[] /
+ * Vector4[], so it can be handed to raylib without any marshalling. Storage
+ * grows to `capacity` points and is released by the userdata's __gc.
+ */
+typedef struct PointArray {
+    int count;
+    int capacity;
+    int dims;
+    float *data;
+} PointArray;
+
+/**
+ * @brief One DrawTexturePro call's worth of parameters, as stored in a "SpriteArray".
+ */
+typedef struct SpriteInstance {
+    Rectangle source;
+    Rectangle dest;
+    Vector2 origin;
+    float rotation;
+    Color tint;
+} SpriteInstance;
+
+/**
+ * @brief Packed sprite buffer behind the "SpriteArray" userdata.
+ *
+ * `data` holds `count` instances (storage for `capacity`), drawn in one pass
+ * by DrawTextureProBatch and released by the userdata's __gc.
+ */
+typedef struct SpriteArray {
+    int count;
+    int capacity;
+    SpriteInstance *data;
+} SpriteArray;
+
+/** @brief Instances per dirty flag of an InstanceBuffer (16 KiB of transforms). */
+#define INSTANCE_BUFFER_BLOCK 256
+
+/**
+ * @brief Persistent per-instance transforms behind the "InstanceBuffer" userdata.
+ *
+ * `transforms` holds `count` matrices as 16 floats each, in the column-major
+ * order the instance-transform attribute reads (MatrixToFloatV), followed by
+ * one `dirty` flag per INSTANCE_BUFFER_BLOCK instances. DrawMeshInstancedBuffer
+ * creates the vertex buffer `vboId` on first use and afterwards re-uploads only
+ * the blocks written since the previous draw. Tracked as a resource, so
+ * collection goes through the deferred unload queue.
+ */
+typedef struct InstanceBuffer {
+    int count;
+    unsigned int vboId;         // 0 until first drawn, or without vertex buffer support
+    float *transforms;          // one allocation, `dirty` included
+    unsigned char *dirty;
+    int dirtyBlocks;            // flags currently set
+} InstanceBuffer;
+
+/**
+ * @brief Every userdata type name the bindings check, as an X-macro.
+ *
+ * Each entry becomes a UDATA_<name> tag; register_udata_metatables() stores
+ * it in the type's metatable so check_udata / test_udata can read it instead
+ * of looking the name up in the registry on every call.
+ */
+#define RAYLIB_UDATA_TYPES(X) \
+    X(AudioStream) X(Camera) X(Font) X(GlyphInfo) X(Image) X(Material) \
+    X(Mesh) X(Model) X(ModelAnimation) X(Music) X(RenderTexture2D) \
+    X(Shader) X(Sound) X(Texture2D) X(TextureCubemap) X(Wave) \
+    X(AutomationEventList) X(GlyphInfoArray) X(VrStereoConfig) \
+    X(Vector2) X(Vector3) X(Vector4) X(Matrix) \
+    X(Vec2Array) X(Vec3Array) X(Vec4Array) X(PixelBuffer) X(SampleBuffer) \
+    X(CommandBuffer) X(SpriteArray) X(DisplayList) X(InstanceBuffer) \
+    X(AudioRing) X(AudioGraph) X(Synth) X(SoundPool)
+
+typedef enum UdataType {
+#define UDATA_ENUM(name) UDATA_##name,
+    RAYLIB_UDATA_TYPES(UDATA_ENUM)
+#undef UDATA_ENUM
+    UDATA_TYPE_COUNT
+} UdataType;
+
+/**
+ * @brief Creates the tagged metatable of every RAYLIB_UDATA_TYPES entry.
+ *
+ * Called first from luaopen_raylib; the register_* functions then fill the
+ * same tables through luaL_newmetatable, which finds them already present.
+ * The tags live in the state's own metatables, so every lua_State that
+ * requires the module is checked against its own types.
+ */
+void register_udata_metatables(lua_State *L);
+
+/**
+ * @brief luaL_checkudata comparing the metatable's tag instead of its name.
+ *
+ * Use through the check_udata(L, index, Type) macro.
+ */
+void *check_udata_tag(lua_State *L, int index, UdataType tag, const char *tname);
+
+/**
+ * @brief luaL_testudata comparing the metatable's tag instead of its name.
+ *
+ * Use through the test_udata(L, index, Type) macro.
+ */
+void *test_udata_tag(lua_State *L, int index, UdataType tag, const char *tname);
+
+#define check_udata(L, index, name) check_udata_tag((L), (index), UDATA_##name, #name)
+#define test_udata(L, index, name)  test_udata_tag((L), (index), UDATA_##name, #name)
+
+/**
+ * @brief Owned RGBA8 pixel block behind the "PixelBuffer" userdata.
+ *
+ * `data` holds width * height Colors (PIXELFORMAT_UNCOMPRESSED_R8G8B8A8),
+ * allocated with raylib's allocator so it can come straight from
+ * LoadImageColors / LoadImagePalette. It is released by the userdata's __gc,
+ * or earlier by UnloadImageColors, after which `data` is NULL.
+ */
+typedef struct PixelBuffer {
+    int width;
+    int height;
+    Color *data;
+} PixelBuffer;
+
+/**
+ * @brief Owned PCM block behind the "SampleBuffer" userdata.
+ *
+ * `data` holds frames * channels interleaved samples, 32-bit float or 16-bit
+ * signed integer (`sampleSize` 32 or 16), allocated with raylib's allocator
+ * so it can come straight from LoadWaveSamples. It is released by the
+ * userdata's __gc, or earlier by UnloadWaveSamples, after which `data` is NULL.
+ */
+typedef struct SampleBuffer {
+    int frames;
+    int channels;
+    int sampleSize;
+    void *data;
+} SampleBuffer;
+
 /**
  * @brief Converts an integer to a Color struct.
  * 
@@ -27,7 +166,300 @@ Color convert_color(int color);
 const void *get_data_buffer(lua_State *L, int index);
 
 /**
- * @brief Retrieves a Color struct from a Lua table.
+ * @brief Resolves a pixel-data argument for an upload of `pixelCount` pixels in `format`.
+ *
+ * A "PixelBuffer" is used in place after checking it is still loaded, that
+ * `format` is RGBA8 and that it holds at least `pixelCount` pixels; any other
+ * value goes through get_data_buffer unchecked, as before.
+ *
+ * @param L Lua state
+ * @param index Stack index of the data argument
+ * @param format Pixel format the consumer expects
+ * @param pixelCount Number of pixels the consumer will read
+ * @return const void* Pointer to the pixel bytes
+ */
+const void *get_pixel_data(lua_State *L, int index, int format, int pixelCount);
+
+/**
+ * @brief Pushes a "PixelBuffer" userdata taking ownership of `data` (raylib-allocated).
+ *
+ * @param L Lua state
+ * @param data width * height Colors, freed with MemFree when collected
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+void push_pixel_buffer(lua_State *L, Color *data, int width, int height);
+
+/**
+ * @brief Resolves a PCM argument and its frame count for an audio upload.
+ *
+ * A "SampleBuffer" is used in place after checking it is still loaded and
+ * matches `sampleSize` and `channels`; the frame count at `countIndex`
+ * defaults to the whole buffer and may not exceed it. Any other value goes
+ * through get_data_buffer with a required frame count, as before.
+ *
+ * @param L Lua state
+ * @param index Stack index of the data argument
+ * @param sampleSize Bits per sample the consumer expects
+ * @param channels Channels the consumer expects
+ * @param countIndex Stack index of the frame count argument
+ * @param frameCount Receives the number of frames to read
+ * @return const void* Pointer to the sample bytes
+ */
+const void *get_sample_data(lua_State *L, int index, int sampleSize, int channels, int countIndex, int *frameCount);
+
+/**
+ * @brief Pushes a "SampleBuffer" userdata taking ownership of `data` (raylib-allocated).
+ *
+ * @param L Lua state
+ * @param data frames * channels samples, freed with MemFree when collected
+ * @param frames Number of frames
+ * @param channels Samples per frame
+ * @param sampleSize 32 (float) or 16 (signed integer)
+ */
+void push_sample_buffer(lua_State *L, void *data, int frames, int channels, int sampleSize);
+
+/**
+ * @brief Kinds of tracked userdata.
+ *
+ * All kinds are counted in GetResourceStats(); all but Image and Wave are
+ * also finalized through the deferred unload queue.
+ */
+typedef enum ResourceKind {
+    RESOURCE_TEXTURE,           // Texture2D and TextureCubemap
+    RESOURCE_RENDER_TEXTURE,
+    RESOURCE_FONT,
+    RESOURCE_SHADER,
+    RESOURCE_MESH,
+    RESOURCE_MODEL,
+    RESOURCE_SOUND,
+    RESOURCE_SOUND_ALIAS,
+    RESOURCE_MUSIC,
+    RESOURCE_INSTANCE_BUFFER,
+    RESOURCE_IMAGE,             // counted only, released explicitly
+    RESOURCE_WAVE,              // counted only, released explicitly
+    RESOURCE_KIND_COUNT
+} ResourceKind;
+
+/**
+ * @brief Pushes an owned resource userdata (struct + ownership trailer) with metatable `tname`.
+ *
+ * When collected or closed the copy is queued and unloaded by the next
+ * EndDrawing / CloseWindow / CloseAudioDevice rather than inside the GC
+ * (Images and Waves have no finalizer and are only counted). User value 1 is
+ * free for anchoring what the handle borrows (e.g. the source Sound of an
+ * alias); user value 2 holds the asset cache key.
+ *
+ * @param L Lua state
+ * @param kind Resource kind; selects the struct size and the unload function
+ * @param tname Metatable name
+ * @param value Pointer to the raylib struct to copy in
+ * @return void* The userdata, laid out as the raylib struct
+ */
+void *push_resource(lua_State *L, ResourceKind kind, const char *tname, const void *value);
+
+/**
+ * @brief Marks the resource at `index` unloaded for an explicit Unload* call.
+ *
+ * @param L Lua state
+ * @param index Index of the userdata on the Lua stack
+ * @param size sizeof the raylib struct it holds
+ * @return int 1 if the caller must unload it now; 0 if it was already unloaded,
+ *         queued, or handed to another object. Untracked userdata always return 1.
+ */
+int release_resource(lua_State *L, int index, size_t size);
+
+/**
+ * @brief Re-estimates the footprint of a resource changed in place (ImageResize, WaveFormat, …).
+ */
+void retrack_resource(lua_State *L, int index, ResourceKind kind);
+
+/**
+ * @brief Transfers ownership away from the script (e.g. a Mesh moved into a Model).
+ */
+void disown_resource(lua_State *L, int index, size_t size);
+
+/**
+ * @brief Pins a resource to the object that holds it (e.g. a SoundPool voice),
+ *        or unpins it so that object can release it.
+ *
+ * Explicit Unload* calls on a pinned resource raise an error and __close
+ * leaves it alone; collection still queues it as usual.
+ */
+void pin_resource(lua_State *L, int index, size_t size, int pinned);
+
+/**
+ * @brief Whether a resource created by push_resource() was unloaded or queued.
+ *
+ * @param resource The userdata pointer push_resource() returned
+ * @param kind The kind it was pushed with
+ */
+int resource_unloaded(const void *resource, ResourceKind kind);
+
+/**
+ * @brief Texture settings a managed texture replays after being reloaded.
+ */
+typedef enum TextureParam {
+    TEXTURE_PARAM_FILTER,
+    TEXTURE_PARAM_WRAP,
+    TEXTURE_PARAM_MIPMAPS,
+    TEXTURE_PARAM_COUNT
+} TextureParam;
+
+/**
+ * @brief Puts the texture at `index` under the VRAM budget, if one is set.
+ *
+ * @param L Lua state
+ * @param index Index of the freshly pushed Texture2D userdata
+ * @param source Index of its reload source: a file path string, or an Image
+ *        (a CPU copy is kept)
+ */
+void manage_texture(lua_State *L, int index, int source);
+
+/**
+ * @brief check_udata for Texture2D that also marks a managed texture as drawn
+ *        this frame and reloads it if it was evicted.
+ *
+ * Use it for every binding that hands a texture to raylib (except Unload*).
+ */
+Texture2D *check_texture(lua_State *L, int index);
+
+/**
+ * @brief Opaque handle for touching the Texture2D at `index` once it is off
+ *        the stack (e.g. from a recorded command), or NULL if it is untracked.
+ *
+ * Valid only while the userdata is kept alive.
+ */
+void *texture_handle(lua_State *L, int index);
+
+/**
+ * @brief The check_texture bookkeeping for a texture recorded with texture_handle.
+ */
+void touch_texture(Texture2D *texture, void *handle);
+
+/**
+ * @brief Anchors the Texture2D at `index` in the display list being recorded, if any.
+ *
+ * Called by check_texture, so every texture handed to a draw binding between
+ * BeginDisplayList and EndDisplayList stays alive as long as the list.
+ */
+void display_list_capture_texture(lua_State *L, int index);
+
+/**
+ * @brief Abandons a display list still being recorded (called by CloseWindow).
+ */
+void cancel_display_list(lua_State *L);
+
+/**
+ * @brief DrawTextEx through the glyph layout cache (lua_raylib_text.c).
+ *
+ * A cached (font, text, size, spacing) is drawn as a straight run of quads;
+ * a miss lays the string out once and caches it. Falls back to DrawTextEx
+ * when the cache is disabled.
+ */
+void draw_text_cached(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint);
+
+/**
+ * @brief DrawText (default font, size floor and spacing) through the glyph layout cache.
+ */
+void draw_text_default_cached(const char *text, int posX, int posY, int fontSize, Color color);
+
+/**
+ * @brief Drops the cached layouts of `font`, or every layout when `font` is NULL.
+ *
+ * Called before a font is unloaded (its glyph array may be reused by the next
+ * one) and when the GL context goes away.
+ */
+void forget_text_layouts(const Font *font);
+
+/**
+ * @brief Frees an InstanceBuffer's transforms and, when `gpu` is set, its vertex buffer.
+ *
+ * Used by UnloadInstanceBuffer and by the unload queue, which passes gpu = 0
+ * once the GL context (and the buffer with it) is gone.
+ */
+void unload_instance_buffer(InstanceBuffer *buf, int gpu);
+
+/**
+ * @brief Stops feeding `stream` from the mixer thread, or every fed stream when `stream` is NULL.
+ *
+ * Called before an AudioStream, Sound or Music is unloaded and before the audio
+ * device closes, so no native callback or processor outlives its buffer.
+ */
+void detach_stream_feeds(const AudioStream *stream);
+
+/**
+ * @brief Forgets the device sample rate the mixer probed, before the audio device closes.
+ */
+void reset_device_sample_rate(void);
+
+/**
+ * @brief Exempts a managed texture from eviction (its id was stored in a
+ *        material or shader state, or its contents were updated in place).
+ */
+void pin_texture(lua_State *L, int index);
+
+/**
+ * @brief Records a setting to replay when a managed texture is reloaded.
+ */
+void remember_texture_param(lua_State *L, int index, TextureParam param, int value);
+
+/**
+ * @brief Advances the budget's frame counter and evicts down to the budget (called by EndDrawing).
+ */
+void texture_budget_end_frame(void);
+
+/**
+ * @brief Pushes the asset cache key for a file load: "kind|normalized path[|param]".
+ *
+ * Relative paths are resolved against the working directory and ".", ".."
+ * and repeated or backslash separators are folded.
+ *
+ * @param L Lua state
+ * @param kind Metatable name of the loaded type, e.g. "Texture2D"
+ * @param fileName Path as passed by the script
+ * @param param Extra load parameter (font size), or -1 for none
+ * @return const char* The key, kept alive by the pushed string
+ */
+const char *push_asset_key(lua_State *L, const char *kind, const char *fileName, int param);
+
+/**
+ * @brief Looks `key` up in the asset cache.
+ *
+ * @return int 1 on a hit, with the shared userdata pushed and its reference
+ *         count bumped; 0 on a miss, with nothing pushed.
+ */
+int asset_cache_lookup(lua_State *L, ResourceKind kind, const char *key);
+
+/**
+ * @brief Shares the resource on top of the stack under `key` (only valid loads should be cached).
+ */
+void asset_cache_insert(lua_State *L, ResourceKind kind, const char *key);
+
+/**
+ * @brief Unloads every queued resource whose context is still alive.
+ *
+ * @return int Number of resources unloaded; entries for a closed window or
+ *         audio device are dropped.
+ */
+int flush_unload_queue(void);
+
+/**
+ * @brief Packs a Color struct into a non-negative 0xRRGGBBAA Lua integer.
+ *
+ * The inverse of convert_color; unlike raylib's ColorToInt the result is never
+ * negative, so it compares equal to the same hex literal written in Lua.
+ *
+ * @param color The Color struct to pack
+ * @return lua_Integer The packed color
+ */
+lua_Integer pack_color(Color color);
+
+/**
+ * @brief Retrieves a Color struct from a Lua table or packed integer.
+ *
+ * A Lua integer is taken as 0xRRGGBBAA and decoded without touching any
+ * table; otherwise the value must be a table with r, g, b and a fields.
  * 
  * @param L Lua state
  * @param index Index of the table on the Lua stack
@@ -36,7 +468,10 @@ const void *get_data_buffer(lua_State *L, int index);
 Color get_color_from_table(lua_State *L, int index);
 
 /**
- * @brief Retrieves a Vector2 struct from a Lua table.
+ * @brief Retrieves a Vector2 struct from a Lua table or "Vector2" userdata.
+ *
+ * A "Vector2" userdata is copied out directly; any other value must be a
+ * table with numeric "x" and "y" fields.
  * 
  * @param L Lua state
  * @param index Index of the table on the Lua stack
@@ -45,16 +480,86 @@ Color get_color_from_table(lua_State *L, int index);
 Vector2 get_vector2_from_table(lua_State *L, int index);
 
 /**
- * @brief Retrieves an array of Vector2 structs from a Lua table.
- * 
+ * @brief Allocates a transient buffer from the lua_State's scratch arena.
+ *
+ * For marshalling buffers that only live for the duration of one binding
+ * call. Memory is 16-byte aligned and never needs free(): hand it back with
+ * scratch_pop once done, and anything left behind (e.g. when a Lua error
+ * unwinds past the pop) is reclaimed by scratch_reset, which EndDrawing calls
+ * every frame. Raises a Lua error when out of memory.
+ *
  * @param L Lua state
- * @param index Index of the table on the Lua stack
- * @return Vector2* Pointer to the array of Vector2 structs
+ * @param size Number of bytes
+ * @return void* Pointer to the buffer
+ */
+void *scratch_alloc(lua_State *L, size_t size);
+
+/**
+ * @brief Returns `p` and everything allocated after it to the scratch arena.
+ *
+ * Allocations are stack-like: pop in reverse order of scratch_alloc.
+ */
+void scratch_pop(lua_State *L, void *p);
+
+/**
+ * @brief Empties the scratch arena, folding any outgrown blocks into one.
+ */
+void scratch_reset(lua_State *L);
+
+/**
+ * @brief Pushes a {capacity, used, peak, blocks} table describing the scratch arena.
+ */
+void push_scratch_stats(lua_State *L);
+
+/**
+ * @brief Reads a Lua array of integers into a scratch buffer (release with scratch_pop).
+ *
+ * @param L Lua state
+ * @param index Stack index of the table
+ * @param count Receives the number of elements
+ * @return int* Pointer to the values
  */
-Vector2 *get_vector2_array_from_table(lua_State *L, int index);
+int *get_int_array_from_table(lua_State *L, int index, int *count);
 
 /**
- * @brief Retrieves a Vector3 struct from a Lua table.
+ * @brief Reads a Lua array of numbers into a scratch float buffer (release with scratch_pop).
+ */
+float *get_float_array_from_table(lua_State *L, int index, int *count);
+
+/**
+ * @brief Resolves a point-list argument to a contiguous Vector2 array.
+ *
+ * A "Vec2Array" userdata is used in place (zero copy); a Lua array of vectors
+ * is converted into a scratch buffer. Either way the result must be handed
+ * back through release_vector2_list with the same stack index.
+ *
+ * @param L Lua state
+ * @param index Stack index of the Vec2Array or table
+ * @param count Receives the number of points
+ * @return Vector2* Pointer to the points
+ */
+Vector2 *get_vector2_list(lua_State *L, int index, int *count);
+
+/**
+ * @brief Releases a buffer obtained from get_vector2_list (no-op for a Vec2Array).
+ */
+void release_vector2_list(lua_State *L, int index, Vector2 *points);
+
+/**
+ * @brief Resolves a point-list argument to a contiguous Vector3 array.
+ *
+ * Same contract as get_vector2_list, for "Vec3Array" userdata or a Lua array
+ * of Vector3 values.
+ */
+Vector3 *get_vector3_list(lua_State *L, int index, int *count);
+
+/**
+ * @brief Releases a buffer obtained from get_vector3_list (no-op for a Vec3Array).
+ */
+void release_vector3_list(lua_State *L, int index, Vector3 *points);
+
+/**
+ * @brief Retrieves a Vector3 struct from a Lua table or "Vector3" userdata.
  * 
  * @param L Lua state
  * @param index Index of the table on the Lua stack
@@ -63,7 +568,7 @@ Vector2 *get_vector2_array_from_table(lua_State *L, int index);
 Vector3 get_vector3_from_table(lua_State *L, int index);
 
 /**
- * @brief Retrieves a Vector4 struct from a Lua table.
+ * @brief Retrieves a Vector4 struct from a Lua table or "Vector4" userdata.
  * 
  * @param L Lua state
  * @param index Index of the table on the Lua stack
@@ -72,7 +577,10 @@ Vector3 get_vector3_from_table(lua_State *L, int index);
 Vector4 get_vector4_from_table(lua_State *L, int index);
 
 /**
- * @brief Retrieves a Matrix struct from a Lua table.
+ * @brief Retrieves a Matrix struct from a Lua table or "Matrix" userdata.
+ *
+ * A "Matrix" userdata holds the 16 floats of the raylib struct and is copied
+ * out with a single memcpy; a table must carry the fields m0..m15.
  * 
  * @param L Lua state
  * @param index Index of the table on the Lua stack
@@ -167,6 +675,81 @@ void push_rectangle_to_table(lua_State *L, Rectangle rect);
  */
 void push_matrix_to_table(lua_State *L, Matrix mat);
 
+/**
+ * @brief Returns a Vector2 result through an optional destination argument.
+ *
+ * When the argument at `out` is nil/absent a new {x, y} table is pushed, as
+ * before. A "Vector2" userdata or a plain table there is overwritten in place
+ * and pushed back instead, so per-frame callers can reuse one object and
+ * allocate nothing. Anything else raises an argument error.
+ *
+ * @param L Lua state
+ * @param out Stack index of the optional destination (one past the last input)
+ * @param vec The result
+ * @return int Number of values pushed (always 1)
+ */
+int return_vector2(lua_State *L, int out, Vector2 vec);
+
+/**
+ * @brief Same as return_vector2 for a Vector3 result ("Vector3" userdata or table).
+ */
+int return_vector3(lua_State *L, int out, Vector3 vec);
+
+/**
+ * @brief Same as return_vector2 for a Vector4 result ("Vector4" userdata or table).
+ */
+int return_vector4(lua_State *L, int out, Vector4 vec);
+
+/**
+ * @brief Returns a Matrix result as a "Matrix" userdata.
+ *
+ * Unlike the vector helpers the default is a new "Matrix" userdata, not a
+ * table; a "Matrix" destination at `out` is overwritten in place and returned.
+ */
+int return_matrix(lua_State *L, int out, Matrix mat);
+
+/**
+ * @brief Same as return_vector2 for a Rectangle result (destination must be a table).
+ */
+int return_rectangle(lua_State *L, int out, Rectangle rect);
+
+/**
+ * @brief Same as return_vector2 for a Color result (destination must be a table).
+ */
+int return_color(lua_State *L, int out, Color color);
+
+/**
+ * @brief Pushes a Vector2 struct as a Lua userdata carrying the "Vector2" metatable.
+ *
+ * @param L Lua state
+ * @param vec The Vector2 struct to push
+ */
+void push_vector2_to_userdata(lua_State *L, Vector2 vec);
+
+/**
+ * @brief Pushes a Vector3 struct as a Lua userdata carrying the "Vector3" metatable.
+ *
+ * @param L Lua state
+ * @param vec The Vector3 struct to push
+ */
+void push_vector3_to_userdata(lua_State *L, Vector3 vec);
+
+/**
+ * @brief Pushes a Vector4 struct as a Lua userdata carrying the "Vector4" metatable.
+ *
+ * @param L Lua state
+ * @param vec The Vector4 struct to push
+ */
+void push_vector4_to_userdata(lua_State *L, Vector4 vec);
+
+/**
+ * @brief Pushes a Matrix struct as a Lua userdata carrying the "Matrix" metatable.
+ *
+ * @param L Lua state
+ * @param mat The Matrix struct to push
+ */
+void push_matrix_to_userdata(lua_State *L, Matrix mat);
+
 /**
  * @brief Pushes an Image struct as a Lua userdata carrying the "Image" metatable.
  *
@@ -1,6 +1,6 @@
 -- Audio streaming demo: generate a 440 Hz tone in Lua and feed it to an
--- AudioStream as 16-bit signed stereo PCM. This exercises UpdateAudioStream
--- with a Lua binary string (the supported way to pass sample data).
+-- AudioStream as 16-bit signed stereo PCM. The samples live in a SampleBuffer
+-- that UpdateAudioStream reads in place, so a refill allocates nothing.
 --
 -- Note: AttachAudioStreamProcessor is intentionally not used here — its callback
 -- receives a raw buffer pointer rather than an indexable sample table, so it
@@ -20,27 +20,15 @@ raylib.PlayAudioStream(stream)
 
 local frequency = 440.0          -- A4
 local phase     = 0.0
-local twoPi     = 2.0 * math.pi
-local step      = twoPi * frequency / SAMPLE_RATE
-
--- Build one buffer of 16-bit signed stereo PCM as a binary string.
-local function generateTone()
-    local samples = {}
-    for i = 1, FRAMES do
-        local s = math.floor(math.sin(phase) * 16000)
-        phase = phase + step
-        if phase >= twoPi then phase = phase - twoPi end
-        samples[i] = string.pack("<i2i2", s, s)   -- left, right
-    end
-    return table.concat(samples)
-end
+local tone      = raylib.SampleBuffer(FRAMES, CHANNELS, 16)
 
 local BLACK    = {r = 0,   g = 0,   b = 0,   a = 255}
 local RAYWHITE = {r = 245, g = 245, b = 245, a = 255}
 
 while not raylib.WindowShouldClose() do
     if raylib.IsAudioStreamProcessed(stream) then
-        raylib.UpdateAudioStream(stream, generateTone(), FRAMES)
+        phase = tone:sine(frequency, SAMPLE_RATE, 0.5, phase)   -- same sample on both channels
+        raylib.UpdateAudioStream(stream, tone)
     end
 
     raylib.BeginDrawing()
@@ -18,36 +18,48 @@ void push_color(lua_State *L, Color color) {
     lua_pushinteger(L, color.a); lua_setfield(L, -2, "a");
 }
 
-// Function to register the colors as global constants
-void register_raylib_colors(lua_State *L) {
+// Named raylib colors
+static const struct { const char *name; Color color; } raylib_colors[] = {
+    { "LIGHTGRAY", { 200, 200, 200, 255 } },
+    { "GRAY", { 130, 130, 130, 255 } },
+    { "DARKGRAY", { 80, 80, 80, 255 } },
+    { "YELLOW", { 253, 249, 0, 255 } },
+    { "GOLD", { 255, 203, 0, 255 } },
+    { "ORANGE", { 255, 161, 0, 255 } },
+    { "PINK", { 255, 109, 194, 255 } },
+    { "RED", { 230, 41, 55, 255 } },
+    { "MAROON", { 190, 33, 55, 255 } },
+    { "GREEN", { 0, 228, 48, 255 } },
+    { "LIME", { 0, 158, 47, 255 } },
+    { "DARKGREEN", { 0, 117, 44, 255 } },
+    { "SKYBLUE", { 102, 191, 255, 255 } },
+    { "BLUE", { 0, 121, 241, 255 } },
+    { "DARKBLUE", { 0, 82, 172, 255 } },
+    { "PURPLE", { 200, 122, 255, 255 } },
+    { "VIOLET", { 135, 60, 190, 255 } },
+    { "DARKPURPLE", { 112, 31, 126, 255 } },
+    { "BEIGE", { 211, 176, 131, 255 } },
+    { "BROWN", { 127, 106, 79, 255 } },
+    { "DARKBROWN", { 76, 63, 47, 255 } },
 
-    push_color(L, (Color){ 200, 200, 200, 255 }); lua_setglobal(L, "LIGHTGRAY");
-    push_color(L, (Color){ 130, 130, 130, 255 }); lua_setglobal(L, "GRAY");
-    push_color(L, (Color){ 80, 80, 80, 255 }); lua_setglobal(L, "DARKGRAY");
-    push_color(L, (Color){ 253, 249, 0, 255 }); lua_setglobal(L, "YELLOW");
-    push_color(L, (Color){ 255, 203, 0, 255 }); lua_setglobal(L, "GOLD");
-    push_color(L, (Color){ 255, 161, 0, 255 }); lua_setglobal(L, "ORANGE");
-    push_color(L, (Color){ 255, 109, 194, 255 }); lua_setglobal(L, "PINK");
-    push_color(L, (Color){ 230, 41, 55, 255 }); lua_setglobal(L, "RED");
-    push_color(L, (Color){ 190, 33, 55, 255 }); lua_setglobal(L, "MAROON");
-    push_color(L, (Color){ 0, 228, 48, 255 }); lua_setglobal(L, "GREEN");
-    push_color(L, (Color){ 0, 158, 47, 255 }); lua_setglobal(L, "LIME");
-    push_color(L, (Color){ 0, 117, 44, 255 }); lua_setglobal(L, "DARKGREEN");
-    push_color(L, (Color){ 102, 191, 255, 255 }); lua_setglobal(L, "SKYBLUE");
-    push_color(L, (Color){ 0, 121, 241, 255 }); lua_setglobal(L, "BLUE");
-    push_color(L, (Color){ 0, 82, 172, 255 }); lua_setglobal(L, "DARKBLUE");
-    push_color(L, (Color){ 200, 122, 255, 255 }); lua_setglobal(L, "PURPLE");
-    push_color(L, (Color){ 135, 60, 190, 255 }); lua_setglobal(L, "VIOLET");
-    push_color(L, (Color){ 112, 31, 126, 255 }); lua_setglobal(L, "DARKPURPLE");
-    push_color(L, (Color){ 211, 176, 131, 255 }); lua_setglobal(L, "BEIGE");
-    push_color(L, (Color){ 127, 106, 79, 255 }); lua_setglobal(L, "BROWN");
-    push_color(L, (Color){ 76, 63, 47, 255 }); lua_setglobal(L, "DARKBROWN");
+    { "WHITE", { 255, 255, 255, 255 } },
+    { "BLACK", { 0, 0, 0, 255 } },
+    { "BLANK", { 0, 0, 0, 0 } },
+    { "MAGENTA", { 255, 0, 255, 255 } },
+    { "RAYWHITE", { 245, 245, 245, 255 } },
+    { NULL, { 0, 0, 0, 0 } }
+};
 
-    push_color(L, (Color){ 255, 255, 255, 255 }); lua_setglobal(L, "WHITE");
-    push_color(L, (Color){ 0, 0, 0, 255 }); lua_setglobal(L, "BLACK");
-    push_color(L, (Color){ 0, 0, 0, 0 }); lua_setglobal(L, "BLANK");
-    push_color(L, (Color){ 255, 0, 255, 255 }); lua_setglobal(L, "MAGENTA");
-    push_color(L, (Color){ 245, 245, 245, 255 }); lua_setglobal(L, "RAYWHITE");
+// Function to register the colors as global constants ({r,g,b,a} tables) and
+// as packed 0xRRGGBBAA integers on the module table at the top of the stack
+// (raylib.RED, ...), which every Color parameter accepts without a table read.
+void register_raylib_colors(lua_State *L) {
+    for (int i = 0; raylib_colors[i].name != NULL; i++) {
+        push_color(L, raylib_colors[i].color);
+        lua_setglobal(L, raylib_colors[i].name);
+        lua_pushinteger(L, pack_color(raylib_colors[i].color));
+        lua_setfield(L, -2, raylib_colors[i].name);
+    }
 }
 
 // Register bindings
@@ -336,6 +348,7 @@ static const luaL_Reg raylib_functions[] = {
     {"DrawTextureEx", lua_DrawTextureEx},
     {"DrawTextureRec", lua_DrawTextureRec},
     {"DrawTexturePro", lua_DrawTexturePro},
+    {"DrawTextureProBatch", lua_DrawTextureProBatch},
     {"DrawTextureNPatch", lua_DrawTextureNPatch},
     {"ColorIsEqual", lua_ColorIsEqual},
     {"Fade", lua_Fade},
@@ -350,6 +363,15 @@ static const luaL_Reg raylib_functions[] = {
     {"ColorAlpha", lua_ColorAlpha},
     {"ColorAlphaBlend", lua_ColorAlphaBlend},
     {"ColorLerp", lua_ColorLerp},
+    {"FadeInt", lua_FadeInt},
+    {"ColorFromNormalizedInt", lua_ColorFromNormalizedInt},
+    {"ColorFromHSVInt", lua_ColorFromHSVInt},
+    {"ColorTintInt", lua_ColorTintInt},
+    {"ColorBrightnessInt", lua_ColorBrightnessInt},
+    {"ColorContrastInt", lua_ColorContrastInt},
+    {"ColorAlphaInt", lua_ColorAlphaInt},
+    {"ColorAlphaBlendInt", lua_ColorAlphaBlendInt},
+    {"ColorLerpInt", lua_ColorLerpInt},
     {"GetColor", lua_GetColor},
     {"GetPixelColor", lua_GetPixelColor},
     {"SetPixelColor", lua_SetPixelColor},
@@ -441,6 +463,8 @@ static const luaL_Reg raylib_functions[] = {
     {"DrawTextCodepoint", lua_DrawTextCodepoint},
     {"DrawTextCodepoints", lua_DrawTextCodepoints},
     {"SetTextLineSpacing", lua_SetTextLineSpacing},
+    {"SetTextLayoutCacheSize", lua_SetTextLayoutCacheSize},
+    {"GetTextLayoutCacheStats", lua_GetTextLayoutCacheStats},
     {"MeasureText", lua_MeasureText},
     {"MeasureTextEx", lua_MeasureTextEx},
     {"GetGlyphIndex", lua_GetGlyphIndex},
@@ -530,37 +554,53 @@ static const luaL_Reg raylib_functions[] = {
     {"CheckCollisionPointPoly", lua_CheckCollisionPointPoly},
     {"CheckCollisionLines", lua_CheckCollisionLines},
     {"GetCollisionRec", lua_GetCollisionRec},
+    {"DrawRectangles", lua_DrawRectangles},
+    {"DrawCircles", lua_DrawCircles},
+    {"DrawLines", lua_DrawLines},
 
     {NULL, NULL} 
 };
 
-// Register an (empty) named metatable for every Raylib userdata type. Without
-// these, luaL_setmetatable() would silently attach a nil metatable and the
-// matching luaL_checkudata() would then reject every object. The metatables
-// carry no methods: Raylib objects are driven through the module's free
-// functions and released explicitly with the matching Unload* call.
-static void register_raylib_metatables(lua_State *L) {
-    static const char *const typeNames[] = {
-        "AudioStream", "Camera", "Font", "GlyphInfo", "Image", "Material",
-        "Mesh", "Model", "ModelAnimation", "Music", "RenderTexture2D",
-        "Shader", "Sound", "Texture2D", "TextureCubemap", "Wave",
-        "AutomationEventList", "GlyphInfoArray", "VrStereoConfig", NULL
-    };
-    for (int i = 0; typeNames[i] != NULL; i++) {
-        luaL_newmetatable(L, typeNames[i]);
-        lua_pop(L, 1);
-    }
-}
+// Defined in lua_raylib_alloc.c — adds GetAllocatorStats and
+// EnablePoolAllocator (the pool allocator is opt-in).
+void register_alloc(lua_State *L);
 
 // Defined in lua_raylib_extra.c — adds the extra bindings (mode pairs, camera,
 // shaders, input, filesystem, …) onto the module table at the top of the stack.
 void register_extra(lua_State *L);
 
+// Defined in lua_raylib_types.c — creates the native value-type metatables
+// (Vector2/3/4, Matrix, Vec2Array/Vec3Array/Vec4Array, PixelBuffer, SpriteArray) and adds their constructors onto the module table.
+void register_types(lua_State *L);
+
+// Defined in lua_raylib_commands.c — creates the CommandBuffer, DisplayList and
+// InstanceBuffer metatables and adds the recorded-drawing functions onto the
+// module table.
+void register_commands(lua_State *L);
+
+// Defined in lua_raylib_mixer.c — creates the AudioRing, AudioGraph, Synth and
+// SoundPool metatables and adds the audio constructors onto the module table.
+void register_mixer(lua_State *L);
+
+// Defined in lua_raylib_generated.c (tools/gen_bindings.lua) — adds the
+// generated bindings for every raylib/raymath function not bound by hand.
+void register_generated(lua_State *L);
+
+// Defined in lua_raylib_resources.c — installs the deferred-unload finalizers
+// on the resource metatables and adds FlushUnloadQueue/GetUnloadQueueSize.
+void register_resources(lua_State *L);
+
 int luaopen_raylib(lua_State *L) {
     globalLuaState = L;
-    register_raylib_metatables(L);
+    register_udata_metatables(L);   // first: every register_* below fills these
     luaL_newlib(L, raylib_functions);
+    register_alloc(L);
     register_extra(L);
+    register_types(L);
+    register_commands(L);
+    register_mixer(L);
+    register_resources(L);
+    register_generated(L);       // after every hand-written binding, which wins on a name clash
     register_raylib_colors(L);
     return 1;
 }
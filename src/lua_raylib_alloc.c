@@ -0,0 +1,419 @@
+// lua_raylib_alloc.c
+//
+// Size-class pool allocator shared by the Lua state and (when raylib is built
+// with the RL_MALLOC overrides) raylib. Lua churns through small fixed-size
+// objects — tables, short strings, closures, the {x=, y=} result tables — and
+// serving those from per-class free lists keeps them out of the system heap,
+// where they fragment long sessions and contend with raylib's loaders.
+//
+// Memory is reserved in 4 MiB arenas, aligned to their size and split into
+// 64 KiB slabs; each slab is dedicated to one size class and carved on
+// demand. Arenas are never returned to the system. A pointer belongs to the
+// pools iff it lies inside an arena, so blocks allocated before the pool
+// allocator was installed (or above the largest class) are recognised as
+// foreign and handed back to whoever allocated them. Masking a pointer gives
+// the base of its would-be arena, looked up in an insert-only hash table
+// published with release/acquire, so that lookup is O(1) and takes no lock;
+// each size class has its own spinlock.
+//
+// Nothing is installed on require: a host passes pool_lua_alloc to
+// lua_newstate, or a script calls EnablePoolAllocator() to chain it in front
+// of the state's current allocator.
+//
+// Allocation counters are kept per frame: pool_end_frame() (EndDrawing)
+// moves the running counters into the "last frame" snapshot.
+//
+// This file does not include raylib.h, so it can include <windows.h>.
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <malloc.h>
+#else
+    #ifndef _GNU_SOURCE
+        #define _GNU_SOURCE
+    #endif
+    #include <dlfcn.h>
+#endif
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lua.h>
+#include <lauxlib.h>
+#include "lua_raylib_alloc.h"
+
+#define POOL_GRANULE   16
+#define POOL_MAX_SIZE  256
+#define POOL_CLASSES   (POOL_MAX_SIZE / POOL_GRANULE)
+#define SLAB_SIZE      (64 * 1024)
+#define ARENA_SLABS    64                 // 4 MiB per arena
+#define MAX_ARENAS     256                // pools stop growing at 1 GiB and fall back
+#define ARENA_BYTES    ((size_t)ARENA_SLABS * SLAB_SIZE)
+#define ARENA_TABLE    (MAX_ARENAS * 2)   // open addressing, at most half full
+
+#define CLASS_OF_SIZE(size) ((int)(((size) - 1) / POOL_GRANULE))
+#define CLASS_SIZE(cls)     ((size_t)((cls) + 1) * POOL_GRANULE)
+
+typedef struct Arena {
+    unsigned char *base;
+    unsigned char slabClass[ARENA_SLABS];  // size class of every carved slab
+    int slabsUsed;                         // guarded by arena_lock
+} Arena;
+
+typedef struct PoolClass {
+    atomic_int lock;
+    void *freeList;
+    unsigned char *bump;                   // uncarved rest of the newest slab
+    unsigned char *bumpEnd;
+    size_t live;
+    size_t slabs;
+} PoolClass;
+
+typedef struct AllocCounters {
+    atomic_size_t allocs;
+    atomic_size_t frees;
+    atomic_size_t bytes;                   // bytes requested by allocations
+    atomic_size_t pooled;                  // allocations served by a pool
+} AllocCounters;
+
+typedef struct AllocSnapshot {
+    size_t allocs, frees, bytes, pooled;
+} AllocSnapshot;
+
+static Arena arenas[MAX_ARENAS];
+static _Atomic(Arena *) arena_table[ARENA_TABLE];
+static atomic_int arena_count;
+static atomic_int arena_lock;
+static PoolClass pools[POOL_CLASSES];
+
+static AllocCounters frame_counters;
+static AllocSnapshot last_frame;
+static AllocSnapshot totals;               // every completed frame
+
+static void spin_lock(atomic_int *lock) {
+    while (atomic_exchange_explicit(lock, 1, memory_order_acquire)) {}
+}
+
+static void spin_unlock(atomic_int *lock) {
+    atomic_store_explicit(lock, 0, memory_order_release);
+}
+
+static void count_alloc(size_t size, int pooled) {
+    atomic_fetch_add_explicit(&frame_counters.allocs, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&frame_counters.bytes, size, memory_order_relaxed);
+    if (pooled) atomic_fetch_add_explicit(&frame_counters.pooled, 1, memory_order_relaxed);
+}
+
+static void count_free(void) {
+    atomic_fetch_add_explicit(&frame_counters.frees, 1, memory_order_relaxed);
+}
+
+static size_t arena_slot(uintptr_t base) {
+    return (size_t)((base / ARENA_BYTES) * 2654435761u) & (ARENA_TABLE - 1);
+}
+
+// Size class of a pooled block, or -1 for memory the pools do not own.
+static int class_of(const void *ptr) {
+    uintptr_t base = (uintptr_t)ptr & ~(uintptr_t)(ARENA_BYTES - 1);
+    for (size_t i = arena_slot(base);; i = (i + 1) & (ARENA_TABLE - 1)) {
+        Arena *arena = atomic_load_explicit(&arena_table[i], memory_order_acquire);
+        if (arena == NULL) return -1;
+        if ((uintptr_t)arena->base == base)
+            return arena->slabClass[((uintptr_t)ptr - base) / SLAB_SIZE];
+    }
+}
+
+static unsigned char *alloc_arena(void) {
+#if defined(_WIN32)
+    return _aligned_malloc(ARENA_BYTES, ARENA_BYTES);
+#else
+    void *base;
+    return posix_memalign(&base, ARENA_BYTES, ARENA_BYTES) == 0 ? base : NULL;
+#endif
+}
+
+static unsigned char *new_slab(int cls) {
+    unsigned char *slab = NULL;
+    spin_lock(&arena_lock);
+    int count = atomic_load_explicit(&arena_count, memory_order_relaxed);
+    Arena *arena = (count > 0 && arenas[count - 1].slabsUsed < ARENA_SLABS) ? &arenas[count - 1] : NULL;
+    if (arena == NULL && count < MAX_ARENAS) {
+        unsigned char *base = alloc_arena();
+        if (base != NULL) {
+            arena = &arenas[count];
+            arena->base = base;
+            arena->slabsUsed = 0;
+            size_t i = arena_slot((uintptr_t)base);
+            while (atomic_load_explicit(&arena_table[i], memory_order_relaxed) != NULL) i = (i + 1) & (ARENA_TABLE - 1);
+            atomic_store_explicit(&arena_table[i], arena, memory_order_release);
+            atomic_store_explicit(&arena_count, count + 1, memory_order_release);
+        }
+    }
+    if (arena != NULL) {
+        int index = arena->slabsUsed++;
+        arena->slabClass[index] = (unsigned char)cls;
+        slab = arena->base + (size_t)index * SLAB_SIZE;
+    }
+    spin_unlock(&arena_lock);
+    return slab;
+}
+
+// `size` must be in 1..POOL_MAX_SIZE. NULL once the arenas are exhausted.
+static void *slab_alloc(size_t size) {
+    int cls = CLASS_OF_SIZE(size);
+    size_t blockSize = CLASS_SIZE(cls);
+    PoolClass *pool = &pools[cls];
+    spin_lock(&pool->lock);
+    void *p = pool->freeList;
+    if (p != NULL) {
+        pool->freeList = *(void **)p;
+    } else {
+        if (pool->bump == NULL || pool->bump + blockSize > pool->bumpEnd) {
+            unsigned char *slab = new_slab(cls);
+            if (slab == NULL) {
+                spin_unlock(&pool->lock);
+                return NULL;
+            }
+            pool->bump = slab;
+            pool->bumpEnd = slab + SLAB_SIZE;
+            pool->slabs++;
+        }
+        p = pool->bump;
+        pool->bump += blockSize;
+    }
+    pool->live++;
+    spin_unlock(&pool->lock);
+    return p;
+}
+
+static void slab_free(void *ptr, int cls) {
+    PoolClass *pool = &pools[cls];
+    spin_lock(&pool->lock);
+    *(void **)ptr = pool->freeList;
+    pool->freeList = ptr;
+    pool->live--;
+    spin_unlock(&pool->lock);
+}
+
+void *pool_malloc(size_t size) {
+    void *p = (size > 0 && size <= POOL_MAX_SIZE) ? slab_alloc(size) : NULL;
+    count_alloc(size, p != NULL);
+    return (p != NULL) ? p : malloc(size);
+}
+
+void *pool_calloc(size_t count, size_t size) {
+    if (size != 0 && count > (size_t)-1 / size) return NULL;
+    void *p = pool_malloc(count * size);
+    if (p != NULL) memset(p, 0, count * size);
+    return p;
+}
+
+void pool_free(void *ptr) {
+    if (ptr == NULL) return;
+    int cls = class_of(ptr);
+    count_free();
+    if (cls >= 0) slab_free(ptr, cls);
+    else free(ptr);
+}
+
+void *pool_realloc(void *ptr, size_t size) {
+    if (ptr == NULL) return pool_malloc(size);
+    if (size == 0) {
+        pool_free(ptr);
+        return NULL;
+    }
+    int cls = class_of(ptr);
+    if (cls < 0) {                         // a malloc block: its old size is unknown, so it stays one
+        count_alloc(size, 0);
+        return realloc(ptr, size);
+    }
+    size_t blockSize = CLASS_SIZE(cls);
+    if (size <= blockSize) return ptr;
+    void *grown = pool_malloc(size);
+    if (grown == NULL) return NULL;
+    memcpy(grown, ptr, blockSize);
+    pool_free(ptr);
+    return grown;
+}
+
+// The allocator the state had before luaopen_raylib chained in front of it.
+typedef struct ChainedAlloc {
+    lua_Alloc f;
+    void *ud;
+} ChainedAlloc;
+
+static void *foreign_realloc(const ChainedAlloc *prev, void *ptr, size_t osize, size_t nsize) {
+    if (prev != NULL) return prev->f(prev->ud, ptr, osize, nsize);
+    if (nsize == 0) {
+        free(ptr);
+        return NULL;
+    }
+    return realloc(ptr, nsize);
+}
+
+void *pool_lua_alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
+    const ChainedAlloc *prev = ud;
+    if (nsize == 0) {
+        if (ptr != NULL) {
+            int cls = class_of(ptr);
+            count_free();
+            if (cls >= 0) slab_free(ptr, cls);
+            else foreign_realloc(prev, ptr, osize, 0);
+        }
+        return NULL;
+    }
+    if (ptr == NULL) {                     // osize is the object type here, not a size
+        void *p = (nsize <= POOL_MAX_SIZE) ? slab_alloc(nsize) : NULL;
+        count_alloc(nsize, p != NULL);
+        return (p != NULL) ? p : foreign_realloc(prev, NULL, osize, nsize);
+    }
+    int cls = class_of(ptr);
+    if (cls >= 0) {
+        if (nsize <= CLASS_SIZE(cls)) return ptr;   // shrinking must not fail: keep the block
+        void *grown = pool_lua_alloc(ud, NULL, 0, nsize);
+        if (grown == NULL) return NULL;
+        memcpy(grown, ptr, osize);
+        count_free();
+        slab_free(ptr, cls);
+        return grown;
+    }
+    if (nsize <= POOL_MAX_SIZE) {          // a large or pre-existing block shrinking into a class
+        void *p = slab_alloc(nsize);
+        if (p != NULL) {
+            memcpy(p, ptr, osize < nsize ? osize : nsize);
+            foreign_realloc(prev, ptr, osize, 0);
+            count_alloc(nsize, 1);
+            count_free();
+            return p;
+        }
+    }
+    count_alloc(nsize, 0);
+    return foreign_realloc(prev, ptr, osize, nsize);
+}
+
+void pool_end_frame(void) {
+    last_frame.allocs = atomic_exchange_explicit(&frame_counters.allocs, 0, memory_order_relaxed);
+    last_frame.frees = atomic_exchange_explicit(&frame_counters.frees, 0, memory_order_relaxed);
+    last_frame.bytes = atomic_exchange_explicit(&frame_counters.bytes, 0, memory_order_relaxed);
+    last_frame.pooled = atomic_exchange_explicit(&frame_counters.pooled, 0, memory_order_relaxed);
+    totals.allocs += last_frame.allocs;
+    totals.frees += last_frame.frees;
+    totals.bytes += last_frame.bytes;
+    totals.pooled += last_frame.pooled;
+}
+
+// Keeps this library mapped until the process exits. lua_close() runs the
+// package library's dlclose finalizer before it frees the remaining objects
+// through the state's allocator, which would otherwise be unmapped by then.
+static int pin_module(void) {
+#if defined(_WIN32)
+    HMODULE module;
+    return GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_PIN,
+                              (LPCSTR)(void *)&pool_lua_alloc, &module) != 0;
+#else
+    Dl_info info;
+    if (!dladdr((void *)&pool_lua_alloc, &info) || info.dli_fname == NULL) return 0;
+    return dlopen(info.dli_fname, RTLD_NOW | RTLD_NOLOAD | RTLD_NODELETE) != NULL;
+#endif
+}
+
+static void push_snapshot(lua_State *L, AllocSnapshot s) {
+    lua_createtable(L, 0, 5);
+    lua_pushinteger(L, (lua_Integer)s.allocs);
+    lua_setfield(L, -2, "allocs");
+    lua_pushinteger(L, (lua_Integer)s.frees);
+    lua_setfield(L, -2, "frees");
+    lua_pushinteger(L, (lua_Integer)s.bytes);
+    lua_setfield(L, -2, "bytes");
+    lua_pushinteger(L, (lua_Integer)s.pooled);
+    lua_setfield(L, -2, "pooled");
+    lua_pushinteger(L, (lua_Integer)(s.allocs - s.pooled));
+    lua_setfield(L, -2, "fallback");
+}
+
+static int lua_GetAllocatorStats(lua_State *L) {
+    AllocSnapshot current = {
+        atomic_load_explicit(&frame_counters.allocs, memory_order_relaxed),
+        atomic_load_explicit(&frame_counters.frees, memory_order_relaxed),
+        atomic_load_explicit(&frame_counters.bytes, memory_order_relaxed),
+        atomic_load_explicit(&frame_counters.pooled, memory_order_relaxed),
+    };
+    AllocSnapshot total = {
+        totals.allocs + current.allocs, totals.frees + current.frees,
+        totals.bytes + current.bytes, totals.pooled + current.pooled,
+    };
+    void *ud;
+    lua_createtable(L, 0, 8);
+    push_snapshot(L, last_frame);
+    lua_setfield(L, -2, "frame");
+    push_snapshot(L, current);
+    lua_setfield(L, -2, "current");
+    push_snapshot(L, total);
+    lua_setfield(L, -2, "total");
+
+    size_t liveBlocks = 0, liveBytes = 0, slabs = 0;
+    lua_createtable(L, POOL_CLASSES, 0);
+    for (int cls = 0; cls < POOL_CLASSES; cls++) {
+        PoolClass *pool = &pools[cls];
+        spin_lock(&pool->lock);
+        size_t live = pool->live, classSlabs = pool->slabs;
+        spin_unlock(&pool->lock);
+        liveBlocks += live;
+        liveBytes += live * CLASS_SIZE(cls);
+        slabs += classSlabs;
+        lua_createtable(L, 0, 3);
+        lua_pushinteger(L, (lua_Integer)CLASS_SIZE(cls));
+        lua_setfield(L, -2, "size");
+        lua_pushinteger(L, (lua_Integer)live);
+        lua_setfield(L, -2, "live");
+        lua_pushinteger(L, (lua_Integer)classSlabs);
+        lua_setfield(L, -2, "slabs");
+        lua_rawseti(L, -2, cls + 1);
+    }
+    lua_setfield(L, -2, "classes");
+    lua_pushinteger(L, (lua_Integer)liveBlocks);
+    lua_setfield(L, -2, "liveBlocks");
+    lua_pushinteger(L, (lua_Integer)liveBytes);
+    lua_setfield(L, -2, "liveBytes");
+    lua_pushinteger(L, (lua_Integer)(slabs * SLAB_SIZE));
+    lua_setfield(L, -2, "slabBytes");
+    lua_pushinteger(L, (lua_Integer)atomic_load(&arena_count) * (lua_Integer)ARENA_BYTES);
+    lua_setfield(L, -2, "reservedBytes");
+    lua_pushboolean(L, lua_getallocf(L, &ud) == pool_lua_alloc);
+    lua_setfield(L, -2, "luaPooled");
+    return 1;
+}
+
+// EnablePoolAllocator() -> enabled. Chains the pools in front of the state's
+// current allocator; best called right after require, before the state has
+// allocated much. Pins this library in memory (see pin_module), so the
+// blocks still owned by the pools can be freed during lua_close.
+static int lua_EnablePoolAllocator(lua_State *L) {
+    void *ud;
+    lua_Alloc f = lua_getallocf(L, &ud);
+    if (f == pool_lua_alloc) {
+        lua_pushboolean(L, 1);
+        return 1;
+    }
+    // Lives as long as the state; lua_close offers no hook after its last
+    // allocation, so it is never freed.
+    ChainedAlloc *prev = pin_module() ? malloc(sizeof(ChainedAlloc)) : NULL;
+    if (prev != NULL) {
+        prev->f = f;
+        prev->ud = ud;
+        lua_setallocf(L, pool_lua_alloc, prev);
+    }
+    lua_pushboolean(L, prev != NULL);
+    return 1;
+}
+
+static const luaL_Reg alloc_functions[] = {
+    {"GetAllocatorStats", lua_GetAllocatorStats},
+    {"EnablePoolAllocator", lua_EnablePoolAllocator},
+    {NULL, NULL}
+};
+
+void register_alloc(lua_State *L) {
+    luaL_setfuncs(L, alloc_functions, 0);
+}
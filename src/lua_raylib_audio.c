@@ -5,33 +5,37 @@ lua_State *globalLuaState = NULL;
 
 int lua_LoadSound(lua_State *L) {
     const char *fileName = luaL_checkstring(L, 1);
+    const char *key = push_asset_key(L, "Sound", fileName, -1);
+    if (asset_cache_lookup(L, RESOURCE_SOUND, key)) return 1;
     Sound sound = LoadSound(fileName);
-    Sound *pSound = lua_newuserdata(L, sizeof(Sound));
-    *pSound = sound;
-    luaL_setmetatable(L, "Sound");
+    push_resource(L, RESOURCE_SOUND, "Sound", &sound);
+    if (IsSoundValid(sound)) asset_cache_insert(L, RESOURCE_SOUND, key);
     return 1;
 }
 
 int lua_PlaySound(lua_State *L) {
-    Sound *sound = luaL_checkudata(L, 1, "Sound");
+    Sound *sound = check_udata(L, 1, Sound);
     PlaySound(*sound);
     return 0;
 }
 
 int lua_StopSound(lua_State *L) {
-    Sound *sound = luaL_checkudata(L, 1, "Sound");
+    Sound *sound = check_udata(L, 1, Sound);
     StopSound(*sound);
     return 0;
 }
 
 int lua_UnloadSound(lua_State *L) {
-    Sound *sound = luaL_checkudata(L, 1, "Sound");
-    UnloadSound(*sound);
+    Sound *sound = check_udata(L, 1, Sound);
+    if (release_resource(L, 1, sizeof(Sound))) {
+        detach_stream_feeds(&sound->stream);
+        UnloadSound(*sound);
+    }
     return 0;
 }
 
 int lua_SetSoundVolume(lua_State *L) {
-    Sound *sound = luaL_checkudata(L, 1, "Sound");
+    Sound *sound = check_udata(L, 1, Sound);
     float volume = luaL_checknumber(L, 2);
     SetSoundVolume(*sound, volume);
     return 0;
@@ -40,39 +44,37 @@ int lua_SetSoundVolume(lua_State *L) {
 int lua_LoadMusicStream(lua_State *L) {
     const char *fileName = luaL_checkstring(L, 1);
     Music music = LoadMusicStream(fileName);
-    Music *pMusic = lua_newuserdata(L, sizeof(Music));
-    *pMusic = music;
-    luaL_setmetatable(L, "Music");
+    push_resource(L, RESOURCE_MUSIC, "Music", &music);
     return 1;
 }
 
 int lua_PlayMusicStream(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     PlayMusicStream(*music);
     return 0;
 }
 
 int lua_StopMusicStream(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     StopMusicStream(*music);
     return 0;
 }
 
 int lua_UpdateMusicStream(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     UpdateMusicStream(*music);
     return 0;
 }
 
 int lua_SetMusicVolume(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     float volume = luaL_checknumber(L, 2);
     SetMusicVolume(*music, volume);
     return 0;
 }
 
 int lua_IsSoundPlaying(lua_State *L) {
-    Sound *sound = luaL_checkudata(L, 1, "Sound");
+    Sound *sound = check_udata(L, 1, Sound);
     lua_pushboolean(L, IsSoundPlaying(*sound));
     return 1;
 }
@@ -83,6 +85,9 @@ int lua_InitAudioDevice(lua_State *L) {
 }
 
 int lua_CloseAudioDevice(lua_State *L) {
+    flush_unload_queue();   // collected sounds and streams need the device to unload
+    detach_stream_feeds(NULL);
+    reset_device_sample_rate();
     CloseAudioDevice();
     return 0;
 }
@@ -106,9 +111,7 @@ int lua_GetMasterVolume(lua_State *L) {
 int lua_LoadWave(lua_State *L) {
     const char *fileName = luaL_checkstring(L, 1);
     Wave wave = LoadWave(fileName);
-    Wave *pWave = lua_newuserdata(L, sizeof(Wave));
-    *pWave = wave;
-    luaL_setmetatable(L, "Wave");
+    push_resource(L, RESOURCE_WAVE, "Wave", &wave);
     return 1;
 }
 
@@ -117,174 +120,184 @@ int lua_LoadWaveFromMemory(lua_State *L) {
     const char *fileData = luaL_checkstring(L, 2);
     int dataSize = luaL_checkinteger(L, 3);
     Wave wave = LoadWaveFromMemory(fileType, (unsigned char *)fileData, dataSize);
-    Wave *pWave = lua_newuserdata(L, sizeof(Wave));
-    *pWave = wave;
-    luaL_setmetatable(L, "Wave");
+    push_resource(L, RESOURCE_WAVE, "Wave", &wave);
     return 1;
 }
 
 int lua_IsWaveValid(lua_State *L) {
-    Wave *wave = luaL_checkudata(L, 1, "Wave");
+    Wave *wave = check_udata(L, 1, Wave);
     lua_pushboolean(L, IsWaveValid(*wave));
     return 1;
 }
 
 int lua_LoadSoundFromWave(lua_State *L) {
-    Wave *wave = luaL_checkudata(L, 1, "Wave");
+    Wave *wave = check_udata(L, 1, Wave);
     Sound sound = LoadSoundFromWave(*wave);
-    Sound *pSound = lua_newuserdata(L, sizeof(Sound));
-    *pSound = sound;
-    luaL_setmetatable(L, "Sound");
+    push_resource(L, RESOURCE_SOUND, "Sound", &sound);
     return 1;
 }
 
 int lua_LoadSoundAlias(lua_State *L) {
-    Sound *source = luaL_checkudata(L, 1, "Sound");
+    Sound *source = check_udata(L, 1, Sound);
     Sound alias = LoadSoundAlias(*source);
-    Sound *pAlias = lua_newuserdata(L, sizeof(Sound));
-    *pAlias = alias;
-    luaL_setmetatable(L, "Sound");
+    push_resource(L, RESOURCE_SOUND_ALIAS, "Sound", &alias);
+    lua_pushvalue(L, 1);            // the alias plays the source's samples: keep it alive
+    lua_setiuservalue(L, -2, 1);
     return 1;
 }
 
 int lua_IsSoundValid(lua_State *L) {
-    Sound *sound = luaL_checkudata(L, 1, "Sound");
+    Sound *sound = check_udata(L, 1, Sound);
     lua_pushboolean(L, IsSoundValid(*sound));
     return 1;
 }
 
 int lua_UpdateSound(lua_State *L) {
-    Sound *sound = luaL_checkudata(L, 1, "Sound");
-    const void *data = get_data_buffer(L, 2);
-    int sampleCount = luaL_checkinteger(L, 3);
-    UpdateSound(*sound, data, sampleCount);
+    Sound *sound = check_udata(L, 1, Sound);
+    int frameCount;
+    const void *data = get_sample_data(L, 2, (int)sound->stream.sampleSize, (int)sound->stream.channels, 3, &frameCount);
+    if (test_udata(L, 2, SampleBuffer) != NULL)
+        luaL_argcheck(L, (unsigned int)frameCount <= sound->frameCount, 3, "more frames than the sound holds");
+    UpdateSound(*sound, data, frameCount);
     return 0;
 }
 
 int lua_UnloadWave(lua_State *L) {
-    Wave *wave = luaL_checkudata(L, 1, "Wave");
-    UnloadWave(*wave);
+    Wave *wave = check_udata(L, 1, Wave);
+    if (release_resource(L, 1, sizeof(Wave))) UnloadWave(*wave);
     return 0;
 }
 
 int lua_UnloadSoundAlias(lua_State *L) {
-    Sound *alias = luaL_checkudata(L, 1, "Sound");
-    UnloadSoundAlias(*alias);
+    Sound *alias = check_udata(L, 1, Sound);
+    if (release_resource(L, 1, sizeof(Sound))) {
+        detach_stream_feeds(&alias->stream);
+        UnloadSoundAlias(*alias);
+    }
     return 0;
 }
 
 int lua_ExportWave(lua_State *L) {
-    Wave *wave = luaL_checkudata(L, 1, "Wave");
+    Wave *wave = check_udata(L, 1, Wave);
     const char *fileName = luaL_checkstring(L, 2);
     lua_pushboolean(L, ExportWave(*wave, fileName));
     return 1;
 }
 
 int lua_ExportWaveAsCode(lua_State *L) {
-    Wave *wave = luaL_checkudata(L, 1, "Wave");
+    Wave *wave = check_udata(L, 1, Wave);
     const char *fileName = luaL_checkstring(L, 2);
     lua_pushboolean(L, ExportWaveAsCode(*wave, fileName));
     return 1;
 }
 
 int lua_WaveCopy(lua_State *L) {
-    Wave *wave = luaL_checkudata(L, 1, "Wave");
+    Wave *wave = check_udata(L, 1, Wave);
     Wave copiedWave = WaveCopy(*wave);
-    Wave *pCopiedWave = lua_newuserdata(L, sizeof(Wave));
-    *pCopiedWave = copiedWave;
-    luaL_setmetatable(L, "Wave");
+    push_resource(L, RESOURCE_WAVE, "Wave", &copiedWave);
     return 1;
 }
 
 int lua_WaveCrop(lua_State *L) {
-    Wave *wave = luaL_checkudata(L, 1, "Wave");
+    Wave *wave = check_udata(L, 1, Wave);
     int initFrame = luaL_checkinteger(L, 2);
     int finalFrame = luaL_checkinteger(L, 3);
     WaveCrop(wave, initFrame, finalFrame);
+    retrack_resource(L, 1, RESOURCE_WAVE);
     return 0;
 }
 
 int lua_WaveFormat(lua_State *L) {
-    Wave *wave = luaL_checkudata(L, 1, "Wave");
+    Wave *wave = check_udata(L, 1, Wave);
     int sampleRate = luaL_checkinteger(L, 2);
     int sampleSize = luaL_checkinteger(L, 3);
     int channels = luaL_checkinteger(L, 4);
     WaveFormat(wave, sampleRate, sampleSize, channels);
+    retrack_resource(L, 1, RESOURCE_WAVE);
     return 0;
 }
 
 int lua_LoadWaveSamples(lua_State *L) {
-    Wave *wave = luaL_checkudata(L, 1, "Wave");
+    Wave *wave = check_udata(L, 1, Wave);
     float *samples = LoadWaveSamples(*wave);
-    lua_pushlightuserdata(L, samples);
+    push_sample_buffer(L, samples, (int)wave->frameCount, (int)wave->channels, 32);
     return 1;
 }
 
 int lua_UnloadWaveSamples(lua_State *L) {
-    float *samples = (float *)lua_touserdata(L, 1);
-    UnloadWaveSamples(samples);
+    SampleBuffer *sb = test_udata(L, 1, SampleBuffer);
+    if (sb != NULL) {
+        UnloadWaveSamples(sb->data);
+        sb->data = NULL;
+        sb->frames = 0;
+    } else if (lua_islightuserdata(L, 1)) {
+        UnloadWaveSamples(lua_touserdata(L, 1));
+    }
     return 0;
 }
 
 int lua_IsMusicValid(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     lua_pushboolean(L, IsMusicValid(*music));
     return 1;
 }
 
 int lua_UnloadMusicStream(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
-    UnloadMusicStream(*music);
+    Music *music = check_udata(L, 1, Music);
+    if (release_resource(L, 1, sizeof(Music))) {
+        detach_stream_feeds(&music->stream);
+        UnloadMusicStream(*music);
+    }
     return 0;
 }
 
 int lua_IsMusicStreamPlaying(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     lua_pushboolean(L, IsMusicStreamPlaying(*music));
     return 1;
 }
 
 int lua_PauseMusicStream(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     PauseMusicStream(*music);
     return 0;
 }
 
 int lua_ResumeMusicStream(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     ResumeMusicStream(*music);
     return 0;
 }
 
 int lua_SeekMusicStream(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     float position = luaL_checknumber(L, 2);
     SeekMusicStream(*music, position);
     return 0;
 }
 
 int lua_SetMusicPitch(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     float pitch = luaL_checknumber(L, 2);
     SetMusicPitch(*music, pitch);
     return 0;
 }
 
 int lua_SetMusicPan(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     float pan = luaL_checknumber(L, 2);
     SetMusicPan(*music, pan);
     return 0;
 }
 
 int lua_GetMusicTimeLength(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     lua_pushnumber(L, GetMusicTimeLength(*music));
     return 1;
 }
 
 int lua_GetMusicTimePlayed(lua_State *L) {
-    Music *music = luaL_checkudata(L, 1, "Music");
+    Music *music = check_udata(L, 1, Music);
     lua_pushnumber(L, GetMusicTimePlayed(*music));
     return 1;
 }
@@ -301,77 +314,78 @@ int lua_LoadAudioStream(lua_State *L) {
 }
 
 int lua_IsAudioStreamValid(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
     lua_pushboolean(L, IsAudioStreamValid(*stream));
     return 1;
 }
 
 int lua_UnloadAudioStream(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
+    detach_stream_feeds(stream);
     UnloadAudioStream(*stream);
     return 0;
 }
 
 int lua_UpdateAudioStream(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
-    const void *data = get_data_buffer(L, 2);
-    int frameCount = luaL_checkinteger(L, 3);
+    AudioStream *stream = check_udata(L, 1, AudioStream);
+    int frameCount;
+    const void *data = get_sample_data(L, 2, (int)stream->sampleSize, (int)stream->channels, 3, &frameCount);
     UpdateAudioStream(*stream, data, frameCount);
     return 0;
 }
 
 int lua_IsAudioStreamProcessed(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
     lua_pushboolean(L, IsAudioStreamProcessed(*stream));
     return 1;
 }
 
 int lua_PlayAudioStream(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
     PlayAudioStream(*stream);
     return 0;
 }
 
 int lua_PauseAudioStream(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
     PauseAudioStream(*stream);
     return 0;
 }
 
 int lua_ResumeAudioStream(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
     ResumeAudioStream(*stream);
     return 0;
 }
 
 int lua_IsAudioStreamPlaying(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
     lua_pushboolean(L, IsAudioStreamPlaying(*stream));
     return 1;
 }
 
 int lua_StopAudioStream(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
     StopAudioStream(*stream);
     return 0;
 }
 
 int lua_SetAudioStreamVolume(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
     float volume = luaL_checknumber(L, 2);
     SetAudioStreamVolume(*stream, volume);
     return 0;
 }
 
 int lua_SetAudioStreamPitch(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
     float pitch = luaL_checknumber(L, 2);
     SetAudioStreamPitch(*stream, pitch);
     return 0;
 }
 
 int lua_SetAudioStreamPan(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
+    AudioStream *stream = check_udata(L, 1, AudioStream);
     float pan = luaL_checknumber(L, 2);
     SetAudioStreamPan(*stream, pan);
     return 0;
@@ -383,51 +397,26 @@ int lua_SetAudioStreamBufferSizeDefault(lua_State *L) {
     return 0;
 }
 
+// raylib runs stream callbacks and processors on miniaudio's thread, where
+// calling into the script's lua_State races with the main loop. These names
+// stay registered only to point old scripts at the native mixer API.
+
 int lua_AttachAudioStreamProcessor(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
-    AttachAudioStreamProcessor(*stream, audioStreamProcessorWrapper);
-    return 0;
+    return luaL_error(L, "AttachAudioStreamProcessor: Lua cannot run on the audio thread; use AudioGraph():attach(stream)");
 }
 
 int lua_DetachAudioStreamProcessor(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
-    DetachAudioStreamProcessor(*stream, audioStreamProcessorWrapper);
-    return 0;
+    return luaL_error(L, "DetachAudioStreamProcessor: Lua cannot run on the audio thread; use AudioGraph:detach()");
 }
 
 int lua_AttachAudioMixedProcessor(lua_State *L) {
-    AttachAudioMixedProcessor(audioMixedProcessorWrapper);
-    return 0;
+    return luaL_error(L, "AttachAudioMixedProcessor: Lua cannot run on the audio thread; use AudioGraph():attach()");
 }
 
 int lua_DetachAudioMixedProcessor(lua_State *L) {
-    DetachAudioMixedProcessor(audioMixedProcessorWrapper);
-    return 0;
+    return luaL_error(L, "DetachAudioMixedProcessor: Lua cannot run on the audio thread; use AudioGraph:detach()");
 }
 
 int lua_SetAudioStreamCallback(lua_State *L) {
-    AudioStream *stream = luaL_checkudata(L, 1, "AudioStream");
-    SetAudioStreamCallback(*stream, audioStreamCallbackWrapper);
-    return 0;
+    return luaL_error(L, "SetAudioStreamCallback: Lua cannot run on the audio thread; use AudioRing(stream) or Synth:attach(stream)");
 }
-
-void audioStreamProcessorWrapper(void *buffer, unsigned int frames) {
-    lua_getglobal(globalLuaState, "audioStreamProcessorWrapper");
-    lua_pushlightuserdata(globalLuaState, buffer);
-    lua_pushinteger(globalLuaState, frames);
-    lua_pcall(globalLuaState, 2, 0, 0);
-}
-
-void audioMixedProcessorWrapper(void *buffer, unsigned int frames) {
-    lua_getglobal(globalLuaState, "audioMixedProcessorWrapper");
-    lua_pushlightuserdata(globalLuaState, buffer);
-    lua_pushinteger(globalLuaState, frames);
-    lua_pcall(globalLuaState, 2, 0, 0);
-}
-
-void audioStreamCallbackWrapper(void *buffer, unsigned int frames) {
-    lua_getglobal(globalLuaState, "audioStreamCallbackWrapper");
-    lua_pushlightuserdata(globalLuaState, buffer);
-    lua_pushinteger(globalLuaState, frames);
-    lua_pcall(globalLuaState, 2, 0, 0);
-}
\ No newline at end of file
@@ -0,0 +1,817 @@
+// lua_raylib_commands.c
+//
+// Recorded draw commands. A "CommandBuffer" userdata holds a packed array of
+// fixed-size DrawCommand records that scripts append to through methods
+// (cb:rect, cb:sprite, cb:text, …); ExecuteCommandBuffer(cb) then replays the
+// whole array against raylib in one C loop, so a frame of sprites costs one
+// boundary crossing to submit instead of one per draw call, and the argument
+// decoding happens once, when the command is recorded.
+//
+// Buffers are not cleared by executing them: a static scene can be recorded
+// once and executed every frame, or cleared with cb:clear() and re-recorded.
+// Commands keep raw pointers to the Texture2D / Font userdata and text strings
+// they reference, so every such value is also stored as a key of the buffer's
+// anchor table (user value 1) until the next clear. Textures under the VRAM
+// budget are touched (and reloaded if evicted) when the command executes, not
+// when it is recorded.
+//
+// Display lists work one level lower. BeginDisplayList() points rlgl at a
+// private render batch, so the ordinary draw bindings called until
+// EndDisplayList() fill it with vertices instead of drawing; EndDisplayList()
+// copies the vertex stream and its draw calls (primitive mode, texture) into
+// a "DisplayList" userdata. DrawDisplayList(list[, transform]) feeds that
+// stream back into the current rlgl batch, optionally through a matrix, with
+// no Lua work per primitive. Anything that flushes the batch while recording
+// (running out of room, too many texture switches, a mode change such as
+// BeginMode2D or BeginBlendMode) makes EndDisplayList() fail rather than
+// return a partial list. Recording needs rlgl's render batch, so it is not
+// available on the OpenGL 1.1 and software renderers. Textures passed to draw
+// bindings during recording are anchored by the list and touched on replay,
+// and a managed texture that was reloaded since is drawn with its new id.
+//
+// An "InstanceBuffer" keeps DrawMeshInstanced transforms on the GPU. Scripts
+// write single transforms or ranges into its CPU copy; the first
+// DrawMeshInstancedBuffer(mesh, material, buf[, count]) creates the vertex
+// buffer and later draws upload only the 256-instance blocks written since,
+// so a mostly static set of instances costs no per-frame marshalling or
+// upload. Without VAO / vertex buffer support it falls back to
+// DrawMeshInstanced with the CPU copy.
+//
+// register_commands() creates the metatables and adds the constructors,
+// ExecuteCommandBuffer, the display list and the instance buffer functions
+// to the module table.
+
+#include <stdlib.h>
+#include <string.h>
+#include "raylib.h"
+#define RAYMATH_STATIC_INLINE
+#include "raymath.h"
+#include "rlgl.h"
+#include <lua.h>
+#include <lauxlib.h>
+#include "raylib_wrappers.h"
+
+typedef enum CommandType {
+    CMD_RECT,
+    CMD_RECT_LINES,
+    CMD_CIRCLE,
+    CMD_LINE,
+    CMD_TEXTURE,
+    CMD_SPRITE,
+    CMD_TEXT,
+    CMD_TEXT_EX,
+} CommandType;
+
+typedef struct DrawCommand {
+    unsigned char type;
+    Color color;
+    union {
+        Rectangle rect;                                     // CMD_RECT, CMD_RECT_LINES
+        struct { Vector2 center; float radius; } circle;
+        struct { Vector2 start, end; } line;
+        struct {
+            Texture2D *texture;
+            void *handle;                                   // texture_handle(), for the VRAM budget
+            Rectangle source, dest;                         // CMD_TEXTURE only uses dest.x/y
+            Vector2 origin;
+            float rotation;
+        } sprite;
+        struct {
+            const char *text;
+            Font *font;                                     // CMD_TEXT_EX only
+            Vector2 position;
+            float fontSize, spacing;
+        } text;
+    } as;
+} DrawCommand;
+
+typedef struct CommandBuffer {
+    int count;
+    int capacity;
+    DrawCommand *commands;
+    const void *lastAnchor;     // most recently anchored value, to skip repeats
+} CommandBuffer;
+
+static CommandBuffer *check_command_buffer(lua_State *L, int idx) {
+    return check_udata(L, idx, CommandBuffer);
+}
+
+static void command_buffer_reserve(lua_State *L, CommandBuffer *cb, int capacity) {
+    if (capacity <= cb->capacity) return;
+    DrawCommand *commands = realloc(cb->commands, sizeof(DrawCommand) * (size_t)capacity);
+    if (commands == NULL) luaL_error(L, "out of memory growing command buffer to %d commands", capacity);
+    cb->commands = commands;
+    cb->capacity = capacity;
+}
+
+// Returns the next free command slot, set to `type`, for the caller to fill
+// in. The slot only becomes part of the buffer once the caller bumps
+// cb->count, after every argument was checked, so a bad argument never leaves
+// a half-written command behind.
+static DrawCommand *push_command(lua_State *L, CommandBuffer *cb, CommandType type, int colorIndex) {
+    Color color = get_color_from_table(L, colorIndex);
+    if (cb->count == cb->capacity) command_buffer_reserve(L, cb, cb->capacity < 16 ? 16 : cb->capacity * 2);
+    DrawCommand *cmd = &cb->commands[cb->count];
+    cmd->type = (unsigned char)type;
+    cmd->color = color;
+    return cmd;
+}
+
+// Keeps the value at `idx` (a userdata or string a command points into) alive
+// until the buffer is cleared or collected.
+static void anchor_value(lua_State *L, CommandBuffer *cb, int idx) {
+    const void *p = lua_topointer(L, idx);
+    if (p == cb->lastAnchor) return;
+    lua_getiuservalue(L, 1, 1);
+    lua_pushvalue(L, idx);
+    lua_pushboolean(L, 1);
+    lua_rawset(L, -3);
+    lua_pop(L, 1);
+    cb->lastAnchor = p;
+}
+
+// Anchors the string at `idx` and returns its bytes (numbers are converted in place first).
+static const char *anchor_string(lua_State *L, CommandBuffer *cb, int idx) {
+    const char *text = luaL_checkstring(L, idx);
+    anchor_value(L, cb, idx);
+    return text;
+}
+
+// CommandBuffer([capacity]): an empty buffer with room for `capacity` commands.
+static int lua_CommandBuffer(lua_State *L) {
+    lua_Integer capacity = luaL_optinteger(L, 1, 0);
+    luaL_argcheck(L, capacity >= 0 && capacity <= 0x7fffffff / (lua_Integer)sizeof(DrawCommand), 1, "capacity out of range");
+    CommandBuffer *cb = lua_newuserdatauv(L, sizeof(CommandBuffer), 1);
+    cb->count = 0; cb->capacity = 0; cb->commands = NULL; cb->lastAnchor = NULL;
+    luaL_setmetatable(L, "CommandBuffer");
+    lua_newtable(L);
+    lua_setiuservalue(L, -2, 1);
+    command_buffer_reserve(L, cb, (int)capacity);
+    return 1;
+}
+
+// cb:rect(x, y, width, height, color) — DrawRectangleRec
+static int command_buffer_rect(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    DrawCommand *cmd = push_command(L, cb, CMD_RECT, 6);
+    cmd->as.rect = (Rectangle){ (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3),
+                                (float)luaL_checknumber(L, 4), (float)luaL_checknumber(L, 5) };
+    cb->count++;
+    return 0;
+}
+
+// cb:rectLines(x, y, width, height, color) — DrawRectangleLines
+static int command_buffer_rect_lines(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    DrawCommand *cmd = push_command(L, cb, CMD_RECT_LINES, 6);
+    cmd->as.rect = (Rectangle){ (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3),
+                                (float)luaL_checknumber(L, 4), (float)luaL_checknumber(L, 5) };
+    cb->count++;
+    return 0;
+}
+
+// cb:circle(centerX, centerY, radius, color) — DrawCircleV
+static int command_buffer_circle(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    DrawCommand *cmd = push_command(L, cb, CMD_CIRCLE, 5);
+    cmd->as.circle.center = (Vector2){ (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3) };
+    cmd->as.circle.radius = (float)luaL_checknumber(L, 4);
+    cb->count++;
+    return 0;
+}
+
+// cb:line(startX, startY, endX, endY, color) — DrawLineV
+static int command_buffer_line(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    DrawCommand *cmd = push_command(L, cb, CMD_LINE, 6);
+    cmd->as.line.start = (Vector2){ (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3) };
+    cmd->as.line.end = (Vector2){ (float)luaL_checknumber(L, 4), (float)luaL_checknumber(L, 5) };
+    cb->count++;
+    return 0;
+}
+
+// cb:texture(texture, x, y, tint) — DrawTextureV
+static int command_buffer_texture(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    Texture2D *texture = check_udata(L, 2, Texture2D);
+    DrawCommand *cmd = push_command(L, cb, CMD_TEXTURE, 5);
+    cmd->as.sprite.texture = texture;
+    cmd->as.sprite.handle = texture_handle(L, 2);
+    cmd->as.sprite.dest.x = (float)luaL_checknumber(L, 3);
+    cmd->as.sprite.dest.y = (float)luaL_checknumber(L, 4);
+    anchor_value(L, cb, 2);
+    cb->count++;
+    return 0;
+}
+
+// cb:sprite(texture, source, dest, origin, rotation, tint) — DrawTexturePro
+static int command_buffer_sprite(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    Texture2D *texture = check_udata(L, 2, Texture2D);
+    DrawCommand *cmd = push_command(L, cb, CMD_SPRITE, 7);
+    cmd->as.sprite.texture = texture;
+    cmd->as.sprite.handle = texture_handle(L, 2);
+    cmd->as.sprite.source = get_rectangle_from_table(L, 3);
+    cmd->as.sprite.dest = get_rectangle_from_table(L, 4);
+    cmd->as.sprite.origin = get_vector2_from_table(L, 5);
+    cmd->as.sprite.rotation = (float)luaL_checknumber(L, 6);
+    anchor_value(L, cb, 2);
+    cb->count++;
+    return 0;
+}
+
+// cb:text(text, x, y, fontSize, color) — DrawText
+static int command_buffer_text(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    DrawCommand *cmd = push_command(L, cb, CMD_TEXT, 6);
+    cmd->as.text.position = (Vector2){ (float)luaL_checkinteger(L, 3), (float)luaL_checkinteger(L, 4) };
+    cmd->as.text.fontSize = (float)luaL_checkinteger(L, 5);
+    cmd->as.text.font = NULL;
+    cmd->as.text.text = anchor_string(L, cb, 2);
+    cb->count++;
+    return 0;
+}
+
+// cb:textEx(font, text, position, fontSize, spacing, tint) — DrawTextEx
+static int command_buffer_text_ex(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    Font *font = check_udata(L, 2, Font);
+    DrawCommand *cmd = push_command(L, cb, CMD_TEXT_EX, 7);
+    cmd->as.text.position = get_vector2_from_table(L, 4);
+    cmd->as.text.fontSize = (float)luaL_checknumber(L, 5);
+    cmd->as.text.spacing = (float)luaL_checknumber(L, 6);
+    cmd->as.text.font = font;
+    anchor_value(L, cb, 2);
+    cmd->as.text.text = anchor_string(L, cb, 3);
+    cb->count++;
+    return 0;
+}
+
+// cb:clear() — drops every command and releases what they referenced; the
+// storage is kept for re-recording.
+static int command_buffer_clear(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    cb->count = 0;
+    cb->lastAnchor = NULL;
+    lua_newtable(L);
+    lua_setiuservalue(L, 1, 1);
+    return 0;
+}
+
+static int command_buffer_len(lua_State *L) {
+    lua_pushinteger(L, check_command_buffer(L, 1)->count);
+    return 1;
+}
+
+static int command_buffer_gc(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    free(cb->commands);
+    cb->commands = NULL;
+    cb->count = cb->capacity = 0;
+    return 0;
+}
+
+// ExecuteCommandBuffer(cb): draws every recorded command, in order. Call it
+// between BeginDrawing/EndDrawing (or inside any mode pair), like the draw
+// calls it replaces.
+static int lua_ExecuteCommandBuffer(lua_State *L) {
+    CommandBuffer *cb = check_command_buffer(L, 1);
+    const DrawCommand *cmd = cb->commands;
+    const DrawCommand *end = cmd + cb->count;
+    for (; cmd < end; cmd++) {
+        switch (cmd->type) {
+            case CMD_RECT:
+                DrawRectangleRec(cmd->as.rect, cmd->color);
+                break;
+            case CMD_RECT_LINES:
+                DrawRectangleLines((int)cmd->as.rect.x, (int)cmd->as.rect.y,
+                                   (int)cmd->as.rect.width, (int)cmd->as.rect.height, cmd->color);
+                break;
+            case CMD_CIRCLE:
+                DrawCircleV(cmd->as.circle.center, cmd->as.circle.radius, cmd->color);
+                break;
+            case CMD_LINE:
+                DrawLineV(cmd->as.line.start, cmd->as.line.end, cmd->color);
+                break;
+            case CMD_TEXTURE:
+                touch_texture(cmd->as.sprite.texture, cmd->as.sprite.handle);
+                DrawTextureV(*cmd->as.sprite.texture,
+                             (Vector2){ cmd->as.sprite.dest.x, cmd->as.sprite.dest.y }, cmd->color);
+                break;
+            case CMD_SPRITE:
+                touch_texture(cmd->as.sprite.texture, cmd->as.sprite.handle);
+                DrawTexturePro(*cmd->as.sprite.texture, cmd->as.sprite.source, cmd->as.sprite.dest,
+                               cmd->as.sprite.origin, cmd->as.sprite.rotation, cmd->color);
+                break;
+            case CMD_TEXT:
+                draw_text_default_cached(cmd->as.text.text, (int)cmd->as.text.position.x,
+                                         (int)cmd->as.text.position.y, (int)cmd->as.text.fontSize, cmd->color);
+                break;
+            case CMD_TEXT_EX:
+                draw_text_cached(*cmd->as.text.font, cmd->as.text.text, cmd->as.text.position,
+                                 cmd->as.text.fontSize, cmd->as.text.spacing, cmd->color);
+                break;
+        }
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Display lists ("DisplayList" userdata)
+// ---------------------------------------------------------------------------
+
+typedef struct DisplayVertex {
+    float position[3];
+    float texcoord[2];
+    float normal[3];
+    unsigned char color[4];
+} DisplayVertex;
+
+typedef struct DisplayDraw {
+    int mode;                   // RL_LINES, RL_TRIANGLES or RL_QUADS
+    int texture;                // index into DisplayList.textures, or -1 to use textureId
+    unsigned int textureId;
+    int first;
+    int count;
+} DisplayDraw;
+
+typedef struct DisplayTexture {
+    Texture2D *texture;         // anchored in user value 1
+    void *handle;               // texture_handle(), for the VRAM budget
+} DisplayTexture;
+
+typedef struct DisplayList {
+    int drawCount;
+    int vertexCount;
+    int textureCount;
+    DisplayDraw *draws;
+    DisplayVertex *vertices;
+    DisplayTexture *textures;
+} DisplayList;
+
+// Written into the last draw-call slot of the capture batch; rlDrawRenderBatch
+// resets every slot, so finding it overwritten means the batch was flushed.
+#define CAPTURE_SENTINEL_MODE (-1)
+
+// One recording at a time, like the single GL context it records from.
+static struct {
+    int active;
+    rlRenderBatch batch;
+    int anchors;                // registry ref of the {texture = true} table
+} capture;
+
+void display_list_capture_texture(lua_State *L, int index) {
+    if (!capture.active) return;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, capture.anchors);
+    lua_pushvalue(L, index);
+    lua_pushboolean(L, 1);
+    lua_rawset(L, -3);
+    lua_pop(L, 1);
+}
+
+// BeginDisplayList([maxVertices]): starts recording. The capture batch holds
+// maxVertices (rounded up to whole quads; default one default-sized batch).
+static int lua_BeginDisplayList(lua_State *L) {
+    lua_Integer maxVertices = luaL_optinteger(L, 1, 4 * (lua_Integer)RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+    luaL_argcheck(L, maxVertices > 0 && maxVertices <= 4 * (lua_Integer)0x3fffff, 1, "maxVertices out of range");
+    if (capture.active) return luaL_error(L, "BeginDisplayList: already recording a display list");
+    if (!IsWindowReady()) return luaL_error(L, "BeginDisplayList: no window");
+    if (rlGetVersion() <= RL_OPENGL_11)
+        return luaL_error(L, "BeginDisplayList: needs a batching renderer (OpenGL 3.3 or ES 2.0+), not immediate mode");
+    lua_newtable(L);
+    capture.anchors = luaL_ref(L, LUA_REGISTRYINDEX);
+    capture.batch = rlLoadRenderBatch(1, (int)((maxVertices + 3) / 4));
+    capture.batch.draws[RL_DEFAULT_BATCH_DRAWCALLS - 1].mode = CAPTURE_SENTINEL_MODE;
+    rlSetRenderBatchActive(&capture.batch);     // submits whatever was pending first
+    capture.active = 1;
+    return 0;
+}
+
+// Copies the recorded draw calls out of the capture batch, skipping the
+// padding rlgl inserts between draws of different primitive modes.
+static void copy_capture(DisplayList *list, const rlRenderBatch *b) {
+    const rlVertexBuffer *vb = &b->vertexBuffer[0];
+    int slot = 0;
+    for (int i = 0; i < b->drawCounter; i++) {
+        const rlDrawCall *dc = &b->draws[i];
+        if (dc->vertexCount > 0) {
+            DisplayDraw *d = &list->draws[list->drawCount++];
+            d->mode = dc->mode;
+            d->texture = -1;
+            d->textureId = dc->textureId;
+            d->first = list->vertexCount;
+            d->count = dc->vertexCount;
+            for (int v = slot; v < slot + dc->vertexCount; v++) {
+                DisplayVertex *out = &list->vertices[list->vertexCount++];
+                memcpy(out->position, vb->vertices + 3*v, sizeof(out->position));
+                memcpy(out->texcoord, vb->texcoords + 2*v, sizeof(out->texcoord));
+                memcpy(out->normal, vb->normals + 3*v, sizeof(out->normal));
+                memcpy(out->color, vb->colors + 4*v, sizeof(out->color));
+            }
+        }
+        slot += dc->vertexCount + dc->vertexAlignment;
+    }
+}
+
+// Drops the recording batch and makes rlgl's own batch current again.
+static void end_capture(lua_State *L) {
+    for (int i = 0; i < capture.batch.drawCounter; i++) capture.batch.draws[i].vertexCount = 0;
+    rlSetRenderBatchActive(NULL);               // submits the (now empty) recording batch
+    rlUnloadRenderBatch(capture.batch);
+    capture.active = 0;
+    luaL_unref(L, LUA_REGISTRYINDEX, capture.anchors);
+}
+
+void cancel_display_list(lua_State *L) {
+    if (capture.active) end_capture(L);
+}
+
+// EndDisplayList() -> DisplayList: stops recording and returns what was drawn.
+static int lua_EndDisplayList(lua_State *L) {
+    if (!capture.active) return luaL_error(L, "EndDisplayList: no display list is being recorded");
+    rlRenderBatch *b = &capture.batch;
+    int flushed = b->draws[RL_DEFAULT_BATCH_DRAWCALLS - 1].mode != CAPTURE_SENTINEL_MODE;
+
+    int drawCount = 0, vertexCount = 0;
+    for (int i = 0; !flushed && i < b->drawCounter; i++) {
+        if (b->draws[i].vertexCount > 0) drawCount++;
+        vertexCount += b->draws[i].vertexCount;
+    }
+    DisplayList *list = lua_newuserdatauv(L, sizeof(DisplayList), 1);
+    memset(list, 0, sizeof(DisplayList));
+    luaL_setmetatable(L, "DisplayList");
+    if (!flushed) {
+        list->draws = malloc(sizeof(DisplayDraw) * (size_t)(drawCount ? drawCount : 1));
+        list->vertices = malloc(sizeof(DisplayVertex) * (size_t)(vertexCount ? vertexCount : 1));
+        if (list->draws != NULL && list->vertices != NULL) copy_capture(list, b);
+    }
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, capture.anchors);
+    end_capture(L);
+
+    if (flushed)
+        return luaL_error(L, "EndDisplayList: the recording was flushed (more vertices than BeginDisplayList allowed, "
+                             "more than %d texture switches, or a mode change while recording)", RL_DEFAULT_BATCH_DRAWCALLS - 1);
+    if (list->draws == NULL || list->vertices == NULL)
+        return luaL_error(L, "EndDisplayList: out of memory copying %d vertices", vertexCount);
+
+    // Resolve draws against the textures handed to bindings while recording,
+    // so replays follow a managed texture to its reloaded id.
+    int anchors = lua_gettop(L);
+    int textureCount = 0;
+    lua_pushnil(L);
+    while (lua_next(L, anchors)) { textureCount++; lua_pop(L, 1); }
+    list->textures = malloc(sizeof(DisplayTexture) * (size_t)(textureCount ? textureCount : 1));
+    if (list->textures == NULL) return luaL_error(L, "EndDisplayList: out of memory");
+    lua_pushnil(L);
+    while (lua_next(L, anchors)) {
+        lua_pop(L, 1);
+        DisplayTexture *t = &list->textures[list->textureCount];
+        t->texture = lua_touserdata(L, -1);
+        t->handle = texture_handle(L, lua_gettop(L));
+        for (int i = 0; i < list->drawCount; i++)
+            if (list->draws[i].texture < 0 && list->draws[i].textureId == t->texture->id)
+                list->draws[i].texture = list->textureCount;
+        list->textureCount++;
+    }
+    lua_setiuservalue(L, -2, 1);
+    return 1;
+}
+
+static DisplayList *check_display_list(lua_State *L, int idx) {
+    return check_udata(L, idx, DisplayList);
+}
+
+// DrawDisplayList(list[, transform]): replays the recording into the current
+// batch; `transform` (a Matrix) is applied on top of the current modelview.
+static int lua_DrawDisplayList(lua_State *L) {
+    DisplayList *list = check_display_list(L, 1);
+    int transformed = !lua_isnoneornil(L, 2);
+    if (transformed) {
+        Matrix m = get_matrix_from_table(L, 2);
+        rlPushMatrix();
+        rlMultMatrixf(MatrixToFloat(m));
+    }
+    for (int i = 0; i < list->textureCount; i++)
+        touch_texture(list->textures[i].texture, list->textures[i].handle);
+    for (int i = 0; i < list->drawCount; i++) {
+        const DisplayDraw *d = &list->draws[i];
+        rlSetTexture(d->texture >= 0 ? list->textures[d->texture].texture->id : d->textureId);
+        rlBegin(d->mode);
+        const DisplayVertex *v = list->vertices + d->first;
+        for (int k = 0; k < d->count; k++, v++) {
+            rlColor4ub(v->color[0], v->color[1], v->color[2], v->color[3]);
+            rlTexCoord2f(v->texcoord[0], v->texcoord[1]);
+            rlNormal3f(v->normal[0], v->normal[1], v->normal[2]);
+            rlVertex3f(v->position[0], v->position[1], v->position[2]);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+    if (transformed) rlPopMatrix();
+    return 0;
+}
+
+static int display_list_len(lua_State *L) {
+    lua_pushinteger(L, check_display_list(L, 1)->vertexCount);
+    return 1;
+}
+
+static int display_list_gc(lua_State *L) {
+    DisplayList *list = check_display_list(L, 1);
+    free(list->draws);
+    free(list->vertices);
+    free(list->textures);
+    memset(list, 0, sizeof(DisplayList));
+    return 0;
+}
+
+static const luaL_Reg display_list_meta[] = {
+    {"__len", display_list_len}, {"__gc", display_list_gc},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// Instance buffers ("InstanceBuffer" userdata, see raylib_wrappers.h)
+// ---------------------------------------------------------------------------
+
+// Material maps raylib allocates per material (MAX_MATERIAL_MAPS in rmodels.c).
+#define MATERIAL_MAP_SLOTS 12
+
+#define INSTANCE_STRIDE (16 * sizeof(float))
+
+static InstanceBuffer *check_instance_buffer(lua_State *L, int idx) {
+    return check_udata(L, idx, InstanceBuffer);
+}
+
+static int instance_blocks(int count) {
+    return (count + INSTANCE_BUFFER_BLOCK - 1) / INSTANCE_BUFFER_BLOCK;
+}
+
+static void write_instance(InstanceBuffer *buf, int i, Matrix m) {
+    float16 v = MatrixToFloatV(m);
+    memcpy(buf->transforms + (size_t)i * 16, v.v, INSTANCE_STRIDE);
+    unsigned char *flag = &buf->dirty[i / INSTANCE_BUFFER_BLOCK];
+    if (!*flag) {
+        *flag = 1;
+        buf->dirtyBlocks++;
+    }
+}
+
+static int check_instance(lua_State *L, const InstanceBuffer *buf, int idx) {
+    lua_Integer i = luaL_checkinteger(L, idx);
+    luaL_argcheck(L, i >= 1 && i <= buf->count, idx, "instance index out of range");
+    return (int)i - 1;
+}
+
+void unload_instance_buffer(InstanceBuffer *buf, int gpu) {
+    if (gpu && buf->vboId != 0) rlUnloadVertexBuffer(buf->vboId);
+    free(buf->transforms);
+    memset(buf, 0, sizeof(InstanceBuffer));
+}
+
+// InstanceBuffer(n | transforms): n identity transforms, or a copy of a Lua
+// array of Matrix values / {m0..m15} tables.
+static int lua_InstanceBuffer(lua_State *L) {
+    int fromList = lua_istable(L, 1);
+    lua_Integer n = fromList ? luaL_len(L, 1) : luaL_checkinteger(L, 1);
+    luaL_argcheck(L, n > 0 && n <= 0x7fffffff / (lua_Integer)INSTANCE_STRIDE, 1, "instance count out of range");
+    int blocks = instance_blocks((int)n);
+    float *storage = malloc(INSTANCE_STRIDE * (size_t)n + (size_t)blocks);
+    if (storage == NULL) return luaL_error(L, "out of memory allocating %d instances", (int)n);
+    InstanceBuffer value = { (int)n, 0, storage, (unsigned char *)(storage + 16 * (size_t)n), 0 };
+    memset(value.dirty, 0, (size_t)blocks);
+    // Owned by the userdata from here on, so a bad list entry below cannot leak it.
+    InstanceBuffer *buf = push_resource(L, RESOURCE_INSTANCE_BUFFER, "InstanceBuffer", &value);
+    for (int i = 0; i < buf->count; i++) {
+        Matrix m = MatrixIdentity();
+        if (fromList) {
+            lua_rawgeti(L, 1, i + 1);
+            m = get_matrix_from_table(L, -1);
+            lua_pop(L, 1);
+        }
+        write_instance(buf, i, m);
+    }
+    return 1;
+}
+
+// buf:set(i, transform)
+static int instance_buffer_set(lua_State *L) {
+    InstanceBuffer *buf = check_instance_buffer(L, 1);
+    int i = check_instance(L, buf, 2);
+    write_instance(buf, i, get_matrix_from_table(L, 3));
+    return 0;
+}
+
+// buf:setRange(first, transforms): writes #transforms consecutive instances from `first` on.
+static int instance_buffer_set_range(lua_State *L) {
+    InstanceBuffer *buf = check_instance_buffer(L, 1);
+    int first = check_instance(L, buf, 2);
+    luaL_checktype(L, 3, LUA_TTABLE);
+    lua_Integer n = luaL_len(L, 3);
+    luaL_argcheck(L, n <= buf->count - first, 3, "range runs past the end of the buffer");
+    for (int i = 0; i < n; i++) {
+        lua_rawgeti(L, 3, i + 1);
+        write_instance(buf, first + i, get_matrix_from_table(L, -1));
+        lua_pop(L, 1);
+    }
+    return 0;
+}
+
+// buf:get(i) -> Matrix
+static int instance_buffer_get(lua_State *L) {
+    InstanceBuffer *buf = check_instance_buffer(L, 1);
+    const float *v = buf->transforms + (size_t)check_instance(L, buf, 2) * 16;
+    push_matrix_to_userdata(L, (Matrix){ v[0], v[4], v[8], v[12], v[1], v[5], v[9], v[13],
+                                         v[2], v[6], v[10], v[14], v[3], v[7], v[11], v[15] });
+    return 1;
+}
+
+static int instance_buffer_len(lua_State *L) {
+    lua_pushinteger(L, check_instance_buffer(L, 1)->count);
+    return 1;
+}
+
+// UnloadInstanceBuffer(buf)
+static int lua_UnloadInstanceBuffer(lua_State *L) {
+    InstanceBuffer *buf = check_instance_buffer(L, 1);
+    if (release_resource(L, 1, sizeof(InstanceBuffer))) unload_instance_buffer(buf, IsWindowReady());
+    return 0;
+}
+
+// Creates the vertex buffer on first use, otherwise uploads each run of dirty
+// blocks with one rlUpdateVertexBuffer. Returns 0 when the renderer has no
+// vertex buffers (OpenGL 1.1, software).
+static int sync_instance_buffer(lua_State *L, InstanceBuffer *buf, int idx) {
+    int blocks = instance_blocks(buf->count);
+    if (buf->vboId == 0) {
+        if (rlGetVersion() <= RL_OPENGL_11) return 0;
+        buf->vboId = rlLoadVertexBuffer(buf->transforms, (int)(INSTANCE_STRIDE * (size_t)buf->count), true);
+        if (buf->vboId == 0) return 0;
+        memset(buf->dirty, 0, (size_t)blocks);
+        buf->dirtyBlocks = 0;
+        retrack_resource(L, idx, RESOURCE_INSTANCE_BUFFER);   // now also counts VRAM
+        return 1;
+    }
+    for (int b = 0; buf->dirtyBlocks > 0 && b < blocks; b++) {
+        if (!buf->dirty[b]) continue;
+        int first = b * INSTANCE_BUFFER_BLOCK;
+        for (; b < blocks && buf->dirty[b]; b++) {
+            buf->dirty[b] = 0;
+            buf->dirtyBlocks--;
+        }
+        int end = b * INSTANCE_BUFFER_BLOCK < buf->count ? b * INSTANCE_BUFFER_BLOCK : buf->count;
+        rlUpdateVertexBuffer(buf->vboId, buf->transforms + (size_t)first * 16,
+                             (int)(INSTANCE_STRIDE * (size_t)(end - first)), (int)(INSTANCE_STRIDE * (size_t)first));
+    }
+    return 1;
+}
+
+static void set_color_uniform(int loc, Color color) {
+    if (loc == -1) return;
+    float values[4] = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+    rlSetUniform(loc, values, SHADER_UNIFORM_VEC4, 1);
+}
+
+// DrawMeshInstanced's VAO path (rmodels.c), with the instance-transform
+// attribute pointed at a persistent buffer instead of one uploaded per call.
+// The model matrix is the identity; each instance's transform is applied by
+// the shader.
+static void draw_mesh_instanced_vbo(Mesh mesh, Material material, unsigned int vboId, int instances) {
+    const int *locs = material.shader.locs;
+    rlEnableShader(material.shader.id);
+    set_color_uniform(locs[SHADER_LOC_COLOR_DIFFUSE], material.maps[MATERIAL_MAP_DIFFUSE].color);
+    set_color_uniform(locs[SHADER_LOC_COLOR_SPECULAR], material.maps[MATERIAL_MAP_SPECULAR].color);
+
+    Matrix matView = rlGetMatrixModelview();
+    Matrix matProjection = rlGetMatrixProjection();
+    if (locs[SHADER_LOC_MATRIX_VIEW] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_VIEW], matView);
+    if (locs[SHADER_LOC_MATRIX_PROJECTION] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_PROJECTION], matProjection);
+    if (locs[SHADER_LOC_MATRIX_NORMAL] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_NORMAL], MatrixIdentity());
+
+    rlEnableVertexArray(mesh.vaoId);
+    int transformLoc = locs[SHADER_LOC_VERTEX_INSTANCETRANSFORM];
+    if (transformLoc != -1) {
+        rlEnableVertexBuffer(vboId);
+        for (int i = 0; i < 4; i++) {
+            rlEnableVertexAttribute((unsigned int)(transformLoc + i));
+            rlSetVertexAttribute((unsigned int)(transformLoc + i), 4, RL_FLOAT, 0, (int)INSTANCE_STRIDE, i * (int)sizeof(Vector4));
+            rlSetVertexAttributeDivisor((unsigned int)(transformLoc + i), 1);
+        }
+        rlDisableVertexBuffer();
+    }
+
+    for (int i = 0; i < MATERIAL_MAP_SLOTS; i++) {
+        if (material.maps[i].texture.id == 0) continue;
+        rlActiveTextureSlot(i);
+        if (i == MATERIAL_MAP_IRRADIANCE || i == MATERIAL_MAP_PREFILTER || i == MATERIAL_MAP_CUBEMAP)
+            rlEnableTextureCubemap(material.maps[i].texture.id);
+        else rlEnableTexture(material.maps[i].texture.id);
+        rlSetUniform(locs[SHADER_LOC_MAP_DIFFUSE + i], &i, SHADER_UNIFORM_INT, 1);
+    }
+
+    Matrix matModelView = MatrixMultiply(rlGetMatrixTransform(), matView);
+    int eyeCount = rlIsStereoRenderEnabled() ? 2 : 1;
+    for (int eye = 0; eye < eyeCount; eye++) {
+        Matrix mvp;
+        if (eyeCount == 1) mvp = MatrixMultiply(matModelView, matProjection);
+        else {
+            rlViewport(eye * rlGetFramebufferWidth() / 2, 0, rlGetFramebufferWidth() / 2, rlGetFramebufferHeight());
+            mvp = MatrixMultiply(MatrixMultiply(matModelView, rlGetMatrixViewOffsetStereo(eye)), rlGetMatrixProjectionStereo(eye));
+        }
+        rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], mvp);
+        if (mesh.indices != NULL) rlDrawVertexArrayElementsInstanced(0, mesh.triangleCount * 3, 0, instances);
+        else rlDrawVertexArrayInstanced(0, mesh.vertexCount, instances);
+    }
+
+    for (int i = 0; i < MATERIAL_MAP_SLOTS; i++) {
+        if (material.maps[i].texture.id == 0) continue;
+        rlActiveTextureSlot(i);
+        if (i == MATERIAL_MAP_IRRADIANCE || i == MATERIAL_MAP_PREFILTER || i == MATERIAL_MAP_CUBEMAP) rlDisableTextureCubemap();
+        else rlDisableTexture();
+    }
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+    rlDisableShader();
+}
+
+// DrawMeshInstancedBuffer(mesh, material, buf[, count]): DrawMeshInstanced
+// with the first `count` (default all) transforms of `buf`.
+static int lua_DrawMeshInstancedBuffer(lua_State *L) {
+    Mesh *mesh = check_udata(L, 1, Mesh);
+    Material *material = check_udata(L, 2, Material);
+    InstanceBuffer *buf = check_instance_buffer(L, 3);
+    lua_Integer count = luaL_optinteger(L, 4, buf->count);
+    luaL_argcheck(L, count >= 0 && count <= buf->count, 4, "instance count out of range");
+    if (count == 0) return 0;
+    if (mesh->vaoId > 0 && sync_instance_buffer(L, buf, 3)) {
+        draw_mesh_instanced_vbo(*mesh, *material, buf->vboId, (int)count);
+        return 0;
+    }
+    Matrix *transforms = scratch_alloc(L, sizeof(Matrix) * (size_t)count);
+    for (int i = 0; i < count; i++) {
+        const float *v = buf->transforms + (size_t)i * 16;
+        transforms[i] = (Matrix){ v[0], v[4], v[8], v[12], v[1], v[5], v[9], v[13],
+                                  v[2], v[6], v[10], v[14], v[3], v[7], v[11], v[15] };
+    }
+    DrawMeshInstanced(*mesh, *material, transforms, (int)count);
+    scratch_pop(L, transforms);
+    return 0;
+}
+
+static const luaL_Reg instance_buffer_methods[] = {
+    {"set", instance_buffer_set}, {"setRange", instance_buffer_set_range}, {"get", instance_buffer_get},
+    {NULL, NULL}
+};
+
+static const luaL_Reg instance_buffer_meta[] = {
+    {"__len", instance_buffer_len},
+    {NULL, NULL}
+};
+
+static const luaL_Reg command_buffer_methods[] = {
+    {"rect", command_buffer_rect}, {"rectLines", command_buffer_rect_lines},
+    {"circle", command_buffer_circle}, {"line", command_buffer_line},
+    {"texture", command_buffer_texture}, {"sprite", command_buffer_sprite},
+    {"text", command_buffer_text}, {"textEx", command_buffer_text_ex},
+    {"clear", command_buffer_clear},
+    {NULL, NULL}
+};
+
+static const luaL_Reg command_buffer_meta[] = {
+    {"__len", command_buffer_len}, {"__gc", command_buffer_gc},
+    {NULL, NULL}
+};
+
+static const luaL_Reg commands_functions[] = {
+    {"CommandBuffer", lua_CommandBuffer},
+    {"ExecuteCommandBuffer", lua_ExecuteCommandBuffer},
+    {"BeginDisplayList", lua_BeginDisplayList},
+    {"EndDisplayList", lua_EndDisplayList},
+    {"DrawDisplayList", lua_DrawDisplayList},
+    {"InstanceBuffer", lua_InstanceBuffer},
+    {"UnloadInstanceBuffer", lua_UnloadInstanceBuffer},
+    {"DrawMeshInstancedBuffer", lua_DrawMeshInstancedBuffer},
+    {NULL, NULL}
+};
+
+// Creates the CommandBuffer, DisplayList and InstanceBuffer metatables (the
+// latter gets its __gc / __close from register_resources) and adds their
+// functions onto the module table currently on top of the stack.
+void register_commands(lua_State *L) {
+    luaL_newmetatable(L, "CommandBuffer");
+    luaL_setfuncs(L, command_buffer_meta, 0);
+    luaL_newlib(L, command_buffer_methods);
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+    luaL_newmetatable(L, "DisplayList");
+    luaL_setfuncs(L, display_list_meta, 0);
+    lua_pop(L, 1);
+    luaL_newmetatable(L, "InstanceBuffer");
+    luaL_setfuncs(L, instance_buffer_meta, 0);
+    luaL_newlib(L, instance_buffer_methods);
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+    luaL_setfuncs(L, commands_functions, 0);
+}
@@ -10,6 +10,9 @@ int lua_InitWindow(lua_State *L) {
 }
 
 int lua_CloseWindow(lua_State *L) {
+    cancel_display_list(L);
+    flush_unload_queue();   // while the GL context still exists
+    forget_text_layouts(NULL);
     CloseWindow();
     return 0;
 }
@@ -21,15 +24,13 @@ int lua_WindowShouldClose(lua_State *L) {
 
 int lua_GetClipboardImage(lua_State *L) {
     Image image = GetClipboardImage();
-    Image *userdata = (Image *)lua_newuserdata(L, sizeof(Image));
-    *userdata = image;
-    luaL_setmetatable(L, "Image");
+    push_resource(L, RESOURCE_IMAGE, "Image", &image);
     return 1;
 }
 
 
 int lua_SetWindowIcon(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     SetWindowIcon(*image);
     return 0;
 }
@@ -88,8 +89,7 @@ int lua_GetMouseY(lua_State *L) {
 }
 
 int lua_GetMousePosition(lua_State *L) {
-    push_vector2_to_table(L, GetMousePosition());
-    return 1;
+    return return_vector2(L, 1, GetMousePosition());
 }
 
 int lua_GetMouseWheelMove(lua_State *L) {
@@ -204,8 +204,7 @@ int lua_GetMonitorRefreshRate(lua_State *L) {
 
 int lua_GetMonitorPosition(lua_State *L) {
     int monitor = luaL_checkinteger(L, 1);
-    push_vector2_to_table(L, GetMonitorPosition(monitor));
-    return 1;
+    return return_vector2(L, 2, GetMonitorPosition(monitor));
 }
 
 int lua_GetTime(lua_State *L) {
@@ -278,8 +277,7 @@ int lua_SetMouseScale(lua_State *L) {
 
 int lua_GetTouchPosition(lua_State *L) {
     int index = luaL_checkinteger(L, 1);
-    push_vector2_to_table(L, GetTouchPosition(index));
-    return 1;
+    return return_vector2(L, 2, GetTouchPosition(index));
 }
 
 int lua_ShowCursor(lua_State *L) {
@@ -402,13 +400,7 @@ int lua_GetCurrentMonitor(lua_State *L) {
 }
 
 int lua_GetWindowScaleDPI(lua_State *L) {
-    Vector2 scale = GetWindowScaleDPI();
-    lua_newtable(L);
-    lua_pushnumber(L, scale.x);
-    lua_setfield(L, -2, "x");
-    lua_pushnumber(L, scale.y);
-    lua_setfield(L, -2, "y");
-    return 1;
+    return return_vector2(L, 1, GetWindowScaleDPI());
 }
 
 int lua_EnableEventWaiting(lua_State *L) {
@@ -1,11 +1,6 @@
 #include "lua_raylib_draw.h"
 #include "raylib_wrappers.h"
-
-static Color check_color(lua_State *L, int index) {
-    if (lua_isinteger(L, index))
-        return convert_color((int)lua_tointeger(L, index));
-    return get_color_from_table(L, index);
-}
+#include "lua_raylib_alloc.h"
 
 int lua_BeginDrawing(lua_State *L) {
     BeginDrawing();
@@ -14,11 +9,15 @@ int lua_BeginDrawing(lua_State *L) {
 
 int lua_EndDrawing(lua_State *L) {
     EndDrawing();
+    scratch_reset(L);   // frame boundary: reclaim this frame's marshalling buffers
+    flush_unload_queue();   // the frame is submitted: collected GPU handles can go
+    texture_budget_end_frame();
+    pool_end_frame();
     return 0;
 }
 
 int lua_ClearBackground(lua_State *L) {
-    ClearBackground(check_color(L, 1));
+    ClearBackground(get_color_from_table(L, 1));
     return 0;
 }
 
@@ -27,7 +26,7 @@ int lua_DrawRectangle(lua_State *L) {
     int y      = luaL_checkinteger(L, 2);
     int width  = luaL_checkinteger(L, 3);
     int height = luaL_checkinteger(L, 4);
-    DrawRectangle(x, y, width, height, check_color(L, 5));
+    DrawRectangle(x, y, width, height, get_color_from_table(L, 5));
     return 0;
 }
 
@@ -96,22 +95,11 @@ int lua_DrawRectangleRounded(lua_State *L) {
 }
 
 int lua_DrawLineStrip(lua_State *L) {
-    luaL_checktype(L, 1, LUA_TTABLE);
-    int pointsCount = lua_rawlen(L, 1);
-    Vector2 *points = malloc(pointsCount * sizeof(Vector2));
-    if (!points) {
-        return luaL_error(L, "Memory allocation failed for points array");
-    }
-
-    for (int i = 0; i < pointsCount; i++) {
-        lua_rawgeti(L, 1, i + 1);
-        points[i] = get_vector2_from_table(L, -1);
-        lua_pop(L, 1);
-    }
-
     Color color = get_color_from_table(L, 2);
+    int pointsCount;
+    Vector2 *points = get_vector2_list(L, 1, &pointsCount);
     DrawLineStrip(points, pointsCount, color);
-    free(points);
+    release_vector2_list(L, 1, points);
     return 0;
 }
 
@@ -249,22 +237,11 @@ int lua_DrawTriangleLines(lua_State *L) {
 }
 
 int lua_DrawTriangleStrip(lua_State *L) {
-    luaL_checktype(L, 1, LUA_TTABLE);
-    int pointsCount = lua_rawlen(L, 1);
-    Vector2 *points = malloc(pointsCount * sizeof(Vector2));
-    if (!points) {
-        return luaL_error(L, "Memory allocation failed for points array");
-    }
-
-    for (int i = 0; i < pointsCount; i++) {
-        lua_rawgeti(L, 1, i + 1);
-        points[i] = get_vector2_from_table(L, -1);
-        lua_pop(L, 1);
-    }
-
     Color color = get_color_from_table(L, 2);
+    int pointsCount;
+    Vector2 *points = get_vector2_list(L, 1, &pointsCount);
     DrawTriangleStrip(points, pointsCount, color);
-    free(points);
+    release_vector2_list(L, 1, points);
     return 0;
 }
 
@@ -63,21 +63,21 @@ static int lua_BeginMode2D(lua_State *L) { BeginMode2D(get_camera2d(L, 1)); retu
 static int lua_EndMode2D(lua_State *L)   { (void)L; EndMode2D(); return 0; }
 
 static int lua_BeginMode3D(lua_State *L) {
-    Camera *camera = luaL_checkudata(L, 1, "Camera");
+    Camera *camera = check_udata(L, 1, Camera);
     BeginMode3D(*camera);
     return 0;
 }
 static int lua_EndMode3D(lua_State *L) { (void)L; EndMode3D(); return 0; }
 
 static int lua_BeginTextureMode(lua_State *L) {
-    RenderTexture2D *target = luaL_checkudata(L, 1, "RenderTexture2D");
+    RenderTexture2D *target = check_udata(L, 1, RenderTexture2D);
     BeginTextureMode(*target);
     return 0;
 }
 static int lua_EndTextureMode(lua_State *L) { (void)L; EndTextureMode(); return 0; }
 
 static int lua_BeginShaderMode(lua_State *L) {
-    Shader *shader = luaL_checkudata(L, 1, "Shader");
+    Shader *shader = check_udata(L, 1, Shader);
     BeginShaderMode(*shader);
     return 0;
 }
@@ -119,14 +119,14 @@ static int lua_CreateCamera3D(lua_State *L) {
 }
 
 static int lua_UpdateCamera(lua_State *L) {
-    Camera *camera = luaL_checkudata(L, 1, "Camera");
+    Camera *camera = check_udata(L, 1, Camera);
     int mode = (int)luaL_checkinteger(L, 2);
     UpdateCamera(camera, mode);
     return 0;
 }
 
 static int lua_UpdateCameraPro(lua_State *L) {
-    Camera *camera = luaL_checkudata(L, 1, "Camera");
+    Camera *camera = check_udata(L, 1, Camera);
     Vector3 movement = get_vector3_from_table(L, 2);
     Vector3 rotation = get_vector3_from_table(L, 3);
     float zoom = (float)luaL_checknumber(L, 4);
@@ -135,7 +135,7 @@ static int lua_UpdateCameraPro(lua_State *L) {
 }
 
 static int lua_GetCameraMatrix(lua_State *L) {
-    Camera *camera = luaL_checkudata(L, 1, "Camera");
+    Camera *camera = check_udata(L, 1, Camera);
     push_matrix_to_table(L, GetCameraMatrix(*camera));
     return 1;
 }
@@ -147,44 +147,40 @@ static int lua_GetCameraMatrix2D(lua_State *L) {
 
 static int lua_GetWorldToScreen(lua_State *L) {
     Vector3 position = get_vector3_from_table(L, 1);
-    Camera *camera = luaL_checkudata(L, 2, "Camera");
-    push_vector2_to_table(L, GetWorldToScreen(position, *camera));
-    return 1;
+    Camera *camera = check_udata(L, 2, Camera);
+    return return_vector2(L, 3, GetWorldToScreen(position, *camera));
 }
 
 static int lua_GetWorldToScreenEx(lua_State *L) {
     Vector3 position = get_vector3_from_table(L, 1);
-    Camera *camera = luaL_checkudata(L, 2, "Camera");
+    Camera *camera = check_udata(L, 2, Camera);
     int width  = (int)luaL_checkinteger(L, 3);
     int height = (int)luaL_checkinteger(L, 4);
-    push_vector2_to_table(L, GetWorldToScreenEx(position, *camera, width, height));
-    return 1;
+    return return_vector2(L, 5, GetWorldToScreenEx(position, *camera, width, height));
 }
 
 static int lua_GetWorldToScreen2D(lua_State *L) {
     Vector2 position = get_vector2_from_table(L, 1);
     Camera2D camera = get_camera2d(L, 2);
-    push_vector2_to_table(L, GetWorldToScreen2D(position, camera));
-    return 1;
+    return return_vector2(L, 3, GetWorldToScreen2D(position, camera));
 }
 
 static int lua_GetScreenToWorld2D(lua_State *L) {
     Vector2 position = get_vector2_from_table(L, 1);
     Camera2D camera = get_camera2d(L, 2);
-    push_vector2_to_table(L, GetScreenToWorld2D(position, camera));
-    return 1;
+    return return_vector2(L, 3, GetScreenToWorld2D(position, camera));
 }
 
 static int lua_GetScreenToWorldRay(lua_State *L) {
     Vector2 position = get_vector2_from_table(L, 1);
-    Camera *camera = luaL_checkudata(L, 2, "Camera");
+    Camera *camera = check_udata(L, 2, Camera);
     push_ray_to_table(L, GetScreenToWorldRay(position, *camera));
     return 1;
 }
 
 static int lua_GetScreenToWorldRayEx(lua_State *L) {
     Vector2 position = get_vector2_from_table(L, 1);
-    Camera *camera = luaL_checkudata(L, 2, "Camera");
+    Camera *camera = check_udata(L, 2, Camera);
     int width  = (int)luaL_checkinteger(L, 3);
     int height = (int)luaL_checkinteger(L, 4);
     push_ray_to_table(L, GetScreenToWorldRayEx(position, *camera, width, height));
@@ -199,9 +195,7 @@ static int lua_LoadShader(lua_State *L) {
     const char *vs = luaL_optstring(L, 1, NULL);
     const char *fs = luaL_optstring(L, 2, NULL);
     Shader shader = LoadShader(vs, fs);
-    Shader *p = (Shader *)lua_newuserdata(L, sizeof(Shader));
-    *p = shader;
-    luaL_setmetatable(L, "Shader");
+    push_resource(L, RESOURCE_SHADER, "Shader", &shader);
     return 1;
 }
 
@@ -209,34 +203,32 @@ static int lua_LoadShaderFromMemory(lua_State *L) {
     const char *vs = luaL_optstring(L, 1, NULL);
     const char *fs = luaL_optstring(L, 2, NULL);
     Shader shader = LoadShaderFromMemory(vs, fs);
-    Shader *p = (Shader *)lua_newuserdata(L, sizeof(Shader));
-    *p = shader;
-    luaL_setmetatable(L, "Shader");
+    push_resource(L, RESOURCE_SHADER, "Shader", &shader);
     return 1;
 }
 
 static int lua_IsShaderValid(lua_State *L) {
-    Shader *shader = luaL_checkudata(L, 1, "Shader");
+    Shader *shader = check_udata(L, 1, Shader);
     lua_pushboolean(L, IsShaderValid(*shader));
     return 1;
 }
 
 static int lua_GetShaderLocation(lua_State *L) {
-    Shader *shader = luaL_checkudata(L, 1, "Shader");
+    Shader *shader = check_udata(L, 1, Shader);
     const char *name = luaL_checkstring(L, 2);
     lua_pushinteger(L, GetShaderLocation(*shader, name));
     return 1;
 }
 
 static int lua_GetShaderLocationAttrib(lua_State *L) {
-    Shader *shader = luaL_checkudata(L, 1, "Shader");
+    Shader *shader = check_udata(L, 1, Shader);
     const char *name = luaL_checkstring(L, 2);
     lua_pushinteger(L, GetShaderLocationAttrib(*shader, name));
     return 1;
 }
 
 static int lua_SetShaderValue(lua_State *L) {
-    Shader *shader = luaL_checkudata(L, 1, "Shader");
+    Shader *shader = check_udata(L, 1, Shader);
     int loc  = (int)luaL_checkinteger(L, 2);
     int type = (int)luaL_checkinteger(L, 4);
     int n = shader_elem_count(type);
@@ -258,7 +250,7 @@ static int lua_SetShaderValue(lua_State *L) {
 }
 
 static int lua_SetShaderValueV(lua_State *L) {
-    Shader *shader = luaL_checkudata(L, 1, "Shader");
+    Shader *shader = check_udata(L, 1, Shader);
     int loc   = (int)luaL_checkinteger(L, 2);
     luaL_checktype(L, 3, LUA_TTABLE);
     int type  = (int)luaL_checkinteger(L, 4);
@@ -266,21 +258,21 @@ static int lua_SetShaderValueV(lua_State *L) {
     int total = shader_elem_count(type) * count;
     if (total <= 0) return 0;
     if (shader_is_int(type)) {
-        int *buf = (int *)malloc(sizeof(int) * total);
+        int *buf = (int *)scratch_alloc(L, sizeof(int) * total);
         for (int i = 0; i < total; i++) { lua_rawgeti(L, 3, i + 1); buf[i] = (int)luaL_checkinteger(L, -1); lua_pop(L, 1); }
         SetShaderValueV(*shader, loc, buf, type, count);
-        free(buf);
+        scratch_pop(L, buf);
     } else {
-        float *buf = (float *)malloc(sizeof(float) * total);
+        float *buf = (float *)scratch_alloc(L, sizeof(float) * total);
         for (int i = 0; i < total; i++) { lua_rawgeti(L, 3, i + 1); buf[i] = (float)luaL_checknumber(L, -1); lua_pop(L, 1); }
         SetShaderValueV(*shader, loc, buf, type, count);
-        free(buf);
+        scratch_pop(L, buf);
     }
     return 0;
 }
 
 static int lua_SetShaderValueMatrix(lua_State *L) {
-    Shader *shader = luaL_checkudata(L, 1, "Shader");
+    Shader *shader = check_udata(L, 1, Shader);
     int loc = (int)luaL_checkinteger(L, 2);
     Matrix mat = get_matrix_from_table(L, 3);
     SetShaderValueMatrix(*shader, loc, mat);
@@ -288,16 +280,17 @@ static int lua_SetShaderValueMatrix(lua_State *L) {
 }
 
 static int lua_SetShaderValueTexture(lua_State *L) {
-    Shader *shader = luaL_checkudata(L, 1, "Shader");
+    Shader *shader = check_udata(L, 1, Shader);
     int loc = (int)luaL_checkinteger(L, 2);
-    Texture2D *texture = luaL_checkudata(L, 3, "Texture2D");
+    Texture2D *texture = check_texture(L, 3);
     SetShaderValueTexture(*shader, loc, *texture);
+    pin_texture(L, 3);
     return 0;
 }
 
 static int lua_UnloadShader(lua_State *L) {
-    Shader *shader = luaL_checkudata(L, 1, "Shader");
-    UnloadShader(*shader);
+    Shader *shader = check_udata(L, 1, Shader);
+    if (release_resource(L, 1, sizeof(Shader))) UnloadShader(*shader);
     return 0;
 }
 
@@ -305,21 +298,21 @@ static int lua_UnloadShader(lua_State *L) {
 // Audio playback control ("Sound" userdata)
 // ---------------------------------------------------------------------------
 
-static int lua_PauseSound(lua_State *L)  { Sound *s = luaL_checkudata(L, 1, "Sound"); PauseSound(*s);  return 0; }
-static int lua_ResumeSound(lua_State *L) { Sound *s = luaL_checkudata(L, 1, "Sound"); ResumeSound(*s); return 0; }
+static int lua_PauseSound(lua_State *L)  { Sound *s = check_udata(L, 1, Sound); PauseSound(*s);  return 0; }
+static int lua_ResumeSound(lua_State *L) { Sound *s = check_udata(L, 1, Sound); ResumeSound(*s); return 0; }
 
 static int lua_SetSoundVolume(lua_State *L) {
-    Sound *s = luaL_checkudata(L, 1, "Sound");
+    Sound *s = check_udata(L, 1, Sound);
     SetSoundVolume(*s, (float)luaL_checknumber(L, 2));
     return 0;
 }
 static int lua_SetSoundPitch(lua_State *L) {
-    Sound *s = luaL_checkudata(L, 1, "Sound");
+    Sound *s = check_udata(L, 1, Sound);
     SetSoundPitch(*s, (float)luaL_checknumber(L, 2));
     return 0;
 }
 static int lua_SetSoundPan(lua_State *L) {
-    Sound *s = luaL_checkudata(L, 1, "Sound");
+    Sound *s = check_udata(L, 1, Sound);
     SetSoundPan(*s, (float)luaL_checknumber(L, 2));
     return 0;
 }
@@ -347,7 +340,7 @@ static int lua_DrawSphereEx(lua_State *L) {
 }
 
 static int lua_DrawModelWires(lua_State *L) {
-    Model *model = luaL_checkudata(L, 1, "Model");
+    Model *model = check_udata(L, 1, Model);
     Vector3 position = get_vector3_from_table(L, 2);
     float scale = (float)luaL_checknumber(L, 3);
     Color tint = get_color_from_table(L, 4);
@@ -356,7 +349,7 @@ static int lua_DrawModelWires(lua_State *L) {
 }
 
 static int lua_DrawModelWiresEx(lua_State *L) {
-    Model *model = luaL_checkudata(L, 1, "Model");
+    Model *model = check_udata(L, 1, Model);
     Vector3 position = get_vector3_from_table(L, 2);
     Vector3 rotationAxis = get_vector3_from_table(L, 3);
     float rotationAngle = (float)luaL_checknumber(L, 4);
@@ -367,19 +360,19 @@ static int lua_DrawModelWiresEx(lua_State *L) {
 }
 
 static int lua_DrawMeshInstanced(lua_State *L) {
-    Mesh *mesh = luaL_checkudata(L, 1, "Mesh");
-    Material *material = luaL_checkudata(L, 2, "Material");
+    Mesh *mesh = check_udata(L, 1, Mesh);
+    Material *material = check_udata(L, 2, Material);
     luaL_checktype(L, 3, LUA_TTABLE);
     int instances = (int)luaL_len(L, 3);
     if (instances <= 0) return 0;
-    Matrix *transforms = (Matrix *)malloc(sizeof(Matrix) * instances);
+    Matrix *transforms = (Matrix *)scratch_alloc(L, sizeof(Matrix) * instances);
     for (int i = 0; i < instances; i++) {
         lua_rawgeti(L, 3, i + 1);
         transforms[i] = get_matrix_from_table(L, -1);
         lua_pop(L, 1);
     }
     DrawMeshInstanced(*mesh, *material, transforms, instances);
-    free(transforms);
+    scratch_pop(L, transforms);
     return 0;
 }
 
@@ -388,12 +381,11 @@ static int lua_DrawMeshInstanced(lua_State *L) {
 // ---------------------------------------------------------------------------
 
 static int lua_DrawTriangleFan(lua_State *L) {
-    luaL_checktype(L, 1, LUA_TTABLE);
-    int pointCount = (int)luaL_len(L, 1);
-    Vector2 *points = get_vector2_array_from_table(L, 1);
     Color color = get_color_from_table(L, 2);
+    int pointCount;
+    Vector2 *points = get_vector2_list(L, 1, &pointCount);
     DrawTriangleFan(points, pointCount, color);
-    free(points);
+    release_vector2_list(L, 1, points);
     return 0;
 }
 
@@ -422,7 +414,7 @@ static int lua_DrawRectangleRoundedLinesEx(lua_State *L) {
 
 static int lua_GetRenderWidth(lua_State *L)  { lua_pushinteger(L, GetRenderWidth());  return 1; }
 static int lua_GetRenderHeight(lua_State *L) { lua_pushinteger(L, GetRenderHeight()); return 1; }
-static int lua_GetWindowPosition(lua_State *L) { push_vector2_to_table(L, GetWindowPosition()); return 1; }
+static int lua_GetWindowPosition(lua_State *L) { return return_vector2(L, 1, GetWindowPosition()); }
 static int lua_WaitTime(lua_State *L)  { WaitTime((double)luaL_checknumber(L, 1)); return 0; }
 static int lua_OpenURL(lua_State *L)   { OpenURL(luaL_checkstring(L, 1)); return 0; }
 static int lua_SetExitKey(lua_State *L){ SetExitKey((int)luaL_checkinteger(L, 1)); return 0; }
@@ -433,8 +425,8 @@ static int lua_PollInputEvents(lua_State *L)  { (void)L; PollInputEvents(); retu
 // Input: mouse extras, gamepad, gestures, touch
 // ---------------------------------------------------------------------------
 
-static int lua_GetMouseDelta(lua_State *L)      { push_vector2_to_table(L, GetMouseDelta());      return 1; }
-static int lua_GetMouseWheelMoveV(lua_State *L) { push_vector2_to_table(L, GetMouseWheelMoveV()); return 1; }
+static int lua_GetMouseDelta(lua_State *L)      { return return_vector2(L, 1, GetMouseDelta()); }
+static int lua_GetMouseWheelMoveV(lua_State *L) { return return_vector2(L, 1, GetMouseWheelMoveV()); }
 static int lua_SetMouseCursor(lua_State *L)     { SetMouseCursor((int)luaL_checkinteger(L, 1));   return 0; }
 
 static int lua_IsGamepadAvailable(lua_State *L) {
@@ -496,9 +488,9 @@ static int lua_IsGestureDetected(lua_State *L) {
 }
 static int lua_GetGestureDetected(lua_State *L)     { lua_pushinteger(L, GetGestureDetected());     return 1; }
 static int lua_GetGestureHoldDuration(lua_State *L) { lua_pushnumber(L, GetGestureHoldDuration());   return 1; }
-static int lua_GetGestureDragVector(lua_State *L)   { push_vector2_to_table(L, GetGestureDragVector());  return 1; }
+static int lua_GetGestureDragVector(lua_State *L)   { return return_vector2(L, 1, GetGestureDragVector()); }
 static int lua_GetGestureDragAngle(lua_State *L)    { lua_pushnumber(L, GetGestureDragAngle());      return 1; }
-static int lua_GetGesturePinchVector(lua_State *L)  { push_vector2_to_table(L, GetGesturePinchVector()); return 1; }
+static int lua_GetGesturePinchVector(lua_State *L)  { return return_vector2(L, 1, GetGesturePinchVector()); }
 static int lua_GetGesturePinchAngle(lua_State *L)   { lua_pushnumber(L, GetGesturePinchAngle());     return 1; }
 
 static int lua_GetTouchX(lua_State *L)          { lua_pushinteger(L, GetTouchX());          return 1; }
@@ -727,15 +719,15 @@ static int lua_SetWindowIcons(lua_State *L) {
     luaL_checktype(L, 1, LUA_TTABLE);
     int count = (int)luaL_len(L, 1);
     if (count <= 0) { SetWindowIcons(NULL, 0); return 0; }
-    Image *images = (Image *)malloc(sizeof(Image) * count);
+    Image *images = (Image *)scratch_alloc(L, sizeof(Image) * count);
     for (int i = 0; i < count; i++) {
         lua_rawgeti(L, 1, i + 1);
-        Image *img = luaL_checkudata(L, -1, "Image");
+        Image *img = check_udata(L, -1, Image);
         images[i] = *img;
         lua_pop(L, 1);
     }
     SetWindowIcons(images, count);   // raylib copies the pixel data internally
-    free(images);
+    scratch_pop(L, images);
     return 0;
 }
 
@@ -748,9 +740,9 @@ static int lua_LoadMusicStreamFromMemory(lua_State *L) {
     size_t dataSize;
     const char *data = luaL_checklstring(L, 2, &dataSize);
     Music music = LoadMusicStreamFromMemory(fileType, (const unsigned char *)data, (int)dataSize);
-    Music *p = (Music *)lua_newuserdata(L, sizeof(Music));
-    *p = music;
-    luaL_setmetatable(L, "Music");
+    push_resource(L, RESOURCE_MUSIC, "Music", &music);
+    lua_pushvalue(L, 2);            // the stream decodes from `data` for as long as it lives
+    lua_setiuservalue(L, -2, 1);
     return 1;
 }
 
@@ -787,13 +779,13 @@ static int lua_LoadVrStereoConfig(lua_State *L) {
 }
 
 static int lua_UnloadVrStereoConfig(lua_State *L) {
-    VrStereoConfig *config = luaL_checkudata(L, 1, "VrStereoConfig");
+    VrStereoConfig *config = check_udata(L, 1, VrStereoConfig);
     UnloadVrStereoConfig(*config);
     return 0;
 }
 
 static int lua_BeginVrStereoMode(lua_State *L) {
-    VrStereoConfig *config = luaL_checkudata(L, 1, "VrStereoConfig");
+    VrStereoConfig *config = check_udata(L, 1, VrStereoConfig);
     BeginVrStereoMode(*config);
     return 0;
 }
@@ -813,20 +805,20 @@ static int lua_LoadAutomationEventList(lua_State *L) {
 }
 
 static int lua_UnloadAutomationEventList(lua_State *L) {
-    AutomationEventList *list = luaL_checkudata(L, 1, "AutomationEventList");
+    AutomationEventList *list = check_udata(L, 1, AutomationEventList);
     UnloadAutomationEventList(*list);
     return 0;
 }
 
 static int lua_ExportAutomationEventList(lua_State *L) {
-    AutomationEventList *list = luaL_checkudata(L, 1, "AutomationEventList");
+    AutomationEventList *list = check_udata(L, 1, AutomationEventList);
     const char *fileName = luaL_checkstring(L, 2);
     lua_pushboolean(L, ExportAutomationEventList(*list, fileName));
     return 1;
 }
 
 static int lua_SetAutomationEventList(lua_State *L) {
-    AutomationEventList *list = luaL_checkudata(L, 1, "AutomationEventList");
+    AutomationEventList *list = check_udata(L, 1, AutomationEventList);
     SetAutomationEventList(list);   // raylib keeps this pointer; keep the userdata alive in Lua
     return 0;
 }
@@ -841,7 +833,7 @@ static int lua_StopAutomationEventRecording(lua_State *L)  { (void)L; StopAutoma
 
 // Accessor (not a raylib function): number of recorded events in a list.
 static int lua_GetAutomationEventCount(lua_State *L) {
-    AutomationEventList *list = luaL_checkudata(L, 1, "AutomationEventList");
+    AutomationEventList *list = check_udata(L, 1, AutomationEventList);
     lua_pushinteger(L, (lua_Integer)list->count);
     return 1;
 }
@@ -849,7 +841,7 @@ static int lua_GetAutomationEventCount(lua_State *L) {
 // raylib's PlayAutomationEvent takes a single AutomationEvent; from Lua we
 // address it by (list, index) since events live inside the list userdata.
 static int lua_PlayAutomationEvent(lua_State *L) {
-    AutomationEventList *list = luaL_checkudata(L, 1, "AutomationEventList");
+    AutomationEventList *list = check_udata(L, 1, AutomationEventList);
     lua_Integer index = luaL_checkinteger(L, 2);
     if (index < 0 || (unsigned int)index >= list->count)
         return luaL_error(L, "PlayAutomationEvent: index %d out of range [0,%d)", (int)index, (int)list->count);
@@ -991,11 +983,29 @@ static int lua_MemAlloc(lua_State *L) {
     return 1;
 }
 static int lua_MemRealloc(lua_State *L) {
+    luaL_checktype(L, 1, LUA_TLIGHTUSERDATA);
     void *p = MemRealloc(lua_touserdata(L, 1), (unsigned int)luaL_checkinteger(L, 2));
     if (p) lua_pushlightuserdata(L, p); else lua_pushnil(L);
     return 1;
 }
+// A PixelBuffer or SampleBuffer is released the way UnloadImageColors /
+// UnloadWaveSamples do it, so its own __gc later finds nothing left to free.
 static int lua_MemFree(lua_State *L) {
+    PixelBuffer *pb = test_udata(L, 1, PixelBuffer);
+    if (pb != NULL) {
+        MemFree(pb->data);
+        pb->data = NULL;
+        pb->width = pb->height = 0;
+        return 0;
+    }
+    SampleBuffer *sb = test_udata(L, 1, SampleBuffer);
+    if (sb != NULL) {
+        MemFree(sb->data);
+        sb->data = NULL;
+        sb->frames = 0;
+        return 0;
+    }
+    luaL_checktype(L, 1, LUA_TLIGHTUSERDATA);
     MemFree(lua_touserdata(L, 1));
     return 0;
 }
@@ -1034,15 +1044,12 @@ static int lua_LoadFontData(lua_State *L) {
     int type = (int)luaL_optinteger(L, 4, 0);     // arg 3 = optional codepoints array
     int *codepoints = NULL; int codepointCount = 0;
     if (lua_istable(L, 3)) {
-        codepointCount = (int)luaL_len(L, 3);
-        if (codepointCount > 0) {
-            codepoints = (int *)malloc(sizeof(int) * codepointCount);
-            for (int i = 0; i < codepointCount; i++) { lua_rawgeti(L, 3, i + 1); codepoints[i] = (int)luaL_checkinteger(L, -1); lua_pop(L, 1); }
-        }
+        codepoints = get_int_array_from_table(L, 3, &codepointCount);
+        if (codepointCount == 0) codepoints = NULL;
     }
     int glyphCount = 0;
     GlyphInfo *glyphs = LoadFontData((const unsigned char *)fileData, (int)dataSize, fontSize, codepoints, codepointCount, type, &glyphCount);
-    free(codepoints);
+    scratch_pop(L, codepoints);
     GlyphInfoArray *arr = (GlyphInfoArray *)lua_newuserdata(L, sizeof(GlyphInfoArray));
     arr->glyphs = glyphs;
     arr->count = glyphCount;   // raylib reports the actual glyph count
@@ -1051,7 +1058,7 @@ static int lua_LoadFontData(lua_State *L) {
 }
 
 static int lua_GenImageFontAtlas(lua_State *L) {
-    GlyphInfoArray *arr = luaL_checkudata(L, 1, "GlyphInfoArray");
+    GlyphInfoArray *arr = check_udata(L, 1, GlyphInfoArray);
     int fontSize   = (int)luaL_checkinteger(L, 2);
     int padding    = (int)luaL_checkinteger(L, 3);
     int packMethod = (int)luaL_checkinteger(L, 4);
@@ -1067,11 +1074,25 @@ static int lua_GenImageFontAtlas(lua_State *L) {
 }
 
 static int lua_UnloadFontData(lua_State *L) {
-    GlyphInfoArray *arr = luaL_checkudata(L, 1, "GlyphInfoArray");
+    GlyphInfoArray *arr = check_udata(L, 1, GlyphInfoArray);
     if (arr->glyphs != NULL) { UnloadFontData(arr->glyphs, arr->count); arr->glyphs = NULL; arr->count = 0; }
     return 0;
 }
 
+// ---------------------------------------------------------------------------
+// Scratch arena (transient marshalling buffers; reset by EndDrawing)
+// ---------------------------------------------------------------------------
+
+static int lua_ResetScratchArena(lua_State *L) {
+    scratch_reset(L);
+    return 0;
+}
+
+static int lua_GetScratchArenaStats(lua_State *L) {
+    push_scratch_stats(L);
+    return 1;
+}
+
 // ---------------------------------------------------------------------------
 // Registration
 // ---------------------------------------------------------------------------
@@ -1177,6 +1198,8 @@ static const luaL_Reg extra_functions[] = {
     {"MemAlloc", lua_MemAlloc}, {"MemRealloc", lua_MemRealloc}, {"MemFree", lua_MemFree},
     // Font atlas internals
     {"LoadFontData", lua_LoadFontData}, {"GenImageFontAtlas", lua_GenImageFontAtlas}, {"UnloadFontData", lua_UnloadFontData},
+    // Scratch arena
+    {"ResetScratchArena", lua_ResetScratchArena}, {"GetScratchArenaStats", lua_GetScratchArenaStats},
     // Drag-and-drop
     {"IsFileDropped", lua_IsFileDropped}, {"LoadDroppedFiles", lua_LoadDroppedFiles}, {"UnloadDroppedFiles", lua_UnloadDroppedFiles},
     {NULL, NULL}
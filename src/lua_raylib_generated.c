@@ -0,0 +1,611 @@
+// lua_raylib_generated.c — GENERATED by tools/gen_bindings.lua, do not edit.
+// Regenerate with `make generate` after upgrading raylib or adding a
+// hand-written binding (hand-written ones always take precedence).
+//
+// Bound here: every RLAPI/RMAPI function not registered by the hand-written
+// modules whose types the generator knows how to marshal. Functions are
+// grouped by signature; each signature has one marshaller that reads the Lua
+// arguments, calls the C function stored in its GenBinding upvalue and
+// pushes the result. Vector/rectangle/color/matrix results accept the usual
+// optional trailing destination argument.
+
+#include "raylib.h"
+#define RAYMATH_STATIC_INLINE
+#include "raymath.h"
+#include <lua.h>
+#include <lauxlib.h>
+#include "raylib_wrappers.h"
+
+typedef void (*gen_any_fn)(void);
+
+typedef struct GenBinding {
+    const char *name;
+    lua_CFunction marshal;
+    gen_any_fn fn;
+} GenBinding;
+
+// The C function behind the running marshaller.
+#define GEN_FN(type) ((type)((const GenBinding *)lua_touserdata(L, lua_upvalueindex(1)))->fn)
+
+// ---------------------------------------------------------------------------
+// Marshallers (51 signatures)
+// ---------------------------------------------------------------------------
+
+typedef Matrix (*gen_M__M_M_fn)(Matrix, Matrix);
+static int gen_M__M_M(lua_State *L) {
+    Matrix a1 = get_matrix_from_table(L, 1);
+    Matrix a2 = get_matrix_from_table(L, 2);
+    Matrix r = GEN_FN(gen_M__M_M_fn)(a1, a2);
+    return return_matrix(L, 3, r);
+}
+
+typedef Matrix (*gen_M__M_f_fn)(Matrix, float);
+static int gen_M__M_f(lua_State *L) {
+    Matrix a1 = get_matrix_from_table(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    Matrix r = GEN_FN(gen_M__M_f_fn)(a1, a2);
+    return return_matrix(L, 3, r);
+}
+
+typedef Matrix (*gen_M__V3_fn)(Vector3);
+static int gen_M__V3(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Matrix r = GEN_FN(gen_M__V3_fn)(a1);
+    return return_matrix(L, 2, r);
+}
+
+typedef Matrix (*gen_M__V3_V4_V3_fn)(Vector3, Vector4, Vector3);
+static int gen_M__V3_V4_V3(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector4 a2 = get_vector4_from_table(L, 2);
+    Vector3 a3 = get_vector3_from_table(L, 3);
+    Matrix r = GEN_FN(gen_M__V3_V4_V3_fn)(a1, a2, a3);
+    return return_matrix(L, 4, r);
+}
+
+typedef Matrix (*gen_M__V4_fn)(Vector4);
+static int gen_M__V4(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    Matrix r = GEN_FN(gen_M__V4_fn)(a1);
+    return return_matrix(L, 2, r);
+}
+
+typedef Matrix (*gen_M__d_d_d_d_d_d_fn)(double, double, double, double, double, double);
+static int gen_M__d_d_d_d_d_d(lua_State *L) {
+    double a1 = luaL_checknumber(L, 1);
+    double a2 = luaL_checknumber(L, 2);
+    double a3 = luaL_checknumber(L, 3);
+    double a4 = luaL_checknumber(L, 4);
+    double a5 = luaL_checknumber(L, 5);
+    double a6 = luaL_checknumber(L, 6);
+    Matrix r = GEN_FN(gen_M__d_d_d_d_d_d_fn)(a1, a2, a3, a4, a5, a6);
+    return return_matrix(L, 7, r);
+}
+
+typedef Vector2 (*gen_V2__V2_fn)(Vector2);
+static int gen_V2__V2(lua_State *L) {
+    Vector2 a1 = get_vector2_from_table(L, 1);
+    Vector2 r = GEN_FN(gen_V2__V2_fn)(a1);
+    return return_vector2(L, 2, r);
+}
+
+typedef Vector2 (*gen_V2__V2_M_fn)(Vector2, Matrix);
+static int gen_V2__V2_M(lua_State *L) {
+    Vector2 a1 = get_vector2_from_table(L, 1);
+    Matrix a2 = get_matrix_from_table(L, 2);
+    Vector2 r = GEN_FN(gen_V2__V2_M_fn)(a1, a2);
+    return return_vector2(L, 3, r);
+}
+
+typedef Vector2 (*gen_V2__V2_V2_fn)(Vector2, Vector2);
+static int gen_V2__V2_V2(lua_State *L) {
+    Vector2 a1 = get_vector2_from_table(L, 1);
+    Vector2 a2 = get_vector2_from_table(L, 2);
+    Vector2 r = GEN_FN(gen_V2__V2_V2_fn)(a1, a2);
+    return return_vector2(L, 3, r);
+}
+
+typedef Vector2 (*gen_V2__V2_V2_V2_fn)(Vector2, Vector2, Vector2);
+static int gen_V2__V2_V2_V2(lua_State *L) {
+    Vector2 a1 = get_vector2_from_table(L, 1);
+    Vector2 a2 = get_vector2_from_table(L, 2);
+    Vector2 a3 = get_vector2_from_table(L, 3);
+    Vector2 r = GEN_FN(gen_V2__V2_V2_V2_fn)(a1, a2, a3);
+    return return_vector2(L, 4, r);
+}
+
+typedef Vector2 (*gen_V2__V2_V2_f_fn)(Vector2, Vector2, float);
+static int gen_V2__V2_V2_f(lua_State *L) {
+    Vector2 a1 = get_vector2_from_table(L, 1);
+    Vector2 a2 = get_vector2_from_table(L, 2);
+    float a3 = (float)luaL_checknumber(L, 3);
+    Vector2 r = GEN_FN(gen_V2__V2_V2_f_fn)(a1, a2, a3);
+    return return_vector2(L, 4, r);
+}
+
+typedef Vector2 (*gen_V2__V2_f_fn)(Vector2, float);
+static int gen_V2__V2_f(lua_State *L) {
+    Vector2 a1 = get_vector2_from_table(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    Vector2 r = GEN_FN(gen_V2__V2_f_fn)(a1, a2);
+    return return_vector2(L, 3, r);
+}
+
+typedef Vector2 (*gen_V2__V2_f_f_fn)(Vector2, float, float);
+static int gen_V2__V2_f_f(lua_State *L) {
+    Vector2 a1 = get_vector2_from_table(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    float a3 = (float)luaL_checknumber(L, 3);
+    Vector2 r = GEN_FN(gen_V2__V2_f_f_fn)(a1, a2, a3);
+    return return_vector2(L, 4, r);
+}
+
+typedef Vector2 (*gen_V2__v_fn)(void);
+static int gen_V2__v(lua_State *L) {
+    Vector2 r = GEN_FN(gen_V2__v_fn)();
+    return return_vector2(L, 1, r);
+}
+
+typedef Vector3 (*gen_V3__V3_fn)(Vector3);
+static int gen_V3__V3(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector3 r = GEN_FN(gen_V3__V3_fn)(a1);
+    return return_vector3(L, 2, r);
+}
+
+typedef Vector3 (*gen_V3__V3_M_fn)(Vector3, Matrix);
+static int gen_V3__V3_M(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Matrix a2 = get_matrix_from_table(L, 2);
+    Vector3 r = GEN_FN(gen_V3__V3_M_fn)(a1, a2);
+    return return_vector3(L, 3, r);
+}
+
+typedef Vector3 (*gen_V3__V3_M_M_fn)(Vector3, Matrix, Matrix);
+static int gen_V3__V3_M_M(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Matrix a2 = get_matrix_from_table(L, 2);
+    Matrix a3 = get_matrix_from_table(L, 3);
+    Vector3 r = GEN_FN(gen_V3__V3_M_M_fn)(a1, a2, a3);
+    return return_vector3(L, 4, r);
+}
+
+typedef Vector3 (*gen_V3__V3_V3_fn)(Vector3, Vector3);
+static int gen_V3__V3_V3(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector3 a2 = get_vector3_from_table(L, 2);
+    Vector3 r = GEN_FN(gen_V3__V3_V3_fn)(a1, a2);
+    return return_vector3(L, 3, r);
+}
+
+typedef Vector3 (*gen_V3__V3_V3_V3_fn)(Vector3, Vector3, Vector3);
+static int gen_V3__V3_V3_V3(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector3 a2 = get_vector3_from_table(L, 2);
+    Vector3 a3 = get_vector3_from_table(L, 3);
+    Vector3 r = GEN_FN(gen_V3__V3_V3_V3_fn)(a1, a2, a3);
+    return return_vector3(L, 4, r);
+}
+
+typedef Vector3 (*gen_V3__V3_V3_V3_V3_fn)(Vector3, Vector3, Vector3, Vector3);
+static int gen_V3__V3_V3_V3_V3(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector3 a2 = get_vector3_from_table(L, 2);
+    Vector3 a3 = get_vector3_from_table(L, 3);
+    Vector3 a4 = get_vector3_from_table(L, 4);
+    Vector3 r = GEN_FN(gen_V3__V3_V3_V3_V3_fn)(a1, a2, a3, a4);
+    return return_vector3(L, 5, r);
+}
+
+typedef Vector3 (*gen_V3__V3_V3_V3_V3_f_fn)(Vector3, Vector3, Vector3, Vector3, float);
+static int gen_V3__V3_V3_V3_V3_f(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector3 a2 = get_vector3_from_table(L, 2);
+    Vector3 a3 = get_vector3_from_table(L, 3);
+    Vector3 a4 = get_vector3_from_table(L, 4);
+    float a5 = (float)luaL_checknumber(L, 5);
+    Vector3 r = GEN_FN(gen_V3__V3_V3_V3_V3_f_fn)(a1, a2, a3, a4, a5);
+    return return_vector3(L, 6, r);
+}
+
+typedef Vector3 (*gen_V3__V3_V3_f_fn)(Vector3, Vector3, float);
+static int gen_V3__V3_V3_f(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector3 a2 = get_vector3_from_table(L, 2);
+    float a3 = (float)luaL_checknumber(L, 3);
+    Vector3 r = GEN_FN(gen_V3__V3_V3_f_fn)(a1, a2, a3);
+    return return_vector3(L, 4, r);
+}
+
+typedef Vector3 (*gen_V3__V3_V4_fn)(Vector3, Vector4);
+static int gen_V3__V3_V4(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector4 a2 = get_vector4_from_table(L, 2);
+    Vector3 r = GEN_FN(gen_V3__V3_V4_fn)(a1, a2);
+    return return_vector3(L, 3, r);
+}
+
+typedef Vector3 (*gen_V3__V3_f_fn)(Vector3, float);
+static int gen_V3__V3_f(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    Vector3 r = GEN_FN(gen_V3__V3_f_fn)(a1, a2);
+    return return_vector3(L, 3, r);
+}
+
+typedef Vector3 (*gen_V3__V3_f_f_fn)(Vector3, float, float);
+static int gen_V3__V3_f_f(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    float a3 = (float)luaL_checknumber(L, 3);
+    Vector3 r = GEN_FN(gen_V3__V3_f_f_fn)(a1, a2, a3);
+    return return_vector3(L, 4, r);
+}
+
+typedef Vector3 (*gen_V3__V4_fn)(Vector4);
+static int gen_V3__V4(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    Vector3 r = GEN_FN(gen_V3__V4_fn)(a1);
+    return return_vector3(L, 2, r);
+}
+
+typedef Vector3 (*gen_V3__v_fn)(void);
+static int gen_V3__v(lua_State *L) {
+    Vector3 r = GEN_FN(gen_V3__v_fn)();
+    return return_vector3(L, 1, r);
+}
+
+typedef Vector4 (*gen_V4__M_fn)(Matrix);
+static int gen_V4__M(lua_State *L) {
+    Matrix a1 = get_matrix_from_table(L, 1);
+    Vector4 r = GEN_FN(gen_V4__M_fn)(a1);
+    return return_vector4(L, 2, r);
+}
+
+typedef Vector4 (*gen_V4__V3_V3_fn)(Vector3, Vector3);
+static int gen_V4__V3_V3(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector3 a2 = get_vector3_from_table(L, 2);
+    Vector4 r = GEN_FN(gen_V4__V3_V3_fn)(a1, a2);
+    return return_vector4(L, 3, r);
+}
+
+typedef Vector4 (*gen_V4__V3_f_fn)(Vector3, float);
+static int gen_V4__V3_f(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    Vector4 r = GEN_FN(gen_V4__V3_f_fn)(a1, a2);
+    return return_vector4(L, 3, r);
+}
+
+typedef Vector4 (*gen_V4__V4_fn)(Vector4);
+static int gen_V4__V4(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    Vector4 r = GEN_FN(gen_V4__V4_fn)(a1);
+    return return_vector4(L, 2, r);
+}
+
+typedef Vector4 (*gen_V4__V4_M_fn)(Vector4, Matrix);
+static int gen_V4__V4_M(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    Matrix a2 = get_matrix_from_table(L, 2);
+    Vector4 r = GEN_FN(gen_V4__V4_M_fn)(a1, a2);
+    return return_vector4(L, 3, r);
+}
+
+typedef Vector4 (*gen_V4__V4_V4_fn)(Vector4, Vector4);
+static int gen_V4__V4_V4(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    Vector4 a2 = get_vector4_from_table(L, 2);
+    Vector4 r = GEN_FN(gen_V4__V4_V4_fn)(a1, a2);
+    return return_vector4(L, 3, r);
+}
+
+typedef Vector4 (*gen_V4__V4_V4_V4_V4_f_fn)(Vector4, Vector4, Vector4, Vector4, float);
+static int gen_V4__V4_V4_V4_V4_f(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    Vector4 a2 = get_vector4_from_table(L, 2);
+    Vector4 a3 = get_vector4_from_table(L, 3);
+    Vector4 a4 = get_vector4_from_table(L, 4);
+    float a5 = (float)luaL_checknumber(L, 5);
+    Vector4 r = GEN_FN(gen_V4__V4_V4_V4_V4_f_fn)(a1, a2, a3, a4, a5);
+    return return_vector4(L, 6, r);
+}
+
+typedef Vector4 (*gen_V4__V4_V4_f_fn)(Vector4, Vector4, float);
+static int gen_V4__V4_V4_f(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    Vector4 a2 = get_vector4_from_table(L, 2);
+    float a3 = (float)luaL_checknumber(L, 3);
+    Vector4 r = GEN_FN(gen_V4__V4_V4_f_fn)(a1, a2, a3);
+    return return_vector4(L, 4, r);
+}
+
+typedef Vector4 (*gen_V4__V4_f_fn)(Vector4, float);
+static int gen_V4__V4_f(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    Vector4 r = GEN_FN(gen_V4__V4_f_fn)(a1, a2);
+    return return_vector4(L, 3, r);
+}
+
+typedef Vector4 (*gen_V4__f_f_f_fn)(float, float, float);
+static int gen_V4__f_f_f(lua_State *L) {
+    float a1 = (float)luaL_checknumber(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    float a3 = (float)luaL_checknumber(L, 3);
+    Vector4 r = GEN_FN(gen_V4__f_f_f_fn)(a1, a2, a3);
+    return return_vector4(L, 4, r);
+}
+
+typedef Vector4 (*gen_V4__v_fn)(void);
+static int gen_V4__v(lua_State *L) {
+    Vector4 r = GEN_FN(gen_V4__v_fn)();
+    return return_vector4(L, 1, r);
+}
+
+typedef float (*gen_f__M_fn)(Matrix);
+static int gen_f__M(lua_State *L) {
+    Matrix a1 = get_matrix_from_table(L, 1);
+    float r = GEN_FN(gen_f__M_fn)(a1);
+    lua_pushnumber(L, r);
+    return 1;
+}
+
+typedef float (*gen_f__V2_fn)(Vector2);
+static int gen_f__V2(lua_State *L) {
+    Vector2 a1 = get_vector2_from_table(L, 1);
+    float r = GEN_FN(gen_f__V2_fn)(a1);
+    lua_pushnumber(L, r);
+    return 1;
+}
+
+typedef float (*gen_f__V2_V2_fn)(Vector2, Vector2);
+static int gen_f__V2_V2(lua_State *L) {
+    Vector2 a1 = get_vector2_from_table(L, 1);
+    Vector2 a2 = get_vector2_from_table(L, 2);
+    float r = GEN_FN(gen_f__V2_V2_fn)(a1, a2);
+    lua_pushnumber(L, r);
+    return 1;
+}
+
+typedef float (*gen_f__V3_fn)(Vector3);
+static int gen_f__V3(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    float r = GEN_FN(gen_f__V3_fn)(a1);
+    lua_pushnumber(L, r);
+    return 1;
+}
+
+typedef float (*gen_f__V3_V3_fn)(Vector3, Vector3);
+static int gen_f__V3_V3(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector3 a2 = get_vector3_from_table(L, 2);
+    float r = GEN_FN(gen_f__V3_V3_fn)(a1, a2);
+    lua_pushnumber(L, r);
+    return 1;
+}
+
+typedef float (*gen_f__V4_fn)(Vector4);
+static int gen_f__V4(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    float r = GEN_FN(gen_f__V4_fn)(a1);
+    lua_pushnumber(L, r);
+    return 1;
+}
+
+typedef float (*gen_f__V4_V4_fn)(Vector4, Vector4);
+static int gen_f__V4_V4(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    Vector4 a2 = get_vector4_from_table(L, 2);
+    float r = GEN_FN(gen_f__V4_V4_fn)(a1, a2);
+    lua_pushnumber(L, r);
+    return 1;
+}
+
+typedef float (*gen_f__f_f_f_fn)(float, float, float);
+static int gen_f__f_f_f(lua_State *L) {
+    float a1 = (float)luaL_checknumber(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    float a3 = (float)luaL_checknumber(L, 3);
+    float r = GEN_FN(gen_f__f_f_f_fn)(a1, a2, a3);
+    lua_pushnumber(L, r);
+    return 1;
+}
+
+typedef float (*gen_f__f_f_f_f_f_fn)(float, float, float, float, float);
+static int gen_f__f_f_f_f_f(lua_State *L) {
+    float a1 = (float)luaL_checknumber(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    float a3 = (float)luaL_checknumber(L, 3);
+    float a4 = (float)luaL_checknumber(L, 4);
+    float a5 = (float)luaL_checknumber(L, 5);
+    float r = GEN_FN(gen_f__f_f_f_f_f_fn)(a1, a2, a3, a4, a5);
+    lua_pushnumber(L, r);
+    return 1;
+}
+
+typedef int (*gen_i__V2_V2_fn)(Vector2, Vector2);
+static int gen_i__V2_V2(lua_State *L) {
+    Vector2 a1 = get_vector2_from_table(L, 1);
+    Vector2 a2 = get_vector2_from_table(L, 2);
+    int r = GEN_FN(gen_i__V2_V2_fn)(a1, a2);
+    lua_pushinteger(L, r);
+    return 1;
+}
+
+typedef int (*gen_i__V3_V3_fn)(Vector3, Vector3);
+static int gen_i__V3_V3(lua_State *L) {
+    Vector3 a1 = get_vector3_from_table(L, 1);
+    Vector3 a2 = get_vector3_from_table(L, 2);
+    int r = GEN_FN(gen_i__V3_V3_fn)(a1, a2);
+    lua_pushinteger(L, r);
+    return 1;
+}
+
+typedef int (*gen_i__V4_V4_fn)(Vector4, Vector4);
+static int gen_i__V4_V4(lua_State *L) {
+    Vector4 a1 = get_vector4_from_table(L, 1);
+    Vector4 a2 = get_vector4_from_table(L, 2);
+    int r = GEN_FN(gen_i__V4_V4_fn)(a1, a2);
+    lua_pushinteger(L, r);
+    return 1;
+}
+
+typedef int (*gen_i__f_f_fn)(float, float);
+static int gen_i__f_f(lua_State *L) {
+    float a1 = (float)luaL_checknumber(L, 1);
+    float a2 = (float)luaL_checknumber(L, 2);
+    int r = GEN_FN(gen_i__f_f_fn)(a1, a2);
+    lua_pushinteger(L, r);
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Binding table (127 functions)
+// ---------------------------------------------------------------------------
+
+static const GenBinding generated_bindings[] = {
+    // raymath.h
+    {"Clamp", gen_f__f_f_f, (gen_any_fn)Clamp},
+    {"Lerp", gen_f__f_f_f, (gen_any_fn)Lerp},
+    {"Normalize", gen_f__f_f_f, (gen_any_fn)Normalize},
+    {"Remap", gen_f__f_f_f_f_f, (gen_any_fn)Remap},
+    {"Wrap", gen_f__f_f_f, (gen_any_fn)Wrap},
+    {"FloatEquals", gen_i__f_f, (gen_any_fn)FloatEquals},
+    {"Vector2Zero", gen_V2__v, (gen_any_fn)Vector2Zero},
+    {"Vector2One", gen_V2__v, (gen_any_fn)Vector2One},
+    {"Vector2Add", gen_V2__V2_V2, (gen_any_fn)Vector2Add},
+    {"Vector2AddValue", gen_V2__V2_f, (gen_any_fn)Vector2AddValue},
+    {"Vector2Subtract", gen_V2__V2_V2, (gen_any_fn)Vector2Subtract},
+    {"Vector2SubtractValue", gen_V2__V2_f, (gen_any_fn)Vector2SubtractValue},
+    {"Vector2Length", gen_f__V2, (gen_any_fn)Vector2Length},
+    {"Vector2LengthSqr", gen_f__V2, (gen_any_fn)Vector2LengthSqr},
+    {"Vector2DotProduct", gen_f__V2_V2, (gen_any_fn)Vector2DotProduct},
+    {"Vector2CrossProduct", gen_f__V2_V2, (gen_any_fn)Vector2CrossProduct},
+    {"Vector2Distance", gen_f__V2_V2, (gen_any_fn)Vector2Distance},
+    {"Vector2DistanceSqr", gen_f__V2_V2, (gen_any_fn)Vector2DistanceSqr},
+    {"Vector2Angle", gen_f__V2_V2, (gen_any_fn)Vector2Angle},
+    {"Vector2LineAngle", gen_f__V2_V2, (gen_any_fn)Vector2LineAngle},
+    {"Vector2Scale", gen_V2__V2_f, (gen_any_fn)Vector2Scale},
+    {"Vector2Multiply", gen_V2__V2_V2, (gen_any_fn)Vector2Multiply},
+    {"Vector2Negate", gen_V2__V2, (gen_any_fn)Vector2Negate},
+    {"Vector2Divide", gen_V2__V2_V2, (gen_any_fn)Vector2Divide},
+    {"Vector2Normalize", gen_V2__V2, (gen_any_fn)Vector2Normalize},
+    {"Vector2Transform", gen_V2__V2_M, (gen_any_fn)Vector2Transform},
+    {"Vector2Lerp", gen_V2__V2_V2_f, (gen_any_fn)Vector2Lerp},
+    {"Vector2Reflect", gen_V2__V2_V2, (gen_any_fn)Vector2Reflect},
+    {"Vector2Min", gen_V2__V2_V2, (gen_any_fn)Vector2Min},
+    {"Vector2Max", gen_V2__V2_V2, (gen_any_fn)Vector2Max},
+    {"Vector2Rotate", gen_V2__V2_f, (gen_any_fn)Vector2Rotate},
+    {"Vector2MoveTowards", gen_V2__V2_V2_f, (gen_any_fn)Vector2MoveTowards},
+    {"Vector2Invert", gen_V2__V2, (gen_any_fn)Vector2Invert},
+    {"Vector2Clamp", gen_V2__V2_V2_V2, (gen_any_fn)Vector2Clamp},
+    {"Vector2ClampValue", gen_V2__V2_f_f, (gen_any_fn)Vector2ClampValue},
+    {"Vector2Equals", gen_i__V2_V2, (gen_any_fn)Vector2Equals},
+    {"Vector2Refract", gen_V2__V2_V2_f, (gen_any_fn)Vector2Refract},
+    {"Vector3Zero", gen_V3__v, (gen_any_fn)Vector3Zero},
+    {"Vector3One", gen_V3__v, (gen_any_fn)Vector3One},
+    {"Vector3Add", gen_V3__V3_V3, (gen_any_fn)Vector3Add},
+    {"Vector3AddValue", gen_V3__V3_f, (gen_any_fn)Vector3AddValue},
+    {"Vector3Subtract", gen_V3__V3_V3, (gen_any_fn)Vector3Subtract},
+    {"Vector3SubtractValue", gen_V3__V3_f, (gen_any_fn)Vector3SubtractValue},
+    {"Vector3Scale", gen_V3__V3_f, (gen_any_fn)Vector3Scale},
+    {"Vector3Multiply", gen_V3__V3_V3, (gen_any_fn)Vector3Multiply},
+    {"Vector3CrossProduct", gen_V3__V3_V3, (gen_any_fn)Vector3CrossProduct},
+    {"Vector3Perpendicular", gen_V3__V3, (gen_any_fn)Vector3Perpendicular},
+    {"Vector3Length", gen_f__V3, (gen_any_fn)Vector3Length},
+    {"Vector3LengthSqr", gen_f__V3, (gen_any_fn)Vector3LengthSqr},
+    {"Vector3DotProduct", gen_f__V3_V3, (gen_any_fn)Vector3DotProduct},
+    {"Vector3Distance", gen_f__V3_V3, (gen_any_fn)Vector3Distance},
+    {"Vector3DistanceSqr", gen_f__V3_V3, (gen_any_fn)Vector3DistanceSqr},
+    {"Vector3Angle", gen_f__V3_V3, (gen_any_fn)Vector3Angle},
+    {"Vector3Negate", gen_V3__V3, (gen_any_fn)Vector3Negate},
+    {"Vector3Divide", gen_V3__V3_V3, (gen_any_fn)Vector3Divide},
+    {"Vector3Normalize", gen_V3__V3, (gen_any_fn)Vector3Normalize},
+    {"Vector3Project", gen_V3__V3_V3, (gen_any_fn)Vector3Project},
+    {"Vector3Reject", gen_V3__V3_V3, (gen_any_fn)Vector3Reject},
+    {"Vector3Transform", gen_V3__V3_M, (gen_any_fn)Vector3Transform},
+    {"Vector3RotateByQuaternion", gen_V3__V3_V4, (gen_any_fn)Vector3RotateByQuaternion},
+    {"Vector3RotateByAxisAngle", gen_V3__V3_V3_f, (gen_any_fn)Vector3RotateByAxisAngle},
+    {"Vector3MoveTowards", gen_V3__V3_V3_f, (gen_any_fn)Vector3MoveTowards},
+    {"Vector3Lerp", gen_V3__V3_V3_f, (gen_any_fn)Vector3Lerp},
+    {"Vector3CubicHermite", gen_V3__V3_V3_V3_V3_f, (gen_any_fn)Vector3CubicHermite},
+    {"Vector3Reflect", gen_V3__V3_V3, (gen_any_fn)Vector3Reflect},
+    {"Vector3Min", gen_V3__V3_V3, (gen_any_fn)Vector3Min},
+    {"Vector3Max", gen_V3__V3_V3, (gen_any_fn)Vector3Max},
+    {"Vector3Barycenter", gen_V3__V3_V3_V3_V3, (gen_any_fn)Vector3Barycenter},
+    {"Vector3Unproject", gen_V3__V3_M_M, (gen_any_fn)Vector3Unproject},
+    {"Vector3Invert", gen_V3__V3, (gen_any_fn)Vector3Invert},
+    {"Vector3Clamp", gen_V3__V3_V3_V3, (gen_any_fn)Vector3Clamp},
+    {"Vector3ClampValue", gen_V3__V3_f_f, (gen_any_fn)Vector3ClampValue},
+    {"Vector3Equals", gen_i__V3_V3, (gen_any_fn)Vector3Equals},
+    {"Vector3Refract", gen_V3__V3_V3_f, (gen_any_fn)Vector3Refract},
+    {"Vector4Zero", gen_V4__v, (gen_any_fn)Vector4Zero},
+    {"Vector4One", gen_V4__v, (gen_any_fn)Vector4One},
+    {"Vector4Add", gen_V4__V4_V4, (gen_any_fn)Vector4Add},
+    {"Vector4AddValue", gen_V4__V4_f, (gen_any_fn)Vector4AddValue},
+    {"Vector4Subtract", gen_V4__V4_V4, (gen_any_fn)Vector4Subtract},
+    {"Vector4SubtractValue", gen_V4__V4_f, (gen_any_fn)Vector4SubtractValue},
+    {"Vector4Length", gen_f__V4, (gen_any_fn)Vector4Length},
+    {"Vector4LengthSqr", gen_f__V4, (gen_any_fn)Vector4LengthSqr},
+    {"Vector4DotProduct", gen_f__V4_V4, (gen_any_fn)Vector4DotProduct},
+    {"Vector4Distance", gen_f__V4_V4, (gen_any_fn)Vector4Distance},
+    {"Vector4DistanceSqr", gen_f__V4_V4, (gen_any_fn)Vector4DistanceSqr},
+    {"Vector4Scale", gen_V4__V4_f, (gen_any_fn)Vector4Scale},
+    {"Vector4Multiply", gen_V4__V4_V4, (gen_any_fn)Vector4Multiply},
+    {"Vector4Negate", gen_V4__V4, (gen_any_fn)Vector4Negate},
+    {"Vector4Divide", gen_V4__V4_V4, (gen_any_fn)Vector4Divide},
+    {"Vector4Normalize", gen_V4__V4, (gen_any_fn)Vector4Normalize},
+    {"Vector4Min", gen_V4__V4_V4, (gen_any_fn)Vector4Min},
+    {"Vector4Max", gen_V4__V4_V4, (gen_any_fn)Vector4Max},
+    {"Vector4Lerp", gen_V4__V4_V4_f, (gen_any_fn)Vector4Lerp},
+    {"Vector4MoveTowards", gen_V4__V4_V4_f, (gen_any_fn)Vector4MoveTowards},
+    {"Vector4Invert", gen_V4__V4, (gen_any_fn)Vector4Invert},
+    {"Vector4Equals", gen_i__V4_V4, (gen_any_fn)Vector4Equals},
+    {"MatrixDeterminant", gen_f__M, (gen_any_fn)MatrixDeterminant},
+    {"MatrixTrace", gen_f__M, (gen_any_fn)MatrixTrace},
+    {"MatrixAdd", gen_M__M_M, (gen_any_fn)MatrixAdd},
+    {"MatrixSubtract", gen_M__M_M, (gen_any_fn)MatrixSubtract},
+    {"MatrixMultiplyValue", gen_M__M_f, (gen_any_fn)MatrixMultiplyValue},
+    {"MatrixRotateZYX", gen_M__V3, (gen_any_fn)MatrixRotateZYX},
+    {"MatrixFrustum", gen_M__d_d_d_d_d_d, (gen_any_fn)MatrixFrustum},
+    {"QuaternionAdd", gen_V4__V4_V4, (gen_any_fn)QuaternionAdd},
+    {"QuaternionAddValue", gen_V4__V4_f, (gen_any_fn)QuaternionAddValue},
+    {"QuaternionSubtract", gen_V4__V4_V4, (gen_any_fn)QuaternionSubtract},
+    {"QuaternionSubtractValue", gen_V4__V4_f, (gen_any_fn)QuaternionSubtractValue},
+    {"QuaternionIdentity", gen_V4__v, (gen_any_fn)QuaternionIdentity},
+    {"QuaternionLength", gen_f__V4, (gen_any_fn)QuaternionLength},
+    {"QuaternionNormalize", gen_V4__V4, (gen_any_fn)QuaternionNormalize},
+    {"QuaternionInvert", gen_V4__V4, (gen_any_fn)QuaternionInvert},
+    {"QuaternionMultiply", gen_V4__V4_V4, (gen_any_fn)QuaternionMultiply},
+    {"QuaternionScale", gen_V4__V4_f, (gen_any_fn)QuaternionScale},
+    {"QuaternionDivide", gen_V4__V4_V4, (gen_any_fn)QuaternionDivide},
+    {"QuaternionLerp", gen_V4__V4_V4_f, (gen_any_fn)QuaternionLerp},
+    {"QuaternionNlerp", gen_V4__V4_V4_f, (gen_any_fn)QuaternionNlerp},
+    {"QuaternionSlerp", gen_V4__V4_V4_f, (gen_any_fn)QuaternionSlerp},
+    {"QuaternionCubicHermiteSpline", gen_V4__V4_V4_V4_V4_f, (gen_any_fn)QuaternionCubicHermiteSpline},
+    {"QuaternionFromVector3ToVector3", gen_V4__V3_V3, (gen_any_fn)QuaternionFromVector3ToVector3},
+    {"QuaternionFromMatrix", gen_V4__M, (gen_any_fn)QuaternionFromMatrix},
+    {"QuaternionToMatrix", gen_M__V4, (gen_any_fn)QuaternionToMatrix},
+    {"QuaternionFromAxisAngle", gen_V4__V3_f, (gen_any_fn)QuaternionFromAxisAngle},
+    {"QuaternionFromEuler", gen_V4__f_f_f, (gen_any_fn)QuaternionFromEuler},
+    {"QuaternionToEuler", gen_V3__V4, (gen_any_fn)QuaternionToEuler},
+    {"QuaternionTransform", gen_V4__V4_M, (gen_any_fn)QuaternionTransform},
+    {"QuaternionEquals", gen_i__V4_V4, (gen_any_fn)QuaternionEquals},
+    {"MatrixCompose", gen_M__V3_V4_V3, (gen_any_fn)MatrixCompose},
+    {NULL, NULL, NULL}
+};
+
+// Adds every generated binding onto the module table on top of the stack,
+// leaving any name that is already there (hand-written) untouched.
+void register_generated(lua_State *L) {
+    for (const GenBinding *b = generated_bindings; b->name != NULL; b++) {
+        if (lua_getfield(L, -1, b->name) == LUA_TNIL) {
+            lua_pushlightuserdata(L, (void *)b);
+            lua_pushcclosure(L, b->marshal, 1);
+            lua_setfield(L, -3, b->name);
+        }
+        lua_pop(L, 1);
+    }
+}
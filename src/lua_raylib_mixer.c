@@ -0,0 +1,1557 @@
+// lua_raylib_mixer.c
+//
+// Audio that is produced or processed on the mixer thread without entering
+// Lua. raylib's stream callbacks and processors have no user pointer, so they
+// are bound to a fixed table of STREAM_FEED_SLOTS C trampolines; each slot
+// names the function and context to run. raylib invokes them with its mixer
+// lock held and attaching or detaching takes the same lock, so once a feed is
+// detached nothing can still be running on its data.
+//
+// An "AudioRing" is a lock-free single-producer/single-consumer PCM ring fed
+// by one AudioStream. The script pushes frames from the main loop
+// (ring:push); the callback copies out whatever is buffered and pads a short
+// read with silence. Neither side blocks. Underruns (callbacks that ran dry)
+// and overruns (pushes that did not fit) are counted for ring:stats().
+//
+// An "AudioGraph" is a DSP graph (gain, pan, biquad, delay, compressor and
+// bus nodes) built from Lua and run as a stream or mixed processor. Parameter
+// changes travel to the mixer through a lock-free message queue.
+//
+// A "Synth" renders polyphonic oscillator voices with ADSR envelopes into an
+// AudioStream from its callback; Lua sends note and parameter events only.
+//
+// A "SoundPool" caps how many copies of one Sound the mixer plays at once,
+// stealing the oldest or quietest voice when a burst needs more.
+//
+// Unloading an AudioStream, Sound or Music and CloseAudioDevice detach the
+// feeds of the streams they free. register_mixer() creates the metatables and adds the constructors to
+// the module table.
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "raylib.h"
+#include <lua.h>
+#include <lauxlib.h>
+#include "raylib_wrappers.h"
+
+// ---------------------------------------------------------------------------
+// Stream feed slots
+// ---------------------------------------------------------------------------
+
+#define STREAM_FEED_SLOTS 16
+
+typedef void (*StreamFeedFn)(void *ctx, void *buffer, unsigned int frames);
+
+typedef enum FeedKind {
+    FEED_STREAM_CALLBACK,       // fills the stream's buffer (SetAudioStreamCallback)
+    FEED_STREAM_PROCESSOR,      // processes the stream's mixing-format frames (AttachAudioStreamProcessor)
+    FEED_MIXED_PROCESSOR,       // processes the final mix (AttachAudioMixedProcessor)
+} FeedKind;
+
+typedef struct StreamFeed {
+    StreamFeedFn fill;          // NULL if the slot is free
+    void *ctx;
+    FeedKind kind;
+    AudioStream stream;         // unused for FEED_MIXED_PROCESSOR
+    int *slotRef;               // owner's slot index, reset to -1 on detach
+} StreamFeed;
+
+// Written only by the main thread; the mixer reads a slot under raylib's lock.
+static StreamFeed stream_feeds[STREAM_FEED_SLOTS];
+
+#define FEED_TRAMPOLINE(n) \
+    static void feed_trampoline_##n(void *buffer, unsigned int frames) { \
+        stream_feeds[n].fill(stream_feeds[n].ctx, buffer, frames); \
+    }
+FEED_TRAMPOLINE(0)  FEED_TRAMPOLINE(1)  FEED_TRAMPOLINE(2)  FEED_TRAMPOLINE(3)
+FEED_TRAMPOLINE(4)  FEED_TRAMPOLINE(5)  FEED_TRAMPOLINE(6)  FEED_TRAMPOLINE(7)
+FEED_TRAMPOLINE(8)  FEED_TRAMPOLINE(9)  FEED_TRAMPOLINE(10) FEED_TRAMPOLINE(11)
+FEED_TRAMPOLINE(12) FEED_TRAMPOLINE(13) FEED_TRAMPOLINE(14) FEED_TRAMPOLINE(15)
+#undef FEED_TRAMPOLINE
+
+static const AudioCallback feed_trampolines[STREAM_FEED_SLOTS] = {
+    feed_trampoline_0,  feed_trampoline_1,  feed_trampoline_2,  feed_trampoline_3,
+    feed_trampoline_4,  feed_trampoline_5,  feed_trampoline_6,  feed_trampoline_7,
+    feed_trampoline_8,  feed_trampoline_9,  feed_trampoline_10, feed_trampoline_11,
+    feed_trampoline_12, feed_trampoline_13, feed_trampoline_14, feed_trampoline_15,
+};
+
+static void detach_feed(int slot) {
+    StreamFeed *feed = &stream_feeds[slot];
+    // Without a device the mixer thread (and raylib's lock) are already gone.
+    if (IsAudioDeviceReady()) {
+        switch (feed->kind) {
+            case FEED_STREAM_CALLBACK:  SetAudioStreamCallback(feed->stream, NULL); break;
+            case FEED_STREAM_PROCESSOR: DetachAudioStreamProcessor(feed->stream, feed_trampolines[slot]); break;
+            case FEED_MIXED_PROCESSOR:  DetachAudioMixedProcessor(feed_trampolines[slot]); break;
+        }
+    }
+    *feed->slotRef = -1;
+    memset(feed, 0, sizeof(StreamFeed));
+}
+
+// Binds `fill` to `stream` (ignored for FEED_MIXED_PROCESSOR). A stream has
+// one callback, so a new FEED_STREAM_CALLBACK replaces the previous one.
+// Returns the slot, or -1 if every slot is taken.
+static int attach_feed(FeedKind kind, AudioStream stream, StreamFeedFn fill, void *ctx, int *slotRef) {
+    int slot = -1;
+    for (int i = 0; i < STREAM_FEED_SLOTS; i++) {
+        StreamFeed *feed = &stream_feeds[i];
+        if (kind == FEED_STREAM_CALLBACK && feed->fill != NULL && feed->kind == FEED_STREAM_CALLBACK &&
+            feed->stream.buffer == stream.buffer) detach_feed(i);
+        if (slot < 0 && feed->fill == NULL) slot = i;
+    }
+    if (slot < 0) return -1;
+    stream_feeds[slot] = (StreamFeed){ fill, ctx, kind, stream, slotRef };
+    *slotRef = slot;
+    // Each of these publishes the slot under raylib's lock.
+    switch (kind) {
+        case FEED_STREAM_CALLBACK:  SetAudioStreamCallback(stream, feed_trampolines[slot]); break;
+        case FEED_STREAM_PROCESSOR: AttachAudioStreamProcessor(stream, feed_trampolines[slot]); break;
+        case FEED_MIXED_PROCESSOR:  AttachAudioMixedProcessor(feed_trampolines[slot]); break;
+    }
+    return slot;
+}
+
+void detach_stream_feeds(const AudioStream *stream) {
+    for (int i = 0; i < STREAM_FEED_SLOTS; i++) {
+        StreamFeed *feed = &stream_feeds[i];
+        if (feed->fill == NULL) continue;
+        if (stream == NULL || (feed->kind != FEED_MIXED_PROCESSOR && feed->stream.buffer == stream->buffer))
+            detach_feed(i);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// AudioRing ("AudioRing" userdata)
+// ---------------------------------------------------------------------------
+
+#define AUDIO_RING_DEFAULT_FRAMES 8192
+
+typedef struct AudioRing {
+    unsigned char *data;
+    unsigned int capacity;      // frames, a power of two
+    unsigned int frameSize;     // bytes per frame in the stream's format
+    int sampleSize;             // bits per sample: 8 (unsigned), 16 or 32 (float)
+    int channels;
+    int slot;                   // feed slot, -1 once detached
+    atomic_uint head;           // frames ever written; advanced by the script
+    atomic_uint tail;           // frames ever read; advanced by the mixer
+    atomic_uint underruns;      // callbacks that found fewer frames than asked for
+    atomic_uint underrunFrames; // silence frames inserted for them
+    unsigned int overruns;      // pushes that did not fit completely
+    unsigned int overrunFrames; // frames dropped by them
+} AudioRing;
+
+static AudioRing *check_audio_ring(lua_State *L, int idx) {
+    AudioRing *ring = check_udata(L, idx, AudioRing);
+    luaL_argcheck(L, ring->data != NULL, idx, "AudioRing has been released");
+    return ring;
+}
+
+// Consumer side; runs on the mixer thread.
+static void audio_ring_fill(void *ctx, void *buffer, unsigned int frames) {
+    AudioRing *ring = ctx;
+    unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    unsigned int n = head - tail < frames ? head - tail : frames;
+    unsigned int start = tail & (ring->capacity - 1);
+    unsigned int first = ring->capacity - start < n ? ring->capacity - start : n;
+    unsigned char *out = buffer;
+    memcpy(out, ring->data + (size_t)start * ring->frameSize, (size_t)first * ring->frameSize);
+    memcpy(out + (size_t)first * ring->frameSize, ring->data, (size_t)(n - first) * ring->frameSize);
+    atomic_store_explicit(&ring->tail, tail + n, memory_order_release);
+    if (n < frames) {
+        memset(out + (size_t)n * ring->frameSize, ring->sampleSize == 8 ? 0x80 : 0, (size_t)(frames - n) * ring->frameSize);
+        atomic_fetch_add_explicit(&ring->underruns, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&ring->underrunFrames, frames - n, memory_order_relaxed);
+    }
+}
+
+// Producer side: copies up to `frames` frames in and returns how many fit.
+static unsigned int audio_ring_write(AudioRing *ring, const unsigned char *src, unsigned int frames) {
+    unsigned int head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    unsigned int space = ring->capacity - (head - tail);
+    unsigned int n = frames < space ? frames : space;
+    unsigned int start = head & (ring->capacity - 1);
+    unsigned int first = ring->capacity - start < n ? ring->capacity - start : n;
+    memcpy(ring->data + (size_t)start * ring->frameSize, src, (size_t)first * ring->frameSize);
+    memcpy(ring->data, src + (size_t)first * ring->frameSize, (size_t)(n - first) * ring->frameSize);
+    atomic_store_explicit(&ring->head, head + n, memory_order_release);
+    if (n < frames) {
+        ring->overruns++;
+        ring->overrunFrames += frames - n;
+    }
+    return n;
+}
+
+// Converts a normalized sample in [-1, 1] to the stream's sample format.
+static void store_sample(unsigned char *dst, int sampleSize, lua_Number v) {
+    if (v > 1.0) v = 1.0;
+    if (v < -1.0) v = -1.0;
+    if (sampleSize == 8) *dst = (unsigned char)(v * 127.0 + 128.0);
+    else if (sampleSize == 16) { short s = (short)(v * 32767.0); memcpy(dst, &s, sizeof(s)); }
+    else { float f = (float)v; memcpy(dst, &f, sizeof(f)); }
+}
+
+// AudioRing(stream[, frames]): a ring of `frames` frames (rounded up to a
+// power of two) that feeds `stream` from now on.
+static int lua_AudioRing(lua_State *L) {
+    AudioStream *stream = check_udata(L, 1, AudioStream);
+    lua_Integer frames = luaL_optinteger(L, 2, AUDIO_RING_DEFAULT_FRAMES);
+    luaL_argcheck(L, frames > 0 && frames <= (1 << 24), 2, "frames out of range");
+    if (!IsAudioStreamValid(*stream)) return luaL_error(L, "AudioRing: invalid audio stream");
+    int sampleSize = (int)stream->sampleSize, channels = (int)stream->channels;
+    if (sampleSize != 8 && sampleSize != 16 && sampleSize != 32)
+        return luaL_error(L, "AudioRing: unsupported sample size %d", sampleSize);
+
+    unsigned int capacity = 1;
+    while (capacity < (unsigned int)frames) capacity *= 2;
+    AudioRing *ring = lua_newuserdatauv(L, sizeof(AudioRing), 1);
+    memset(ring, 0, sizeof(AudioRing));
+    ring->slot = -1;
+    luaL_setmetatable(L, "AudioRing");
+    ring->capacity = capacity;
+    ring->sampleSize = sampleSize;
+    ring->channels = channels;
+    ring->frameSize = (unsigned int)(sampleSize / 8 * channels);
+    ring->data = malloc((size_t)capacity * ring->frameSize);
+    if (ring->data == NULL) return luaL_error(L, "AudioRing: out of memory allocating %u frames", capacity);
+    lua_pushvalue(L, 1);
+    lua_setiuservalue(L, -2, 1);                     // keeps the stream userdata alive
+    if (attach_feed(FEED_STREAM_CALLBACK, *stream, audio_ring_fill, ring, &ring->slot) < 0)
+        return luaL_error(L, "AudioRing: more than %d streams are fed natively", STREAM_FEED_SLOTS);
+    return 1;
+}
+
+// ring:push(samples[, frames]) -> frames accepted. `samples` is a string of
+// raw PCM in the stream's format, a SampleBuffer in that format, or a Lua
+// array of interleaved samples in [-1, 1]. Frames that do not fit are dropped and counted as an overrun.
+static int audio_ring_push(lua_State *L) {
+    AudioRing *ring = check_audio_ring(L, 1);
+    unsigned int written;
+    if (test_udata(L, 2, SampleBuffer) != NULL) {
+        int frames;
+        const void *pcm = get_sample_data(L, 2, ring->sampleSize, ring->channels, 3, &frames);
+        written = audio_ring_write(ring, pcm, (unsigned int)frames);
+    } else if (lua_type(L, 2) == LUA_TSTRING) {
+        size_t len;
+        const char *bytes = lua_tolstring(L, 2, &len);
+        lua_Integer frames = luaL_optinteger(L, 3, (lua_Integer)(len / ring->frameSize));
+        luaL_argcheck(L, frames >= 0 && (size_t)frames * ring->frameSize <= len, 3, "more frames than the string holds");
+        written = audio_ring_write(ring, (const unsigned char *)bytes, (unsigned int)frames);
+    } else {
+        luaL_checktype(L, 2, LUA_TTABLE);
+        lua_Integer samples = luaL_len(L, 2);
+        lua_Integer frames = luaL_optinteger(L, 3, samples / ring->channels);
+        luaL_argcheck(L, frames >= 0 && frames * ring->channels <= samples, 3, "more frames than the array holds");
+        if (frames > (lua_Integer)ring->capacity) frames = ring->capacity;   // the rest cannot fit anyway
+        unsigned char *pcm = scratch_alloc(L, (size_t)frames * ring->frameSize);
+        int bytesPerSample = ring->sampleSize / 8;
+        for (lua_Integer i = 0; i < frames * ring->channels; i++) {
+            lua_rawgeti(L, 2, i + 1);
+            store_sample(pcm + i * bytesPerSample, ring->sampleSize, luaL_checknumber(L, -1));
+            lua_pop(L, 1);
+        }
+        written = audio_ring_write(ring, pcm, (unsigned int)frames);
+        scratch_pop(L, pcm);
+        lua_Integer requested = luaL_optinteger(L, 3, samples / ring->channels);
+        if (requested > frames) {                    // clipped to the capacity above
+            if (written == (unsigned int)frames) ring->overruns++;
+            ring->overrunFrames += (unsigned int)(requested - frames);
+        }
+    }
+    lua_pushinteger(L, written);
+    return 1;
+}
+
+// ring:space() -> frames that can be pushed without dropping any
+static int audio_ring_space(lua_State *L) {
+    AudioRing *ring = check_audio_ring(L, 1);
+    unsigned int used = atomic_load(&ring->head) - atomic_load(&ring->tail);
+    lua_pushinteger(L, ring->capacity - used);
+    return 1;
+}
+
+// ring:stats() -> {buffered, capacity, underruns, underrunFrames, overruns, overrunFrames, attached}
+static int audio_ring_stats(lua_State *L) {
+    AudioRing *ring = check_audio_ring(L, 1);
+    lua_createtable(L, 0, 7);
+    lua_pushinteger(L, atomic_load(&ring->head) - atomic_load(&ring->tail));
+    lua_setfield(L, -2, "buffered");
+    lua_pushinteger(L, ring->capacity);
+    lua_setfield(L, -2, "capacity");
+    lua_pushinteger(L, atomic_load(&ring->underruns));
+    lua_setfield(L, -2, "underruns");
+    lua_pushinteger(L, atomic_load(&ring->underrunFrames));
+    lua_setfield(L, -2, "underrunFrames");
+    lua_pushinteger(L, ring->overruns);
+    lua_setfield(L, -2, "overruns");
+    lua_pushinteger(L, ring->overrunFrames);
+    lua_setfield(L, -2, "overrunFrames");
+    lua_pushboolean(L, ring->slot >= 0);
+    lua_setfield(L, -2, "attached");
+    return 1;
+}
+
+// ring:detach() — stops feeding the stream; also run by __gc / __close.
+static int audio_ring_detach(lua_State *L) {
+    AudioRing *ring = check_audio_ring(L, 1);
+    if (ring->slot >= 0) detach_feed(ring->slot);
+    return 0;
+}
+
+static int audio_ring_len(lua_State *L) {
+    AudioRing *ring = check_audio_ring(L, 1);
+    lua_pushinteger(L, atomic_load(&ring->head) - atomic_load(&ring->tail));
+    return 1;
+}
+
+static int audio_ring_gc(lua_State *L) {
+    AudioRing *ring = check_udata(L, 1, AudioRing);
+    if (ring->data == NULL) return 0;                // already closed
+    if (ring->slot >= 0) detach_feed(ring->slot);    // before the mixer can see freed data
+    free(ring->data);
+    ring->data = NULL;
+    return 0;
+}
+
+static const luaL_Reg audio_ring_methods[] = {
+    {"push", audio_ring_push}, {"space", audio_ring_space},
+    {"stats", audio_ring_stats}, {"detach", audio_ring_detach},
+    {NULL, NULL}
+};
+
+static const luaL_Reg audio_ring_meta[] = {
+    {"__len", audio_ring_len}, {"__gc", audio_ring_gc}, {"__close", audio_ring_gc},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// AudioGraph ("AudioGraph" userdata)
+// ---------------------------------------------------------------------------
+//
+// A fixed set of DSP nodes run in creation order on stereo float frames, the
+// format raylib mixes in. Node 1 is the incoming audio; every other node sums
+// the outputs of its inputs (all created before it, so the graph is acyclic)
+// and applies its effect, and the output node's frames are written back.
+// Nodes and connections can only change while the graph is detached;
+// parameters are set at any time through a lock-free queue that the mixer
+// drains before each callback.
+
+#define GRAPH_BLOCK 256             // frames processed per pass
+#define GRAPH_MAX_INPUTS 8
+#define GRAPH_MAX_PARAMS 5
+#define GRAPH_QUEUE 256             // pending parameter changes, a power of two
+#define GRAPH_DEFAULT_NODES 32
+
+typedef enum NodeKind {
+    NODE_INPUT, NODE_GAIN, NODE_PAN, NODE_BIQUAD, NODE_DELAY, NODE_COMPRESSOR, NODE_BUS
+} NodeKind;
+
+static const char *const node_kinds[] = {
+    "input", "gain", "pan", "biquad", "delay", "compressor", "bus", NULL
+};
+
+static const char *const node_params[][GRAPH_MAX_PARAMS + 1] = {
+    [NODE_INPUT]      = { NULL },
+    [NODE_GAIN]       = { "gain", NULL },
+    [NODE_PAN]        = { "pan", NULL },
+    [NODE_BIQUAD]     = { "type", "freq", "q", "gain", NULL },
+    [NODE_DELAY]      = { "time", "feedback", "mix", NULL },
+    [NODE_COMPRESSOR] = { "threshold", "ratio", "attack", "release", "makeup", NULL },
+    [NODE_BUS]        = { "gain", NULL },
+};
+
+static const float node_defaults[][GRAPH_MAX_PARAMS] = {
+    [NODE_GAIN]       = { 1.0f },
+    [NODE_PAN]        = { 0.0f },
+    [NODE_BIQUAD]     = { 0.0f, 1000.0f, 0.7071f, 0.0f },
+    [NODE_DELAY]      = { 0.25f, 0.3f, 0.5f },
+    [NODE_COMPRESSOR] = { -12.0f, 4.0f, 0.01f, 0.1f, 0.0f },
+    [NODE_BUS]        = { 1.0f },
+};
+
+typedef enum BiquadType {
+    BIQUAD_LOWPASS, BIQUAD_HIGHPASS, BIQUAD_BANDPASS, BIQUAD_NOTCH, BIQUAD_PEAK, BIQUAD_LOWSHELF, BIQUAD_HIGHSHELF
+} BiquadType;
+
+static const char *const biquad_types[] = {
+    "lowpass", "highpass", "bandpass", "notch", "peak", "lowshelf", "highshelf", NULL
+};
+
+typedef struct GraphNode {
+    NodeKind kind;
+    int inputCount;
+    int inputs[GRAPH_MAX_INPUTS];   // 0-based indices of earlier nodes
+    float params[GRAPH_MAX_PARAMS]; // owned by the mixer while attached
+    float ramp[2];                  // gain / pan currently applied, ramped to the parameter per pass
+    float b0, b1, b2, a1, a2;       // biquad coefficients, normalized by a0
+    float z[2][2];                  // biquad state per channel (transposed direct form II)
+    float *line;                    // delay line, stereo frames
+    float maxTime;                  // what the delay line was sized for, seconds
+    int lineFrames, linePos;
+    float envelope;                 // compressor gain reduction, dB
+    float buf[GRAPH_BLOCK * 2];
+} GraphNode;
+
+typedef struct GraphMessage {
+    unsigned short node;
+    unsigned short param;
+    float value;
+} GraphMessage;
+
+typedef struct AudioGraph {
+    GraphNode *nodes;
+    int count, capacity;
+    int output;                     // 0-based; -1 means the last node
+    float sampleRate;
+    int slot;                       // feed slot, -1 while detached
+    GraphMessage queue[GRAPH_QUEUE];
+    atomic_uint queueHead;          // advanced by the script
+    atomic_uint queueTail;          // advanced by the mixer
+    atomic_uint framesProcessed;
+    atomic_uint messagesApplied;
+    unsigned int messagesDropped;   // set() calls that found the queue full
+} AudioGraph;
+
+static AudioGraph *check_audio_graph(lua_State *L, int idx) {
+    AudioGraph *g = check_udata(L, idx, AudioGraph);
+    luaL_argcheck(L, g->nodes != NULL, idx, "AudioGraph has been released");
+    return g;
+}
+
+// raylib does not expose the device rate, but a sound is always resampled to
+// it, so one probe sound is loaded the first time the rate is needed after
+// InitAudioDevice. CloseAudioDevice forgets it (reset_device_sample_rate).
+static float device_rate;
+
+static float device_sample_rate(void) {
+    if (!IsAudioDeviceReady()) return 48000.0f;
+    if (device_rate > 0.0f) return device_rate;
+    short silence = 0;
+    Wave wave = { 1, 48000, 16, 1, &silence };
+    Sound probe = LoadSoundFromWave(wave);
+    device_rate = probe.stream.sampleRate > 0 ? (float)probe.stream.sampleRate : 48000.0f;
+    UnloadSound(probe);
+    return device_rate;
+}
+
+void reset_device_sample_rate(void) {
+    device_rate = 0.0f;
+}
+
+static void update_biquad(GraphNode *n, float sampleRate) {
+    float freq = n->params[1], q = n->params[2] > 0.01f ? n->params[2] : 0.01f;
+    if (freq < 1.0f) freq = 1.0f;
+    if (freq > sampleRate * 0.49f) freq = sampleRate * 0.49f;
+    float w0 = 2.0f * PI * freq / sampleRate, cw = cosf(w0), alpha = sinf(w0) / (2.0f * q);
+    float A = powf(10.0f, n->params[3] / 40.0f), sq = 2.0f * sqrtf(A) * alpha;
+    float b0, b1, b2, a0, a1, a2;
+    switch ((BiquadType)(int)n->params[0]) {
+        default:
+        case BIQUAD_LOWPASS:  b0 = (1 - cw) / 2; b1 = 1 - cw;    b2 = b0; a0 = 1 + alpha; a1 = -2 * cw; a2 = 1 - alpha; break;
+        case BIQUAD_HIGHPASS: b0 = (1 + cw) / 2; b1 = -(1 + cw); b2 = b0; a0 = 1 + alpha; a1 = -2 * cw; a2 = 1 - alpha; break;
+        case BIQUAD_BANDPASS: b0 = alpha;        b1 = 0;         b2 = -alpha; a0 = 1 + alpha; a1 = -2 * cw; a2 = 1 - alpha; break;
+        case BIQUAD_NOTCH:    b0 = 1;            b1 = -2 * cw;   b2 = 1;  a0 = 1 + alpha; a1 = -2 * cw; a2 = 1 - alpha; break;
+        case BIQUAD_PEAK:
+            b0 = 1 + alpha * A; b1 = -2 * cw; b2 = 1 - alpha * A;
+            a0 = 1 + alpha / A; a1 = -2 * cw; a2 = 1 - alpha / A;
+            break;
+        case BIQUAD_LOWSHELF:
+            b0 = A * ((A + 1) - (A - 1) * cw + sq); b1 = 2 * A * ((A - 1) - (A + 1) * cw); b2 = A * ((A + 1) - (A - 1) * cw - sq);
+            a0 = (A + 1) + (A - 1) * cw + sq;       a1 = -2 * ((A - 1) + (A + 1) * cw);    a2 = (A + 1) + (A - 1) * cw - sq;
+            break;
+        case BIQUAD_HIGHSHELF:
+            b0 = A * ((A + 1) + (A - 1) * cw + sq); b1 = -2 * A * ((A - 1) + (A + 1) * cw); b2 = A * ((A + 1) + (A - 1) * cw - sq);
+            a0 = (A + 1) - (A - 1) * cw + sq;       a1 = 2 * ((A - 1) - (A + 1) * cw);      a2 = (A + 1) - (A - 1) * cw - sq;
+            break;
+    }
+    n->b0 = b0 / a0; n->b1 = b1 / a0; n->b2 = b2 / a0; n->a1 = a1 / a0; n->a2 = a2 / a0;
+}
+
+// Stores a parameter and derives whatever depends on it. Runs on the mixer
+// while the graph is attached, on the main thread otherwise.
+static void apply_param(AudioGraph *g, int node, int param, float value) {
+    GraphNode *n = &g->nodes[node];
+    n->params[param] = value;
+    if (n->kind == NODE_BIQUAD) update_biquad(n, g->sampleRate);
+}
+
+static void drain_messages(AudioGraph *g) {
+    unsigned int tail = atomic_load_explicit(&g->queueTail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&g->queueHead, memory_order_acquire);
+    if (tail == head) return;
+    for (unsigned int i = tail; i != head; i++) {
+        GraphMessage *m = &g->queue[i & (GRAPH_QUEUE - 1)];
+        apply_param(g, m->node, m->param, m->value);
+    }
+    atomic_store_explicit(&g->queueTail, head, memory_order_release);
+    atomic_fetch_add_explicit(&g->messagesApplied, head - tail, memory_order_relaxed);
+}
+
+static void run_node(AudioGraph *g, GraphNode *n, int frames) {
+    float *buf = n->buf;
+    switch (n->kind) {
+        case NODE_GAIN:
+        case NODE_BUS: {
+            float from = n->ramp[0], step = (n->params[0] - from) / frames;
+            for (int i = 0; i < frames; i++) {
+                float k = from + step * (i + 1);
+                buf[2 * i] *= k;
+                buf[2 * i + 1] *= k;
+            }
+            n->ramp[0] = n->params[0];
+            break;
+        }
+        case NODE_PAN: {
+            // Balance: -1 keeps only the left channel, 1 only the right.
+            float from = n->ramp[0], step = (n->params[0] - from) / frames;
+            for (int i = 0; i < frames; i++) {
+                float p = from + step * (i + 1);
+                if (p < -1.0f) p = -1.0f;
+                if (p > 1.0f) p = 1.0f;
+                buf[2 * i] *= p > 0.0f ? 1.0f - p : 1.0f;
+                buf[2 * i + 1] *= p < 0.0f ? 1.0f + p : 1.0f;
+            }
+            n->ramp[0] = n->params[0];
+            break;
+        }
+        case NODE_BIQUAD:
+            for (int c = 0; c < 2; c++) {
+                float z1 = n->z[c][0], z2 = n->z[c][1];
+                for (int i = 0; i < frames; i++) {
+                    float x = buf[2 * i + c], y = n->b0 * x + z1;
+                    z1 = n->b1 * x - n->a1 * y + z2;
+                    z2 = n->b2 * x - n->a2 * y;
+                    buf[2 * i + c] = y;
+                }
+                n->z[c][0] = z1;
+                n->z[c][1] = z2;
+            }
+            break;
+        case NODE_DELAY: {
+            int delay = (int)(n->params[0] * g->sampleRate + 0.5f);
+            if (delay < 1) delay = 1;
+            if (delay > n->lineFrames - 1) delay = n->lineFrames - 1;
+            float feedback = n->params[1], mix = n->params[2];
+            for (int i = 0; i < frames; i++) {
+                int read = n->linePos - delay;
+                if (read < 0) read += n->lineFrames;
+                for (int c = 0; c < 2; c++) {
+                    float x = buf[2 * i + c], d = n->line[2 * read + c];
+                    n->line[2 * n->linePos + c] = x + d * feedback;
+                    buf[2 * i + c] = x * (1.0f - mix) + d * mix;
+                }
+                if (++n->linePos == n->lineFrames) n->linePos = 0;
+            }
+            break;
+        }
+        case NODE_COMPRESSOR: {
+            float threshold = n->params[0], slope = 1.0f - 1.0f / (n->params[1] > 1.0f ? n->params[1] : 1.0f);
+            float attack = n->params[2] > 0.0f ? expf(-1.0f / (n->params[2] * g->sampleRate)) : 0.0f;
+            float release = n->params[3] > 0.0f ? expf(-1.0f / (n->params[3] * g->sampleRate)) : 0.0f;
+            float makeup = n->params[4], env = n->envelope;
+            for (int i = 0; i < frames; i++) {
+                float peak = fmaxf(fabsf(buf[2 * i]), fabsf(buf[2 * i + 1]));
+                float over = 20.0f * log10f(peak + 1e-9f) - threshold;
+                float target = over > 0.0f ? over * slope : 0.0f;
+                float coef = target > env ? attack : release;
+                env = target + (env - target) * coef;
+                float k = powf(10.0f, (makeup - env) / 20.0f);
+                buf[2 * i] *= k;
+                buf[2 * i + 1] *= k;
+            }
+            n->envelope = env;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Runs every node over `frames` (<= GRAPH_BLOCK) stereo frames of `io` in place.
+static void run_graph(AudioGraph *g, float *io, int frames) {
+    size_t bytes = (size_t)frames * 2 * sizeof(float);
+    for (int i = 0; i < g->count; i++) {
+        GraphNode *n = &g->nodes[i];
+        if (n->kind == NODE_INPUT) {
+            memcpy(n->buf, io, bytes);
+            continue;
+        }
+        if (n->inputCount == 0) memset(n->buf, 0, bytes);
+        else memcpy(n->buf, g->nodes[n->inputs[0]].buf, bytes);
+        for (int k = 1; k < n->inputCount; k++) {
+            const float *in = g->nodes[n->inputs[k]].buf;
+            for (int s = 0; s < frames * 2; s++) n->buf[s] += in[s];
+        }
+        run_node(g, n, frames);
+    }
+    memcpy(io, g->nodes[g->output >= 0 ? g->output : g->count - 1].buf, bytes);
+}
+
+// Mixer-side entry point (a stream or mixed processor).
+static void audio_graph_process(void *ctx, void *buffer, unsigned int frames) {
+    AudioGraph *g = ctx;
+    drain_messages(g);
+    float *io = buffer;
+    for (unsigned int done = 0; done < frames; done += GRAPH_BLOCK) {
+        int n = frames - done < GRAPH_BLOCK ? (int)(frames - done) : GRAPH_BLOCK;
+        run_graph(g, io + (size_t)done * 2, n);
+    }
+    atomic_fetch_add_explicit(&g->framesProcessed, frames, memory_order_relaxed);
+}
+
+static int check_node(lua_State *L, AudioGraph *g, int idx) {
+    lua_Integer id = luaL_checkinteger(L, idx);
+    luaL_argcheck(L, id >= 1 && id <= g->count, idx, "no such node");
+    return (int)id - 1;
+}
+
+static void check_detached(lua_State *L, AudioGraph *g) {
+    if (g->slot >= 0) luaL_error(L, "AudioGraph: detach the graph before changing its nodes");
+}
+
+// Reads the value of parameter `param` of node `n` at `idx` (biquad types by name).
+static float check_param_value(lua_State *L, NodeKind kind, int param, int idx) {
+    if (kind == NODE_BIQUAD && param == 0) return (float)luaL_checkoption(L, idx, NULL, biquad_types);
+    return (float)luaL_checknumber(L, idx);
+}
+
+static void connect_nodes(lua_State *L, AudioGraph *g, int from, int to) {
+    GraphNode *n = &g->nodes[to];
+    if (from >= to) luaL_error(L, "AudioGraph: node %d can only take input from an earlier node", to + 1);
+    for (int k = 0; k < n->inputCount; k++)
+        if (n->inputs[k] == from) return;
+    if (n->inputCount == GRAPH_MAX_INPUTS) luaL_error(L, "AudioGraph: node %d has %d inputs already", to + 1, GRAPH_MAX_INPUTS);
+    n->inputs[n->inputCount++] = from;
+}
+
+// AudioGraph([maxNodes]) -> graph holding only the input node (1)
+static int lua_AudioGraph(lua_State *L) {
+    lua_Integer capacity = luaL_optinteger(L, 1, GRAPH_DEFAULT_NODES);
+    luaL_argcheck(L, capacity >= 2 && capacity <= 1024, 1, "node count out of range");
+    AudioGraph *g = lua_newuserdatauv(L, sizeof(AudioGraph), 1);
+    memset(g, 0, sizeof(AudioGraph));
+    g->slot = -1;
+    g->output = -1;
+    luaL_setmetatable(L, "AudioGraph");
+    g->nodes = calloc((size_t)capacity, sizeof(GraphNode));
+    if (g->nodes == NULL) return luaL_error(L, "AudioGraph: out of memory allocating %d nodes", (int)capacity);
+    g->capacity = (int)capacity;
+    g->count = 1;
+    g->nodes[0].kind = NODE_INPUT;
+    g->sampleRate = device_sample_rate();
+    return 1;
+}
+
+// graph:add(kind[, params[, input, ...]]) -> node id. Without inputs the node
+// takes the previous node's output, so successive adds form a chain. A delay
+// also accepts `maxTime` (seconds, default 1) in `params`.
+static int audio_graph_add(lua_State *L) {
+    AudioGraph *g = check_audio_graph(L, 1);
+    NodeKind kind = (NodeKind)luaL_checkoption(L, 2, NULL, node_kinds);
+    luaL_argcheck(L, kind != NODE_INPUT, 2, "the graph has one input node");
+    if (!lua_isnoneornil(L, 3)) luaL_checktype(L, 3, LUA_TTABLE);
+    check_detached(L, g);
+    if (g->count == g->capacity) return luaL_error(L, "AudioGraph: all %d nodes are in use", g->capacity);
+
+    // Everything that can raise an error is read before the node is added.
+    int id = g->count, inputCount = lua_gettop(L) > 3 ? lua_gettop(L) - 3 : 1;
+    int inputs[GRAPH_MAX_INPUTS] = { id - 1 };
+    if (inputCount > GRAPH_MAX_INPUTS) return luaL_error(L, "AudioGraph: a node takes at most %d inputs", GRAPH_MAX_INPUTS);
+    for (int i = 4; i <= lua_gettop(L); i++) inputs[i - 4] = check_node(L, g, i);
+    float params[GRAPH_MAX_PARAMS], maxTime = 1.0f;
+    memcpy(params, node_defaults[kind], sizeof(params));
+    if (lua_istable(L, 3)) {
+        for (int p = 0; node_params[kind][p] != NULL; p++) {
+            if (lua_getfield(L, 3, node_params[kind][p]) != LUA_TNIL)
+                params[p] = check_param_value(L, kind, p, lua_gettop(L));
+            lua_pop(L, 1);
+        }
+        if (kind == NODE_DELAY && lua_getfield(L, 3, "maxTime") != LUA_TNIL) maxTime = (float)luaL_checknumber(L, -1);
+    }
+    if (!(maxTime > 0.0f && maxTime <= 60.0f)) return luaL_error(L, "AudioGraph: delay maxTime out of range");
+
+    GraphNode *n = &g->nodes[id];
+    memset(n, 0, sizeof(GraphNode));
+    if (kind == NODE_DELAY) {
+        n->maxTime = maxTime;
+        n->lineFrames = (int)(maxTime * g->sampleRate) + 1;
+        n->line = calloc((size_t)n->lineFrames * 2, sizeof(float));
+        if (n->line == NULL) return luaL_error(L, "AudioGraph: out of memory allocating a delay line");
+    }
+    n->kind = kind;
+    memcpy(n->params, params, sizeof(params));
+    n->ramp[0] = params[0];
+    if (kind == NODE_BIQUAD) update_biquad(n, g->sampleRate);
+    for (int i = 0; i < inputCount; i++) {
+        int dup = 0;
+        for (int k = 0; k < n->inputCount; k++) dup |= n->inputs[k] == inputs[i];
+        if (!dup) n->inputs[n->inputCount++] = inputs[i];
+    }
+    g->count++;
+    lua_pushinteger(L, id + 1);
+    return 1;
+}
+
+// graph:connect(from, to) — adds `from`'s output to `to`'s inputs
+static int audio_graph_connect(lua_State *L) {
+    AudioGraph *g = check_audio_graph(L, 1);
+    int from = check_node(L, g, 2), to = check_node(L, g, 3);
+    check_detached(L, g);
+    connect_nodes(L, g, from, to);
+    return 0;
+}
+
+// graph:setOutput(node) — the node whose frames are written back (default: the last one)
+static int audio_graph_set_output(lua_State *L) {
+    AudioGraph *g = check_audio_graph(L, 1);
+    int node = check_node(L, g, 2);
+    check_detached(L, g);
+    g->output = node;
+    return 0;
+}
+
+// graph:set(node, param, value) -> queued. While attached the change reaches
+// the mixer through the queue; false means it was full and the change dropped.
+static int audio_graph_set(lua_State *L) {
+    AudioGraph *g = check_audio_graph(L, 1);
+    int node = check_node(L, g, 2);
+    GraphNode *n = &g->nodes[node];
+    int param = luaL_checkoption(L, 3, NULL, node_params[n->kind]);
+    float value = check_param_value(L, n->kind, param, 4);
+    if (g->slot < 0) {
+        apply_param(g, node, param, value);
+        lua_pushboolean(L, 1);
+        return 1;
+    }
+    unsigned int head = atomic_load_explicit(&g->queueHead, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&g->queueTail, memory_order_acquire);
+    if (head - tail == GRAPH_QUEUE) {
+        g->messagesDropped++;
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    g->queue[head & (GRAPH_QUEUE - 1)] = (GraphMessage){ (unsigned short)node, (unsigned short)param, value };
+    atomic_store_explicit(&g->queueHead, head + 1, memory_order_release);
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+static void graph_detach(AudioGraph *g) {
+    if (g->slot >= 0) detach_feed(g->slot);
+    drain_messages(g);                               // nothing consumes the queue any more
+}
+
+// Moves a detached graph to `sampleRate`: biquad coefficients are derived
+// again and delay lines resized (and cleared) for their maxTime.
+static void retune_graph(lua_State *L, AudioGraph *g, float sampleRate) {
+    if (sampleRate == g->sampleRate) return;
+    for (int i = 0; i < g->count; i++) {
+        GraphNode *n = &g->nodes[i];
+        if (n->kind != NODE_DELAY) continue;
+        int lineFrames = (int)(n->maxTime * sampleRate) + 1;
+        float *line = calloc((size_t)lineFrames * 2, sizeof(float));
+        if (line == NULL) luaL_error(L, "AudioGraph: out of memory allocating a delay line");
+        free(n->line);
+        n->line = line;
+        n->lineFrames = lineFrames;
+        n->linePos = 0;
+    }
+    g->sampleRate = sampleRate;
+    for (int i = 0; i < g->count; i++)
+        if (g->nodes[i].kind == NODE_BIQUAD) update_biquad(&g->nodes[i], sampleRate);
+}
+
+// graph:attach([target]) — processes `target` (an AudioStream, Sound or Music),
+// or raylib's final mix when omitted. Replaces any previous attachment. The
+// graph is retuned to the device rate, which may differ from the one it was
+// built at (48000 before InitAudioDevice).
+static int audio_graph_attach(lua_State *L) {
+    AudioGraph *g = check_audio_graph(L, 1);
+    FeedKind kind = FEED_MIXED_PROCESSOR;
+    AudioStream stream = { 0 };
+    if (!lua_isnoneornil(L, 2)) {
+        AudioStream *s = test_udata(L, 2, AudioStream);
+        Sound *sound = s == NULL ? test_udata(L, 2, Sound) : NULL;
+        Music *music = s == NULL && sound == NULL ? test_udata(L, 2, Music) : NULL;
+        if (s != NULL) stream = *s;
+        else if (sound != NULL) stream = sound->stream;
+        else if (music != NULL) stream = music->stream;
+        else return luaL_typeerror(L, 2, "AudioStream, Sound or Music");
+        if (!IsAudioStreamValid(stream)) return luaL_error(L, "AudioGraph: invalid audio stream");
+        kind = FEED_STREAM_PROCESSOR;
+    } else if (!IsAudioDeviceReady()) {
+        return luaL_error(L, "AudioGraph: audio device is not initialized");
+    }
+    graph_detach(g);
+    retune_graph(L, g, device_sample_rate());
+    lua_pushvalue(L, 2);
+    lua_setiuservalue(L, 1, 1);                      // keeps the target alive while attached
+    if (attach_feed(kind, stream, audio_graph_process, g, &g->slot) < 0)
+        return luaL_error(L, "AudioGraph: more than %d streams are fed natively", STREAM_FEED_SLOTS);
+    return 0;
+}
+
+// graph:detach() — also run by __gc / __close
+static int audio_graph_detach(lua_State *L) {
+    AudioGraph *g = check_audio_graph(L, 1);
+    graph_detach(g);
+    lua_pushnil(L);
+    lua_setiuservalue(L, 1, 1);
+    return 0;
+}
+
+// graph:process(samples) -> processed samples. Runs the detached graph on the
+// calling thread over interleaved stereo frames given as a Lua array of
+// numbers (returns a new array) or a string of native float32 (returns a string).
+static int audio_graph_process_lua(lua_State *L) {
+    AudioGraph *g = check_audio_graph(L, 1);
+    if (g->slot >= 0) return luaL_error(L, "AudioGraph: cannot process offline while attached");
+    int isString = lua_type(L, 2) == LUA_TSTRING;
+    size_t samples;
+    float *pcm;
+    if (isString) {
+        const char *bytes = lua_tolstring(L, 2, &samples);
+        samples /= sizeof(float);
+        pcm = scratch_alloc(L, (samples | 1) * sizeof(float));
+        memcpy(pcm, bytes, samples * sizeof(float));
+    } else {
+        luaL_checktype(L, 2, LUA_TTABLE);
+        samples = (size_t)luaL_len(L, 2);
+        pcm = scratch_alloc(L, (samples | 1) * sizeof(float));
+        for (size_t i = 0; i < samples; i++) {
+            lua_rawgeti(L, 2, (lua_Integer)i + 1);
+            pcm[i] = (float)luaL_checknumber(L, -1);
+            lua_pop(L, 1);
+        }
+    }
+    luaL_argcheck(L, samples % 2 == 0, 2, "expected whole stereo frames");
+    audio_graph_process(g, pcm, (unsigned int)(samples / 2));
+    if (isString) {
+        lua_pushlstring(L, (const char *)pcm, samples * sizeof(float));
+    } else {
+        lua_createtable(L, (int)samples, 0);
+        for (size_t i = 0; i < samples; i++) {
+            lua_pushnumber(L, pcm[i]);
+            lua_rawseti(L, -2, (lua_Integer)i + 1);
+        }
+    }
+    scratch_pop(L, pcm);
+    return 1;
+}
+
+// graph:stats() -> {nodes, sampleRate, attached, framesProcessed, messagesApplied, messagesQueued, messagesDropped}
+static int audio_graph_stats(lua_State *L) {
+    AudioGraph *g = check_audio_graph(L, 1);
+    lua_createtable(L, 0, 7);
+    lua_pushinteger(L, g->count);
+    lua_setfield(L, -2, "nodes");
+    lua_pushnumber(L, g->sampleRate);
+    lua_setfield(L, -2, "sampleRate");
+    lua_pushboolean(L, g->slot >= 0);
+    lua_setfield(L, -2, "attached");
+    lua_pushinteger(L, atomic_load(&g->framesProcessed));
+    lua_setfield(L, -2, "framesProcessed");
+    lua_pushinteger(L, atomic_load(&g->messagesApplied));
+    lua_setfield(L, -2, "messagesApplied");
+    lua_pushinteger(L, atomic_load(&g->queueHead) - atomic_load(&g->queueTail));
+    lua_setfield(L, -2, "messagesQueued");
+    lua_pushinteger(L, g->messagesDropped);
+    lua_setfield(L, -2, "messagesDropped");
+    return 1;
+}
+
+static int audio_graph_len(lua_State *L) {
+    lua_pushinteger(L, check_audio_graph(L, 1)->count);
+    return 1;
+}
+
+static int audio_graph_gc(lua_State *L) {
+    AudioGraph *g = check_udata(L, 1, AudioGraph);
+    if (g->slot >= 0) detach_feed(g->slot);
+    if (g->nodes != NULL) {
+        for (int i = 0; i < g->count; i++) free(g->nodes[i].line);
+        free(g->nodes);
+        g->nodes = NULL;
+        g->count = 0;
+    }
+    return 0;
+}
+
+static const luaL_Reg audio_graph_methods[] = {
+    {"add", audio_graph_add}, {"connect", audio_graph_connect}, {"setOutput", audio_graph_set_output},
+    {"set", audio_graph_set}, {"attach", audio_graph_attach}, {"detach", audio_graph_detach},
+    {"process", audio_graph_process_lua}, {"stats", audio_graph_stats},
+    {NULL, NULL}
+};
+
+static const luaL_Reg audio_graph_meta[] = {
+    {"__len", audio_graph_len}, {"__gc", audio_graph_gc}, {"__close", audio_graph_gc},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// Synth ("Synth" userdata)
+// ---------------------------------------------------------------------------
+//
+// Polyphonic oscillator voices with an ADSR envelope, rendered straight into
+// an AudioStream's buffer by its callback. The script only sends note and
+// parameter events; they reach the mixer through a lock-free queue drained
+// before each callback. Voices are allocated on the mixer: a retriggered note
+// reuses its voice, then a free one is taken, then the quietest releasing
+// voice, then the oldest.
+
+#define SYNTH_BLOCK 256
+#define SYNTH_QUEUE 256             // pending events, a power of two
+#define SYNTH_DEFAULT_VOICES 8
+
+typedef enum SynthWave { WAVE_SINE, WAVE_SQUARE, WAVE_SAW, WAVE_NOISE } SynthWave;
+
+static const char *const synth_waves[] = { "sine", "square", "saw", "noise", NULL };
+
+typedef enum SynthParam { SYNTH_WAVE, SYNTH_ATTACK, SYNTH_DECAY, SYNTH_SUSTAIN, SYNTH_RELEASE, SYNTH_VOLUME } SynthParam;
+
+static const char *const synth_params[] = { "wave", "attack", "decay", "sustain", "release", "volume", NULL };
+
+typedef enum EnvelopeStage { STAGE_IDLE, STAGE_ATTACK, STAGE_DECAY, STAGE_SUSTAIN, STAGE_RELEASE } EnvelopeStage;
+
+typedef enum SynthEventType { EVENT_NOTE_ON, EVENT_NOTE_OFF, EVENT_ALL_OFF, EVENT_PARAM } SynthEventType;
+
+typedef struct SynthEvent {
+    unsigned char type;
+    unsigned char wave;             // EVENT_NOTE_ON
+    unsigned short param;           // EVENT_PARAM
+    float a;                        // note, or the parameter value
+    float b;                        // velocity
+} SynthEvent;
+
+typedef struct SynthVoice {
+    EnvelopeStage stage;
+    SynthWave wave;
+    float note;
+    float phase, step;              // cycles, cycles per frame
+    float level, velocity;
+    float releaseStep;
+    unsigned int age;               // note-on order, for stealing the oldest
+} SynthVoice;
+
+typedef struct Synth {
+    SynthVoice *voices;
+    int voiceCount;
+    float params[6];                // indexed by SynthParam; owned by the mixer while attached
+    SynthWave wave;                 // noteOn default, main thread only (params[SYNTH_WAVE] is unused)
+    float sampleRate;
+    unsigned int noise;             // xorshift state
+    unsigned int clock;             // note-ons so far
+    int slot;                       // feed slot, -1 while detached
+    int sampleSize, channels;       // of the attached stream
+    SynthEvent queue[SYNTH_QUEUE];
+    atomic_uint queueHead;          // advanced by the script
+    atomic_uint queueTail;          // advanced by the mixer
+    atomic_int activeVoices;
+    atomic_uint framesRendered;
+    atomic_uint eventsApplied;
+    unsigned int eventsDropped;     // events that found the queue full
+} Synth;
+
+static Synth *check_synth(lua_State *L, int idx) {
+    Synth *s = check_udata(L, idx, Synth);
+    luaL_argcheck(L, s->voices != NULL, idx, "Synth has been released");
+    return s;
+}
+
+static SynthVoice *allocate_voice(Synth *s, float note) {
+    SynthVoice *best = NULL;
+    for (int i = 0; i < s->voiceCount; i++) {
+        SynthVoice *v = &s->voices[i];
+        if (v->stage != STAGE_IDLE && v->note == note) return v;
+    }
+    for (int i = 0; i < s->voiceCount; i++)
+        if (s->voices[i].stage == STAGE_IDLE) return &s->voices[i];
+    for (int i = 0; i < s->voiceCount; i++) {
+        SynthVoice *v = &s->voices[i];
+        if (v->stage == STAGE_RELEASE && (best == NULL || v->level < best->level)) best = v;
+    }
+    if (best != NULL) return best;
+    best = &s->voices[0];
+    for (int i = 1; i < s->voiceCount; i++)
+        if (s->voices[i].age < best->age) best = &s->voices[i];
+    return best;
+}
+
+static void release_voice(Synth *s, SynthVoice *v) {
+    float frames = s->params[SYNTH_RELEASE] * s->sampleRate;
+    v->stage = STAGE_RELEASE;
+    v->releaseStep = v->level / (frames > 1.0f ? frames : 1.0f);
+}
+
+// Runs on the mixer while the synth is attached, on the main thread otherwise.
+static void apply_event(Synth *s, const SynthEvent *e) {
+    switch ((SynthEventType)e->type) {
+        case EVENT_NOTE_ON: {
+            SynthVoice *v = allocate_voice(s, e->a);
+            if (v->stage == STAGE_IDLE || v->note != e->a) { v->phase = 0.0f; v->level = 0.0f; }
+            v->stage = STAGE_ATTACK;
+            v->wave = (SynthWave)e->wave;
+            v->note = e->a;
+            v->step = 440.0f * powf(2.0f, (e->a - 69.0f) / 12.0f) / s->sampleRate;
+            v->velocity = e->b;
+            v->age = ++s->clock;
+            break;
+        }
+        case EVENT_NOTE_OFF:
+            for (int i = 0; i < s->voiceCount; i++) {
+                SynthVoice *v = &s->voices[i];
+                if (v->stage != STAGE_IDLE && v->stage != STAGE_RELEASE && v->note == e->a) release_voice(s, v);
+            }
+            break;
+        case EVENT_ALL_OFF:
+            for (int i = 0; i < s->voiceCount; i++)
+                if (s->voices[i].stage != STAGE_IDLE && s->voices[i].stage != STAGE_RELEASE) release_voice(s, &s->voices[i]);
+            break;
+        case EVENT_PARAM:
+            s->params[e->param] = e->a;
+            break;
+    }
+}
+
+static void drain_events(Synth *s) {
+    unsigned int tail = atomic_load_explicit(&s->queueTail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&s->queueHead, memory_order_acquire);
+    if (tail == head) return;
+    for (unsigned int i = tail; i != head; i++) apply_event(s, &s->queue[i & (SYNTH_QUEUE - 1)]);
+    atomic_store_explicit(&s->queueTail, head, memory_order_release);
+    atomic_fetch_add_explicit(&s->eventsApplied, head - tail, memory_order_relaxed);
+}
+
+// Smooths the discontinuity of a naive square / saw at phase t (polyBLEP).
+static float poly_blep(float t, float dt) {
+    if (t < dt) { t /= dt; return t + t - t * t - 1.0f; }
+    if (t > 1.0f - dt) { t = (t - 1.0f) / dt; return t * t + t + t + 1.0f; }
+    return 0.0f;
+}
+
+static float oscillator(Synth *s, SynthVoice *v) {
+    float t = v->phase, dt = v->step;
+    switch (v->wave) {
+        case WAVE_SQUARE: {
+            float t2 = t + 0.5f >= 1.0f ? t - 0.5f : t + 0.5f;
+            return (t < 0.5f ? 1.0f : -1.0f) + poly_blep(t, dt) - poly_blep(t2, dt);
+        }
+        case WAVE_SAW:
+            return 2.0f * t - 1.0f - poly_blep(t, dt);
+        case WAVE_NOISE:
+            s->noise ^= s->noise << 13;
+            s->noise ^= s->noise >> 17;
+            s->noise ^= s->noise << 5;
+            return (float)s->noise / 2147483648.0f - 1.0f;
+        case WAVE_SINE:
+        default:
+            return sinf(2.0f * PI * t);
+    }
+}
+
+// Adds one block of voice `v` into `mix`.
+static void render_voice(Synth *s, SynthVoice *v, float *mix, int frames) {
+    float attack = s->params[SYNTH_ATTACK] * s->sampleRate, decay = s->params[SYNTH_DECAY] * s->sampleRate;
+    float sustain = s->params[SYNTH_SUSTAIN];
+    float attackStep = 1.0f / (attack > 1.0f ? attack : 1.0f);
+    float decayStep = (1.0f - sustain) / (decay > 1.0f ? decay : 1.0f);
+    for (int i = 0; i < frames && v->stage != STAGE_IDLE; i++) {
+        switch (v->stage) {
+            case STAGE_ATTACK:
+                v->level += attackStep;
+                if (v->level >= 1.0f) { v->level = 1.0f; v->stage = STAGE_DECAY; }
+                break;
+            case STAGE_DECAY:
+                v->level -= decayStep;
+                if (v->level <= sustain) { v->level = sustain; v->stage = STAGE_SUSTAIN; }
+                break;
+            case STAGE_SUSTAIN:
+                v->level = sustain;
+                break;
+            case STAGE_RELEASE:
+                v->level -= v->releaseStep;
+                if (v->level <= 0.0f) { v->level = 0.0f; v->stage = STAGE_IDLE; }
+                break;
+            default:
+                break;
+        }
+        mix[i] += oscillator(s, v) * v->level * v->velocity;
+        v->phase += v->step;
+        if (v->phase >= 1.0f) v->phase -= 1.0f;
+    }
+}
+
+// Renders `frames` frames of `channels` interleaved samples of `sampleSize`
+// bits into `out`; every channel gets the same mono mix.
+static void synth_render(Synth *s, unsigned char *out, unsigned int frames, int sampleSize, int channels) {
+    float mix[SYNTH_BLOCK];
+    size_t bytesPerSample = (size_t)sampleSize / 8;
+    drain_events(s);
+    for (unsigned int done = 0; done < frames; done += SYNTH_BLOCK) {
+        int n = frames - done < SYNTH_BLOCK ? (int)(frames - done) : SYNTH_BLOCK;
+        memset(mix, 0, sizeof(float) * n);
+        for (int i = 0; i < s->voiceCount; i++)
+            if (s->voices[i].stage != STAGE_IDLE) render_voice(s, &s->voices[i], mix, n);
+        for (int i = 0; i < n; i++) {
+            float v = mix[i] * s->params[SYNTH_VOLUME];
+            for (int c = 0; c < channels; c++, out += bytesPerSample) store_sample(out, sampleSize, v);
+        }
+    }
+    int active = 0;
+    for (int i = 0; i < s->voiceCount; i++) active += s->voices[i].stage != STAGE_IDLE;
+    atomic_store_explicit(&s->activeVoices, active, memory_order_relaxed);
+    atomic_fetch_add_explicit(&s->framesRendered, frames, memory_order_relaxed);
+}
+
+static void synth_fill(void *ctx, void *buffer, unsigned int frames) {
+    Synth *s = ctx;
+    synth_render(s, buffer, frames, s->sampleSize, s->channels);
+}
+
+// Applies `e` directly while detached, or queues it for the mixer. Returns
+// false if the queue was full and the event dropped.
+static int send_event(Synth *s, SynthEvent e) {
+    if (s->slot < 0) {
+        apply_event(s, &e);
+        return 1;
+    }
+    unsigned int head = atomic_load_explicit(&s->queueHead, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&s->queueTail, memory_order_acquire);
+    if (head - tail == SYNTH_QUEUE) {
+        s->eventsDropped++;
+        return 0;
+    }
+    s->queue[head & (SYNTH_QUEUE - 1)] = e;
+    atomic_store_explicit(&s->queueHead, head + 1, memory_order_release);
+    return 1;
+}
+
+// Synth([voices[, sampleRate]]) -> detached synth; attach() adopts the
+// stream's sample rate.
+static int lua_Synth(lua_State *L) {
+    lua_Integer voices = luaL_optinteger(L, 1, SYNTH_DEFAULT_VOICES);
+    lua_Number sampleRate = luaL_optnumber(L, 2, 48000);
+    luaL_argcheck(L, voices >= 1 && voices <= 256, 1, "voice count out of range");
+    luaL_argcheck(L, sampleRate > 0, 2, "sampleRate must be positive");
+    Synth *s = lua_newuserdatauv(L, sizeof(Synth), 1);
+    memset(s, 0, sizeof(Synth));
+    s->slot = -1;
+    luaL_setmetatable(L, "Synth");
+    s->voices = calloc((size_t)voices, sizeof(SynthVoice));
+    if (s->voices == NULL) return luaL_error(L, "Synth: out of memory allocating %d voices", (int)voices);
+    s->voiceCount = (int)voices;
+    s->sampleRate = (float)sampleRate;
+    s->noise = 0x9E3779B9u;
+    const float defaults[] = { 0.0f, 0.01f, 0.1f, 0.7f, 0.2f, 0.5f };
+    memcpy(s->params, defaults, sizeof(defaults));
+    return 1;
+}
+
+static float check_note(lua_State *L, int idx) {
+    lua_Number note = luaL_checknumber(L, idx);
+    luaL_argcheck(L, note >= 0 && note <= 127, idx, "note out of range");
+    return (float)note;
+}
+
+// synth:noteOn(note[, velocity[, wave]]) -> sent. `note` is a MIDI note
+// number (69 = A4 = 440 Hz, fractions allowed), velocity 0..1 (default 1);
+// `wave` overrides the synth's current waveform for this note.
+static int synth_note_on(lua_State *L) {
+    Synth *s = check_synth(L, 1);
+    float note = check_note(L, 2);
+    float velocity = (float)luaL_optnumber(L, 3, 1.0);
+    luaL_argcheck(L, velocity >= 0.0f && velocity <= 1.0f, 3, "velocity out of range");
+    int wave = lua_isnoneornil(L, 4) ? (int)s->wave : luaL_checkoption(L, 4, NULL, synth_waves);
+    SynthEvent e = { EVENT_NOTE_ON, (unsigned char)wave, 0, note, velocity };
+    lua_pushboolean(L, send_event(s, e));
+    return 1;
+}
+
+// synth:noteOff(note) -> sent. Releases every voice playing `note`.
+static int synth_note_off(lua_State *L) {
+    Synth *s = check_synth(L, 1);
+    SynthEvent e = { EVENT_NOTE_OFF, 0, 0, check_note(L, 2), 0.0f };
+    lua_pushboolean(L, send_event(s, e));
+    return 1;
+}
+
+// synth:allOff() -> sent. Releases every voice.
+static int synth_all_off(lua_State *L) {
+    Synth *s = check_synth(L, 1);
+    SynthEvent e = { EVENT_ALL_OFF, 0, 0, 0.0f, 0.0f };
+    lua_pushboolean(L, send_event(s, e));
+    return 1;
+}
+
+// synth:set(param, value) -> sent. `wave` takes a waveform name; attack,
+// decay and release are seconds, sustain a level 0..1, volume the output gain.
+static int synth_set(lua_State *L) {
+    Synth *s = check_synth(L, 1);
+    int param = luaL_checkoption(L, 2, NULL, synth_params);
+    if (param == SYNTH_WAVE) {                       // only read by noteOn, so no event needed
+        s->wave = (SynthWave)luaL_checkoption(L, 3, NULL, synth_waves);
+        lua_pushboolean(L, 1);
+        return 1;
+    }
+    float value = (float)luaL_checknumber(L, 3);
+    luaL_argcheck(L, value >= 0.0f, 3, "value must not be negative");
+    if (param == SYNTH_SUSTAIN) luaL_argcheck(L, value <= 1.0f, 3, "sustain out of range");
+    SynthEvent e = { EVENT_PARAM, 0, (unsigned short)param, value, 0.0f };
+    lua_pushboolean(L, send_event(s, e));
+    return 1;
+}
+
+static void synth_detach(Synth *s) {
+    if (s->slot >= 0) detach_feed(s->slot);
+    drain_events(s);                                 // nothing consumes the queue any more
+}
+
+// synth:attach(stream) — renders into `stream` from its callback, at its
+// sample rate and format. Replaces the stream's previous feed.
+static int synth_attach(lua_State *L) {
+    Synth *s = check_synth(L, 1);
+    AudioStream *stream = check_udata(L, 2, AudioStream);
+    if (!IsAudioStreamValid(*stream)) return luaL_error(L, "Synth: invalid audio stream");
+    if (stream->sampleSize != 8 && stream->sampleSize != 16 && stream->sampleSize != 32)
+        return luaL_error(L, "Synth: unsupported sample size %d", (int)stream->sampleSize);
+    synth_detach(s);
+    s->sampleSize = (int)stream->sampleSize;
+    s->channels = (int)stream->channels;
+    if (s->sampleRate != (float)stream->sampleRate) {
+        for (int i = 0; i < s->voiceCount; i++) s->voices[i].step *= s->sampleRate / (float)stream->sampleRate;
+        s->sampleRate = (float)stream->sampleRate;
+    }
+    lua_pushvalue(L, 2);
+    lua_setiuservalue(L, 1, 1);                      // keeps the stream userdata alive
+    if (attach_feed(FEED_STREAM_CALLBACK, *stream, synth_fill, s, &s->slot) < 0)
+        return luaL_error(L, "Synth: more than %d streams are fed natively", STREAM_FEED_SLOTS);
+    return 0;
+}
+
+// synth:detach() — also run by __gc / __close
+static int synth_detach_lua(lua_State *L) {
+    Synth *s = check_synth(L, 1);
+    synth_detach(s);
+    lua_pushnil(L);
+    lua_setiuservalue(L, 1, 1);
+    return 0;
+}
+
+// synth:render(sb[, frames]) — renders a detached synth into a SampleBuffer
+// on the calling thread, at the synth's sample rate.
+static int synth_render_lua(lua_State *L) {
+    Synth *s = check_synth(L, 1);
+    SampleBuffer *sb = check_udata(L, 2, SampleBuffer);
+    luaL_argcheck(L, sb->data != NULL, 2, "SampleBuffer has been unloaded");
+    lua_Integer frames = luaL_optinteger(L, 3, sb->frames);
+    luaL_argcheck(L, frames >= 0 && frames <= sb->frames, 3, "more frames than the SampleBuffer holds");
+    if (s->slot >= 0) return luaL_error(L, "Synth: cannot render offline while attached");
+    synth_render(s, sb->data, (unsigned int)frames, sb->sampleSize, sb->channels);
+    return 0;
+}
+
+// synth:stats() -> {voices, active, sampleRate, attached, framesRendered, eventsApplied, eventsQueued, eventsDropped}
+static int synth_stats(lua_State *L) {
+    Synth *s = check_synth(L, 1);
+    lua_createtable(L, 0, 8);
+    lua_pushinteger(L, s->voiceCount);
+    lua_setfield(L, -2, "voices");
+    lua_pushinteger(L, atomic_load(&s->activeVoices));
+    lua_setfield(L, -2, "active");
+    lua_pushnumber(L, s->sampleRate);
+    lua_setfield(L, -2, "sampleRate");
+    lua_pushboolean(L, s->slot >= 0);
+    lua_setfield(L, -2, "attached");
+    lua_pushinteger(L, atomic_load(&s->framesRendered));
+    lua_setfield(L, -2, "framesRendered");
+    lua_pushinteger(L, atomic_load(&s->eventsApplied));
+    lua_setfield(L, -2, "eventsApplied");
+    lua_pushinteger(L, atomic_load(&s->queueHead) - atomic_load(&s->queueTail));
+    lua_setfield(L, -2, "eventsQueued");
+    lua_pushinteger(L, s->eventsDropped);
+    lua_setfield(L, -2, "eventsDropped");
+    return 1;
+}
+
+static int synth_gc(lua_State *L) {
+    Synth *s = check_udata(L, 1, Synth);
+    if (s->slot >= 0) detach_feed(s->slot);
+    free(s->voices);
+    s->voices = NULL;
+    s->voiceCount = 0;
+    return 0;
+}
+
+static const luaL_Reg synth_methods[] = {
+    {"noteOn", synth_note_on}, {"noteOff", synth_note_off}, {"allOff", synth_all_off},
+    {"set", synth_set}, {"attach", synth_attach}, {"detach", synth_detach_lua},
+    {"render", synth_render_lua}, {"stats", synth_stats},
+    {NULL, NULL}
+};
+
+static const luaL_Reg synth_meta[] = {
+    {"__gc", synth_gc}, {"__close", synth_gc},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// SoundPool ("SoundPool" userdata)
+// ---------------------------------------------------------------------------
+//
+// A fixed set of aliases of one Sound, so bursts of the same effect play as
+// overlapping voices without the script loading and tracking aliases, and
+// never cost the mixer more than `maxVoices` buffers. The aliases are
+// managed "Sound" resources kept in user value 1 (each one anchors the
+// source), so they are unloaded through the deferred queue with the pool.
+// They are pinned to the pool: UnloadSound/UnloadSoundAlias on a voice raise
+// an error instead of freeing a buffer the pool still plays.
+
+typedef enum PoolPolicy { POOL_STEAL_OLDEST, POOL_STEAL_QUIETEST, POOL_DROP } PoolPolicy;
+
+static const char *const pool_policies[] = { "oldest", "quietest", "none", NULL };
+
+typedef struct PoolVoice {
+    Sound *alias;                   // the userdata in the pool's alias table
+    float volume;                   // set by play()/setVolume(), for POOL_STEAL_QUIETEST
+    unsigned int started;           // play order, for POOL_STEAL_OLDEST
+} PoolVoice;
+
+typedef struct SoundPool {
+    int count;
+    PoolPolicy policy;
+    unsigned int played, stolen, dropped;
+    PoolVoice voices[];
+} SoundPool;
+
+static SoundPool *check_sound_pool(lua_State *L, int idx) {
+    return check_udata(L, idx, SoundPool);
+}
+
+// SoundPool(sound, maxVoices[, policy]) — `policy` says which playing voice
+// a play() steals once all are busy: "oldest" (default), "quietest" or
+// "none" (the play is dropped). "quietest" goes by the volume given to
+// play() or pool:setVolume(); SetSoundVolume on pool:voice(i) is not seen.
+static int lua_SoundPool(lua_State *L) {
+    Sound *source = check_udata(L, 1, Sound);
+    lua_Integer count = luaL_checkinteger(L, 2);
+    PoolPolicy policy = (PoolPolicy)luaL_checkoption(L, 3, "oldest", pool_policies);
+    luaL_argcheck(L, count >= 1 && count <= 256, 2, "voice count out of range");
+    if (!IsSoundValid(*source)) return luaL_error(L, "SoundPool: invalid sound");
+
+    SoundPool *pool = lua_newuserdatauv(L, sizeof(SoundPool) + sizeof(PoolVoice) * (size_t)count, 1);
+    memset(pool, 0, sizeof(SoundPool));
+    pool->policy = policy;
+    luaL_setmetatable(L, "SoundPool");
+    lua_createtable(L, (int)count, 0);
+    for (int i = 0; i < count; i++) {
+        Sound alias = LoadSoundAlias(*source);
+        if (!IsSoundValid(alias)) return luaL_error(L, "SoundPool: could not create voice %d", i + 1);
+        pool->voices[i] = (PoolVoice){ push_resource(L, RESOURCE_SOUND_ALIAS, "Sound", &alias), 1.0f, 0 };
+        pin_resource(L, -1, sizeof(Sound), 1);
+        lua_pushvalue(L, 1);        // the alias plays the source's samples: keep it alive
+        lua_setiuservalue(L, -2, 1);
+        lua_rawseti(L, -2, i + 1);
+        pool->count = i + 1;
+    }
+    lua_setiuservalue(L, -2, 1);
+    return 1;
+}
+
+// Whether a voice still has its alias; one collected or flushed by
+// CloseAudioDevice is skipped rather than touched.
+static int voice_live(const PoolVoice *v) {
+    return !resource_unloaded(v->alias, RESOURCE_SOUND_ALIAS);
+}
+
+static int pick_voice(SoundPool *pool, int *stolen) {
+    *stolen = 0;
+    for (int i = 0; i < pool->count; i++)
+        if (voice_live(&pool->voices[i]) && !IsSoundPlaying(*pool->voices[i].alias)) return i;
+    if (pool->policy == POOL_DROP) return -1;
+    int best = -1;
+    for (int i = 0; i < pool->count; i++) {
+        const PoolVoice *v = &pool->voices[i], *b = &pool->voices[best < 0 ? i : best];
+        if (!voice_live(v)) continue;
+        if (best < 0) {
+            best = i;
+        } else if (pool->policy == POOL_STEAL_QUIETEST && v->volume != b->volume) {
+            if (v->volume < b->volume) best = i;
+        } else if (v->started < b->started) {
+            best = i;
+        }
+    }
+    *stolen = best >= 0;
+    return best;
+}
+
+// pool:play([volume[, pitch[, pan]]]) -> voice index, or nil if the play was
+// dropped. Volume and pitch default to 1 and pan to 0 (centered), so each
+// voice starts clean whatever it played last.
+static int sound_pool_play(lua_State *L) {
+    SoundPool *pool = check_sound_pool(L, 1);
+    float volume = (float)luaL_optnumber(L, 2, 1.0);
+    float pitch = (float)luaL_optnumber(L, 3, 1.0);
+    float pan = (float)luaL_optnumber(L, 4, 0.0);
+    if (pool->count == 0) return luaL_error(L, "SoundPool has been released");
+    int stolen, i = pick_voice(pool, &stolen);
+    if (i < 0) {
+        pool->dropped++;
+        lua_pushnil(L);
+        return 1;
+    }
+    PoolVoice *v = &pool->voices[i];
+    if (stolen) {
+        StopSound(*v->alias);
+        pool->stolen++;
+    }
+    SetSoundVolume(*v->alias, volume);
+    SetSoundPitch(*v->alias, pitch);
+    SetSoundPan(*v->alias, pan);
+    PlaySound(*v->alias);
+    v->volume = volume;
+    v->started = ++pool->played;
+    lua_pushinteger(L, i + 1);
+    return 1;
+}
+
+// pool:stop() — stops every voice
+static int sound_pool_stop(lua_State *L) {
+    SoundPool *pool = check_sound_pool(L, 1);
+    for (int i = 0; i < pool->count; i++)
+        if (voice_live(&pool->voices[i])) StopSound(*pool->voices[i].alias);
+    return 0;
+}
+
+static int count_active(const SoundPool *pool) {
+    int active = 0;
+    for (int i = 0; i < pool->count; i++)
+        if (voice_live(&pool->voices[i])) active += IsSoundPlaying(*pool->voices[i].alias);
+    return active;
+}
+
+// pool:active() -> voices playing now
+static int sound_pool_active(lua_State *L) {
+    lua_pushinteger(L, count_active(check_sound_pool(L, 1)));
+    return 1;
+}
+
+// pool:setVolume(i, volume) — changes a playing voice's volume and records it
+// for the "quietest" policy.
+static int sound_pool_set_volume(lua_State *L) {
+    SoundPool *pool = check_sound_pool(L, 1);
+    lua_Integer i = luaL_checkinteger(L, 2);
+    float volume = (float)luaL_checknumber(L, 3);
+    luaL_argcheck(L, i >= 1 && i <= pool->count, 2, "voice index out of range");
+    PoolVoice *v = &pool->voices[i - 1];
+    if (voice_live(v)) SetSoundVolume(*v->alias, volume);
+    v->volume = volume;
+    return 0;
+}
+
+// pool:voice(i) -> the i-th alias, e.g. to adjust a voice that is playing.
+// It belongs to the pool: unloading it raises an error; use pool:release().
+static int sound_pool_voice(lua_State *L) {
+    SoundPool *pool = check_sound_pool(L, 1);
+    lua_Integer i = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, i >= 1 && i <= pool->count, 2, "voice index out of range");
+    lua_getiuservalue(L, 1, 1);
+    lua_rawgeti(L, -1, i);
+    return 1;
+}
+
+// pool:stats() -> {voices, active, played, stolen, dropped}
+static int sound_pool_stats(lua_State *L) {
+    SoundPool *pool = check_sound_pool(L, 1);
+    lua_createtable(L, 0, 5);
+    lua_pushinteger(L, pool->count);
+    lua_setfield(L, -2, "voices");
+    lua_pushinteger(L, count_active(pool));
+    lua_setfield(L, -2, "active");
+    lua_pushinteger(L, pool->played);
+    lua_setfield(L, -2, "played");
+    lua_pushinteger(L, pool->stolen);
+    lua_setfield(L, -2, "stolen");
+    lua_pushinteger(L, pool->dropped);
+    lua_setfield(L, -2, "dropped");
+    return 1;
+}
+
+// pool:release() — unloads the voices now instead of at collection; also
+// run by __close.
+static int sound_pool_release(lua_State *L) {
+    SoundPool *pool = check_sound_pool(L, 1);
+    lua_getiuservalue(L, 1, 1);
+    for (int i = 0; i < pool->count; i++) {
+        lua_rawgeti(L, -1, i + 1);
+        pin_resource(L, -1, sizeof(Sound), 0);
+        if (release_resource(L, -1, sizeof(Sound))) {
+            detach_stream_feeds(&pool->voices[i].alias->stream);
+            UnloadSoundAlias(*pool->voices[i].alias);
+        }
+        lua_pop(L, 1);
+    }
+    pool->count = 0;
+    return 0;
+}
+
+static int sound_pool_len(lua_State *L) {
+    lua_pushinteger(L, check_sound_pool(L, 1)->count);
+    return 1;
+}
+
+static const luaL_Reg sound_pool_methods[] = {
+    {"play", sound_pool_play}, {"stop", sound_pool_stop}, {"active", sound_pool_active},
+    {"setVolume", sound_pool_set_volume}, {"voice", sound_pool_voice}, {"stats", sound_pool_stats},
+    {"release", sound_pool_release},
+    {NULL, NULL}
+};
+
+static const luaL_Reg sound_pool_meta[] = {
+    {"__len", sound_pool_len}, {"__close", sound_pool_release},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// Registration
+// ---------------------------------------------------------------------------
+
+static const luaL_Reg mixer_functions[] = {
+    {"AudioRing", lua_AudioRing},
+    {"AudioGraph", lua_AudioGraph},
+    {"Synth", lua_Synth},
+    {"SoundPool", lua_SoundPool},
+    {NULL, NULL}
+};
+
+// Creates the AudioRing, AudioGraph, Synth and SoundPool metatables and adds
+// the mixer constructors onto the module table currently on top of the stack.
+void register_mixer(lua_State *L) {
+    luaL_newmetatable(L, "AudioRing");
+    luaL_setfuncs(L, audio_ring_meta, 0);
+    luaL_newlib(L, audio_ring_methods);
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+    luaL_newmetatable(L, "AudioGraph");
+    luaL_setfuncs(L, audio_graph_meta, 0);
+    luaL_newlib(L, audio_graph_methods);
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+    luaL_newmetatable(L, "Synth");
+    luaL_setfuncs(L, synth_meta, 0);
+    luaL_newlib(L, synth_methods);
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+    luaL_newmetatable(L, "SoundPool");
+    luaL_setfuncs(L, sound_pool_meta, 0);
+    luaL_newlib(L, sound_pool_methods);
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+    luaL_setfuncs(L, mixer_functions, 0);
+}
@@ -18,15 +18,16 @@ static void unload_one_model_animation(ModelAnimation anim) {
 
 int lua_LoadModel(lua_State *L) {
     const char *fileName = luaL_checkstring(L, 1);
+    const char *key = push_asset_key(L, "Model", fileName, -1);
+    if (asset_cache_lookup(L, RESOURCE_MODEL, key)) return 1;
     Model model = LoadModel(fileName);
-    Model *pModel = lua_newuserdata(L, sizeof(Model));
-    *pModel = model;
-    luaL_setmetatable(L, "Model");
+    push_resource(L, RESOURCE_MODEL, "Model", &model);
+    if (IsModelValid(model)) asset_cache_insert(L, RESOURCE_MODEL, key);
     return 1;
 }
 
 int lua_DrawModel(lua_State *L) {
-    Model *model = luaL_checkudata(L, 1, "Model");
+    Model *model = check_udata(L, 1, Model);
     Vector3 position = get_vector3_from_table(L, 2);
     float scale = luaL_checknumber(L, 3);
     Color color = get_color_from_table(L, 4);
@@ -35,7 +36,7 @@ int lua_DrawModel(lua_State *L) {
 }
 
 int lua_DrawModelEx(lua_State *L) {
-    Model *model = luaL_checkudata(L, 1, "Model");
+    Model *model = check_udata(L, 1, Model);
     Vector3 position = get_vector3_from_table(L, 2);
     Vector3 rotationAxis = get_vector3_from_table(L, 3);
     float rotationAngle = luaL_checknumber(L, 4);
@@ -46,30 +47,30 @@ int lua_DrawModelEx(lua_State *L) {
 }
 
 int lua_UnloadModel(lua_State *L) {
-    Model *model = luaL_checkudata(L, 1, "Model");
-    UnloadModel(*model);
+    Model *model = check_udata(L, 1, Model);
+    if (release_resource(L, 1, sizeof(Model))) UnloadModel(*model);
     return 0;
 }
 
 int lua_UpdateModelAnimation(lua_State *L) {
-    Model *model = luaL_checkudata(L, 1, "Model");
-    ModelAnimation *animation = luaL_checkudata(L, 2, "ModelAnimation");
+    Model *model = check_udata(L, 1, Model);
+    ModelAnimation *animation = check_udata(L, 2, ModelAnimation);
     float frame = (float)luaL_checknumber(L, 3);
     UpdateModelAnimation(*model, *animation, frame);
     return 0;
 }
 
 int lua_DrawMesh(lua_State *L) {
-    Mesh *mesh = luaL_checkudata(L, 1, "Mesh");
-    Material *material = luaL_checkudata(L, 2, "Material");
+    Mesh *mesh = check_udata(L, 1, Mesh);
+    Material *material = check_udata(L, 2, Material);
     Matrix transform = get_matrix_from_table(L, 3);
     DrawMesh(*mesh, *material, transform);
     return 0;
 }
 
 int lua_UnloadMesh(lua_State *L) {
-    Mesh *mesh = luaL_checkudata(L, 1, "Mesh");
-    UnloadMesh(*mesh);
+    Mesh *mesh = check_udata(L, 1, Mesh);
+    if (release_resource(L, 1, sizeof(Mesh))) UnloadMesh(*mesh);
     return 0;
 }
 
@@ -78,9 +79,7 @@ int lua_GenMeshCube(lua_State *L) {
     float height = luaL_checknumber(L, 2);
     float length = luaL_checknumber(L, 3);
     Mesh cube = GenMeshCube(width, height, length);
-    Mesh *pCube = lua_newuserdata(L, sizeof(Mesh));
-    *pCube = cube;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &cube);
     return 1;
 }
 
@@ -89,9 +88,7 @@ int lua_GenMeshSphere(lua_State *L) {
     int rings = luaL_checkinteger(L, 2);
     int slices = luaL_checkinteger(L, 3);
     Mesh sphere = GenMeshSphere(radius, rings, slices);
-    Mesh *pSphere = lua_newuserdata(L, sizeof(Mesh));
-    *pSphere = sphere;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &sphere);
     return 1;
 }
 
@@ -101,9 +98,7 @@ int lua_GenMeshPlane(lua_State *L) {
     int resX = luaL_checkinteger(L, 3);
     int resZ = luaL_checkinteger(L, 4);
     Mesh plane = GenMeshPlane(width, length, resX, resZ);
-    Mesh *pPlane = lua_newuserdata(L, sizeof(Mesh));
-    *pPlane = plane;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &plane);
     return 1;
 }
 
@@ -142,20 +137,11 @@ int lua_DrawTriangle3D(lua_State *L) {
 }
 
 int lua_DrawTriangleStrip3D(lua_State *L) {
-    luaL_checktype(L, 1, LUA_TTABLE);
-    int pointCount = lua_rawlen(L, 1);
-    Vector3 *points = malloc(sizeof(Vector3) * pointCount);
-
-    for (int i = 0; i < pointCount; i++) {
-        lua_rawgeti(L, 1, i + 1);
-        points[i] = get_vector3_from_table(L, -1);
-        lua_pop(L, 1);
-    }
-
     Color color = get_color_from_table(L, 2);
+    int pointCount;
+    Vector3 *points = get_vector3_list(L, 1, &pointCount);
     DrawTriangleStrip3D(points, pointCount, color);
-
-    free(points);
+    release_vector3_list(L, 1, points);
     return 0;
 }
 
@@ -287,22 +273,21 @@ int lua_DrawRay(lua_State *L) {
 }
 
 int lua_LoadModelFromMesh(lua_State *L) {
-    Mesh *mesh = luaL_checkudata(L, 1, "Mesh");
+    Mesh *mesh = check_udata(L, 1, Mesh);
     Model model = LoadModelFromMesh(*mesh);
-    Model *pModel = lua_newuserdata(L, sizeof(Model));
-    *pModel = model;
-    luaL_setmetatable(L, "Model");
+    disown_resource(L, 1, sizeof(Mesh));   // UnloadModel frees the mesh from now on
+    push_resource(L, RESOURCE_MODEL, "Model", &model);
     return 1;
 }
 
 int lua_IsModelValid(lua_State *L) {
-    Model *model = luaL_checkudata(L, 1, "Model");
+    Model *model = check_udata(L, 1, Model);
     lua_pushboolean(L, IsModelValid(*model));
     return 1;
 }
 
 int lua_GetModelBoundingBox(lua_State *L) {
-    Model *model = luaL_checkudata(L, 1, "Model");
+    Model *model = check_udata(L, 1, Model);
     push_bounding_box_to_table(L, GetModelBoundingBox(*model));
     return 1;
 }
@@ -315,8 +300,8 @@ int lua_DrawBoundingBox(lua_State *L) {
 }
 
 int lua_DrawBillboard(lua_State *L) {
-    Camera *camera = luaL_checkudata(L, 1, "Camera");
-    Texture2D *texture = luaL_checkudata(L, 2, "Texture2D");
+    Camera *camera = check_udata(L, 1, Camera);
+    Texture2D *texture = check_texture(L, 2);
     Vector3 position = get_vector3_from_table(L, 3);
     float scale = luaL_checknumber(L, 4);
     Color tint = get_color_from_table(L, 5);
@@ -325,8 +310,8 @@ int lua_DrawBillboard(lua_State *L) {
 }
 
 int lua_DrawBillboardRec(lua_State *L) {
-    Camera *camera = luaL_checkudata(L, 1, "Camera");
-    Texture2D *texture = luaL_checkudata(L, 2, "Texture2D");
+    Camera *camera = check_udata(L, 1, Camera);
+    Texture2D *texture = check_texture(L, 2);
     Rectangle source = get_rectangle_from_table(L, 3);
     Vector3 position = get_vector3_from_table(L, 4);
     Vector2 size = get_vector2_from_table(L, 5);
@@ -336,8 +321,8 @@ int lua_DrawBillboardRec(lua_State *L) {
 }
 
 int lua_DrawBillboardPro(lua_State *L) {
-    Camera *camera = luaL_checkudata(L, 1, "Camera");
-    Texture2D *texture = luaL_checkudata(L, 2, "Texture2D");
+    Camera *camera = check_udata(L, 1, Camera);
+    Texture2D *texture = check_texture(L, 2);
     Rectangle source = get_rectangle_from_table(L, 3);
     Vector3 position = get_vector3_from_table(L, 4);
     Vector3 up = get_vector3_from_table(L, 5);
@@ -350,14 +335,14 @@ int lua_DrawBillboardPro(lua_State *L) {
 }
 
 int lua_UploadMesh(lua_State *L) {
-    Mesh *mesh = luaL_checkudata(L, 1, "Mesh");
+    Mesh *mesh = check_udata(L, 1, Mesh);
     bool dynamic = lua_toboolean(L, 2);
     UploadMesh(mesh, dynamic);
     return 0;
 }
 
 int lua_UpdateMeshBuffer(lua_State *L) {
-    Mesh *mesh = luaL_checkudata(L, 1, "Mesh");
+    Mesh *mesh = check_udata(L, 1, Mesh);
     int index = luaL_checkinteger(L, 2);
     const void *data = get_data_buffer(L, 3);
     int dataSize = luaL_checkinteger(L, 4);
@@ -367,19 +352,19 @@ int lua_UpdateMeshBuffer(lua_State *L) {
 }
 
 int lua_GetMeshBoundingBox(lua_State *L) {
-    Mesh *mesh = luaL_checkudata(L, 1, "Mesh");
+    Mesh *mesh = check_udata(L, 1, Mesh);
     push_bounding_box_to_table(L, GetMeshBoundingBox(*mesh));
     return 1;
 }
 
 int lua_GenMeshTangents(lua_State *L) {
-    Mesh *mesh = luaL_checkudata(L, 1, "Mesh");
+    Mesh *mesh = check_udata(L, 1, Mesh);
     GenMeshTangents(mesh);
     return 0;
 }
 
 int lua_ExportMesh(lua_State *L) {
-    Mesh *mesh = luaL_checkudata(L, 1, "Mesh");
+    Mesh *mesh = check_udata(L, 1, Mesh);
     const char *fileName = luaL_checkstring(L, 2);
     bool success = ExportMesh(*mesh, fileName);
     lua_pushboolean(L, success);
@@ -387,7 +372,7 @@ int lua_ExportMesh(lua_State *L) {
 }
 
 int lua_ExportMeshAsCode(lua_State *L) {
-    Mesh *mesh = luaL_checkudata(L, 1, "Mesh");
+    Mesh *mesh = check_udata(L, 1, Mesh);
     const char *fileName = luaL_checkstring(L, 2);
     bool success = ExportMeshAsCode(*mesh, fileName);
     lua_pushboolean(L, success);
@@ -398,9 +383,7 @@ int lua_GenMeshPoly(lua_State *L) {
     int sides = luaL_checkinteger(L, 1);
     float radius = luaL_checknumber(L, 2);
     Mesh mesh = GenMeshPoly(sides, radius);
-    Mesh *pMesh = lua_newuserdata(L, sizeof(Mesh));
-    *pMesh = mesh;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &mesh);
     return 1;
 }
 
@@ -409,9 +392,7 @@ int lua_GenMeshHemiSphere(lua_State *L) {
     int rings = luaL_checkinteger(L, 2);
     int slices = luaL_checkinteger(L, 3);
     Mesh mesh = GenMeshHemiSphere(radius, rings, slices);
-    Mesh *pMesh = lua_newuserdata(L, sizeof(Mesh));
-    *pMesh = mesh;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &mesh);
     return 1;
 }
 
@@ -420,9 +401,7 @@ int lua_GenMeshCylinder(lua_State *L) {
     float height = luaL_checknumber(L, 2);
     int slices = luaL_checkinteger(L, 3);
     Mesh mesh = GenMeshCylinder(radius, height, slices);
-    Mesh *pMesh = lua_newuserdata(L, sizeof(Mesh));
-    *pMesh = mesh;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &mesh);
     return 1;
 }
 
@@ -431,9 +410,7 @@ int lua_GenMeshCone(lua_State *L) {
     float height = luaL_checknumber(L, 2);
     int slices = luaL_checkinteger(L, 3);
     Mesh mesh = GenMeshCone(radius, height, slices);
-    Mesh *pMesh = lua_newuserdata(L, sizeof(Mesh));
-    *pMesh = mesh;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &mesh);
     return 1;
 }
 
@@ -443,9 +420,7 @@ int lua_GenMeshTorus(lua_State *L) {
     int radSeg = luaL_checkinteger(L, 3);
     int sides = luaL_checkinteger(L, 4);
     Mesh mesh = GenMeshTorus(radius, size, radSeg, sides);
-    Mesh *pMesh = lua_newuserdata(L, sizeof(Mesh));
-    *pMesh = mesh;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &mesh);
     return 1;
 }
 
@@ -455,29 +430,23 @@ int lua_GenMeshKnot(lua_State *L) {
     int radSeg = luaL_checkinteger(L, 3);
     int sides = luaL_checkinteger(L, 4);
     Mesh mesh = GenMeshKnot(radius, size, radSeg, sides);
-    Mesh *pMesh = lua_newuserdata(L, sizeof(Mesh));
-    *pMesh = mesh;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &mesh);
     return 1;
 }
 
 int lua_GenMeshHeightmap(lua_State *L) {
-    Image *heightmap = luaL_checkudata(L, 1, "Image");
+    Image *heightmap = check_udata(L, 1, Image);
     Vector3 size = get_vector3_from_table(L, 2);
     Mesh mesh = GenMeshHeightmap(*heightmap, size);
-    Mesh *pMesh = lua_newuserdata(L, sizeof(Mesh));
-    *pMesh = mesh;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &mesh);
     return 1;
 }
 
 int lua_GenMeshCubicmap(lua_State *L) {
-    Image *cubicmap = luaL_checkudata(L, 1, "Image");
+    Image *cubicmap = check_udata(L, 1, Image);
     Vector3 cubeSize = get_vector3_from_table(L, 2);
     Mesh mesh = GenMeshCubicmap(*cubicmap, cubeSize);
-    Mesh *pMesh = lua_newuserdata(L, sizeof(Mesh));
-    *pMesh = mesh;
-    luaL_setmetatable(L, "Mesh");
+    push_resource(L, RESOURCE_MESH, "Mesh", &mesh);
     return 1;
 }
 
@@ -511,27 +480,28 @@ int lua_LoadMaterialDefault(lua_State *L) {
 }
 
 int lua_IsMaterialValid(lua_State *L) {
-    Material *material = luaL_checkudata(L, 1, "Material");
+    Material *material = check_udata(L, 1, Material);
     lua_pushboolean(L, IsMaterialValid(*material));
     return 1;
 }
 
 int lua_UnloadMaterial(lua_State *L) {
-    Material *material = luaL_checkudata(L, 1, "Material");
+    Material *material = check_udata(L, 1, Material);
     UnloadMaterial(*material);
     return 0;
 }
 
 int lua_SetMaterialTexture(lua_State *L) {
-    Material *material = luaL_checkudata(L, 1, "Material");
+    Material *material = check_udata(L, 1, Material);
     int mapType = luaL_checkinteger(L, 2);
-    Texture2D *texture = luaL_checkudata(L, 3, "Texture2D");
+    Texture2D *texture = check_texture(L, 3);
     SetMaterialTexture(material, mapType, *texture);
+    pin_texture(L, 3);   // the material keeps the GL id
     return 0;
 }
 
 int lua_SetModelMeshMaterial(lua_State *L) {
-    Model *model = luaL_checkudata(L, 1, "Model");
+    Model *model = check_udata(L, 1, Model);
     int meshId = luaL_checkinteger(L, 2);
     int materialId = luaL_checkinteger(L, 3);
     SetModelMeshMaterial(model, meshId, materialId);
@@ -557,7 +527,7 @@ int lua_LoadModelAnimations(lua_State *L) {
 }
 
 int lua_UnloadModelAnimation(lua_State *L) {
-    ModelAnimation *animation = luaL_checkudata(L, 1, "ModelAnimation");
+    ModelAnimation *animation = check_udata(L, 1, ModelAnimation);
     unload_one_model_animation(*animation);
     return 0;
 }
@@ -568,7 +538,7 @@ int lua_UnloadModelAnimations(lua_State *L) {
 
     for (int i = 1; i <= animCount; i++) {
         lua_rawgeti(L, 1, i);
-        ModelAnimation *animation = luaL_checkudata(L, -1, "ModelAnimation");
+        ModelAnimation *animation = check_udata(L, -1, ModelAnimation);
         unload_one_model_animation(*animation);
         lua_pop(L, 1);
     }
@@ -576,8 +546,8 @@ int lua_UnloadModelAnimations(lua_State *L) {
 }
 
 int lua_IsModelAnimationValid(lua_State *L) {
-    Model *model = luaL_checkudata(L, 1, "Model");
-    ModelAnimation *animation = luaL_checkudata(L, 2, "ModelAnimation");
+    Model *model = check_udata(L, 1, Model);
+    ModelAnimation *animation = check_udata(L, 2, ModelAnimation);
     lua_pushboolean(L, IsModelAnimationValid(*model, *animation));
     return 1;
 }
@@ -623,7 +593,7 @@ int lua_GetRayCollisionBox(lua_State *L) {
 
 int lua_GetRayCollisionMesh(lua_State *L) {
     Ray ray          = get_ray_from_table(L, 1);
-    Mesh *mesh       = luaL_checkudata(L, 2, "Mesh");
+    Mesh *mesh       = check_udata(L, 2, Mesh);
     Matrix transform = get_matrix_from_table(L, 3);
     push_ray_collision_to_table(L, GetRayCollisionMesh(ray, *mesh, transform));
     return 1;
@@ -649,10 +619,10 @@ int lua_GetRayCollisionQuad(lua_State *L) {
 }
 
 int lua_UpdateModelAnimationEx(lua_State *L) {
-    Model *model         = luaL_checkudata(L, 1, "Model");
-    ModelAnimation *animA = luaL_checkudata(L, 2, "ModelAnimation");
+    Model *model         = check_udata(L, 1, Model);
+    ModelAnimation *animA = check_udata(L, 2, ModelAnimation);
     float frameA         = (float)luaL_checknumber(L, 3);
-    ModelAnimation *animB = luaL_checkudata(L, 4, "ModelAnimation");
+    ModelAnimation *animB = check_udata(L, 4, ModelAnimation);
     float frameB         = (float)luaL_checknumber(L, 5);
     float blend          = (float)luaL_checknumber(L, 6);
     UpdateModelAnimationEx(*model, *animA, frameA, *animB, frameB, blend);
@@ -0,0 +1,834 @@
+// lua_raylib_resources.c
+//
+// Garbage-collected GPU/audio resources. Userdata created by the Load* / Gen*
+// bindings for textures, render textures, fonts, shaders, meshes, models,
+// sounds, music streams and instance buffers are allocated by push_resource() with a small
+// trailer after the raylib struct that records the resource kind and whether
+// the script still owns it. Their metatables get __gc and __close, which never
+// call raylib directly — collection can happen in the middle of a frame, with
+// draw calls still batched against the handle — but push a copy of the struct
+// onto a process-wide destroy queue, whose slots are reserved when the
+// resource is created so a finalizer never allocates. EndDrawing drains the
+// queue once the frame has been submitted; CloseWindow / CloseAudioDevice
+// drain it before the context they depend on goes away.
+//
+// The explicit Unload* bindings go through release_resource(), which flips the
+// same trailer flag, so an explicit unload followed by collection (or two
+// explicit unloads) frees the handle exactly once. A resource pinned to the
+// object holding it (pin_resource, e.g. SoundPool voices) refuses explicit
+// unloads until that object unpins it. Userdata without a trailer
+// (borrowed handles such as GetFontDefault() or GetShapesTexture()) are never
+// finalized and unload exactly as before.
+//
+// File loads (LoadTexture, LoadModel, LoadSound, LoadFont/LoadFontEx) go
+// through a per-state asset cache keyed by kind, normalized absolute path and
+// load parameters. A hit hands out the same userdata again and bumps its
+// reference count; each explicit Unload* or __close drops one reference and
+// only the last one unloads. The cache holds its entries weakly, so an asset nobody
+// references any more is still collected and finalized as above.
+//
+// Every tracked userdata (the resources above plus Images and Waves, which
+// are tracked but not finalized) records its estimated CPU and GPU footprint
+// in the trailer when created; process-wide per-kind totals and high-water
+// marks are kept current through creation, in-place resizes
+// (retrack_resource), explicit unloads and queue flushes, and reported by
+// GetResourceStats().
+//
+// Textures loaded while a VRAM budget is set (SetTextureBudget) are managed:
+// they sit on an LRU list ordered by the last frame they were drawn, and when
+// the resident managed textures exceed the budget the least recently drawn
+// ones are unloaded from the GPU, keeping their userdata, size and reload
+// source (the file path, or a CPU copy of the source image). check_texture(),
+// used by every binding that hands a Texture2D to raylib, moves it to the
+// front and reloads it if it was evicted. Nothing drawn in the current frame
+// is evicted, since the batch may still reference it; textures stored inside
+// materials or shader state are pinned instead.
+//
+// register_resources() installs the metamethods and the Lua-facing queue and
+// cache functions; it is called from luaopen_raylib after the module table
+// exists.
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "raylib.h"
+#include <lua.h>
+#include <lauxlib.h>
+#include "raylib_wrappers.h"
+
+#define RESOURCE_OWNED    0x1   // the script is responsible for unloading it
+#define RESOURCE_UNLOADED 0x2   // already unloaded or queued for destruction
+#define RESOURCE_CACHED   0x4   // listed in the asset cache under user value 2
+#define RESOURCE_PINNED   0x8   // part of another object: only that object unloads it
+
+typedef struct ManagedTexture ManagedTexture;
+
+typedef struct ResourceTrailer {
+    unsigned short kind;
+    unsigned short flags;
+    int refs;                   // explicit Unload* calls still needed to unload
+    size_t cpuBytes;            // footprint currently counted in resource_stats
+    size_t gpuBytes;
+    ManagedTexture *managed;    // textures under the VRAM budget, else NULL
+} ResourceTrailer;
+
+// Size of the locs array raylib allocates per shader (RL_MAX_SHADER_LOCATIONS ints).
+#define SHADER_LOCATION_BYTES (32 * sizeof(int))
+
+// Offset of the trailer behind a struct of `size` bytes.
+#define TRAILER_OFFSET(size) (((size) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+
+typedef struct PendingUnload {
+    ResourceKind kind;
+    size_t cpuBytes;
+    size_t gpuBytes;
+    union {
+        Texture2D texture;
+        RenderTexture2D renderTexture;
+        Font font;
+        Shader shader;
+        Mesh mesh;
+        Model model;
+        Sound sound;
+        Music music;
+        InstanceBuffer instanceBuffer;
+    } as;
+} PendingUnload;
+
+// One queue per process: every GL and audio handle belongs to the single
+// window/audio device, whichever lua_State created it.
+static PendingUnload *unload_queue = NULL;
+static int unload_count = 0;
+static int unload_capacity = 0;
+
+static const size_t resource_sizes[RESOURCE_KIND_COUNT] = {
+    [RESOURCE_TEXTURE]        = sizeof(Texture2D),
+    [RESOURCE_RENDER_TEXTURE] = sizeof(RenderTexture2D),
+    [RESOURCE_FONT]           = sizeof(Font),
+    [RESOURCE_SHADER]         = sizeof(Shader),
+    [RESOURCE_MESH]           = sizeof(Mesh),
+    [RESOURCE_MODEL]          = sizeof(Model),
+    [RESOURCE_SOUND]          = sizeof(Sound),
+    [RESOURCE_SOUND_ALIAS]    = sizeof(Sound),
+    [RESOURCE_MUSIC]          = sizeof(Music),
+    [RESOURCE_INSTANCE_BUFFER] = sizeof(InstanceBuffer),
+    [RESOURCE_IMAGE]          = sizeof(Image),
+    [RESOURCE_WAVE]           = sizeof(Wave),
+};
+
+// Names used as keys of the GetResourceStats() table.
+static const char *const resource_names[RESOURCE_KIND_COUNT] = {
+    [RESOURCE_TEXTURE] = "Texture", [RESOURCE_RENDER_TEXTURE] = "RenderTexture",
+    [RESOURCE_FONT] = "Font", [RESOURCE_SHADER] = "Shader", [RESOURCE_MESH] = "Mesh",
+    [RESOURCE_MODEL] = "Model", [RESOURCE_SOUND] = "Sound", [RESOURCE_SOUND_ALIAS] = "SoundAlias",
+    [RESOURCE_MUSIC] = "Music", [RESOURCE_INSTANCE_BUFFER] = "InstanceBuffer", [RESOURCE_IMAGE] = "Image", [RESOURCE_WAVE] = "Wave",
+};
+
+typedef struct ResourceStats {
+    lua_Integer count;
+    lua_Integer cpuBytes;
+    lua_Integer gpuBytes;
+    lua_Integer peakCpuBytes;
+    lua_Integer peakGpuBytes;
+} ResourceStats;
+
+// Process-wide, like the unload queue; index RESOURCE_KIND_COUNT is the total.
+static ResourceStats resource_stats[RESOURCE_KIND_COUNT + 1];
+
+static void stats_add(ResourceKind kind, int count, lua_Integer cpuBytes, lua_Integer gpuBytes) {
+    ResourceStats *entries[2] = {&resource_stats[kind], &resource_stats[RESOURCE_KIND_COUNT]};
+    for (int i = 0; i < 2; i++) {
+        ResourceStats *st = entries[i];
+        st->count += count;
+        st->cpuBytes += cpuBytes;
+        st->gpuBytes += gpuBytes;
+        if (st->cpuBytes > st->peakCpuBytes) st->peakCpuBytes = st->cpuBytes;
+        if (st->gpuBytes > st->peakGpuBytes) st->peakGpuBytes = st->gpuBytes;
+    }
+}
+
+static void resource_footprint(ResourceKind kind, const void *value, size_t *cpuBytes, size_t *gpuBytes);
+static void reserve_unload_slots(void);
+
+// The trailer of the userdata at `index`, or NULL if it was not created by
+// push_resource() for a struct of `size` bytes.
+static ResourceTrailer *get_trailer(lua_State *L, int index, size_t size) {
+    unsigned char *p = lua_touserdata(L, index);
+    if (p == NULL || lua_rawlen(L, index) != TRAILER_OFFSET(size) + sizeof(ResourceTrailer)) return NULL;
+    return (ResourceTrailer *)(p + TRAILER_OFFSET(size));
+}
+
+void *push_resource(lua_State *L, ResourceKind kind, const char *tname, const void *value) {
+    size_t size = resource_sizes[kind];
+    unsigned char *p = lua_newuserdatauv(L, TRAILER_OFFSET(size) + sizeof(ResourceTrailer), 2);
+    memcpy(p, value, size);
+    ResourceTrailer *trailer = (ResourceTrailer *)(p + TRAILER_OFFSET(size));
+    trailer->kind = (unsigned short)kind;
+    trailer->flags = RESOURCE_OWNED;
+    trailer->refs = 1;
+    trailer->managed = NULL;
+    resource_footprint(kind, value, &trailer->cpuBytes, &trailer->gpuBytes);
+    stats_add(kind, 1, (lua_Integer)trailer->cpuBytes, (lua_Integer)trailer->gpuBytes);
+    if (kind < RESOURCE_IMAGE) reserve_unload_slots();
+    luaL_setmetatable(L, tname);
+    return p;
+}
+
+// Stops counting the resource (it was unloaded or now belongs to another one).
+static void untrack(ResourceTrailer *trailer) {
+    if (trailer->flags & RESOURCE_OWNED)
+        stats_add((ResourceKind)trailer->kind, -1, -(lua_Integer)trailer->cpuBytes, -(lua_Integer)trailer->gpuBytes);
+    trailer->cpuBytes = trailer->gpuBytes = 0;
+}
+
+static void asset_cache_remove(lua_State *L, int index);
+static void unmanage_texture(ResourceTrailer *trailer);
+static void retrack_managed(ResourceTrailer *trailer);
+
+void retrack_resource(lua_State *L, int index, ResourceKind kind) {
+    ResourceTrailer *trailer = get_trailer(L, index, resource_sizes[kind]);
+    if (trailer == NULL || (trailer->flags & (RESOURCE_OWNED | RESOURCE_UNLOADED)) != RESOURCE_OWNED) return;
+    size_t cpuBytes, gpuBytes;
+    resource_footprint(kind, lua_touserdata(L, index), &cpuBytes, &gpuBytes);
+    stats_add(kind, 0, (lua_Integer)cpuBytes - (lua_Integer)trailer->cpuBytes,
+              (lua_Integer)gpuBytes - (lua_Integer)trailer->gpuBytes);
+    trailer->cpuBytes = cpuBytes;
+    trailer->gpuBytes = gpuBytes;
+    if (trailer->managed != NULL) retrack_managed(trailer);
+}
+
+
+int release_resource(lua_State *L, int index, size_t size) {
+    ResourceTrailer *trailer = get_trailer(L, index, size);
+    if (trailer == NULL) return 1;   // untracked handle: unload as always
+    if (trailer->flags & RESOURCE_PINNED)
+        return luaL_error(L, "this handle belongs to another object; release its owner instead");
+    if (trailer->flags & RESOURCE_UNLOADED) return 0;
+    if (trailer->refs > 1) {         // shared through the asset cache
+        trailer->refs--;
+        return 0;
+    }
+    untrack(trailer);
+    trailer->flags |= RESOURCE_UNLOADED;
+    if (trailer->managed != NULL) unmanage_texture(trailer);
+    if (trailer->flags & RESOURCE_CACHED) asset_cache_remove(L, index);
+    return (trailer->flags & RESOURCE_OWNED) != 0;
+}
+
+void pin_resource(lua_State *L, int index, size_t size, int pinned) {
+    ResourceTrailer *trailer = get_trailer(L, index, size);
+    if (trailer == NULL) return;
+    if (pinned) trailer->flags |= RESOURCE_PINNED;
+    else trailer->flags &= ~RESOURCE_PINNED;
+}
+
+int resource_unloaded(const void *resource, ResourceKind kind) {
+    const ResourceTrailer *trailer =
+        (const ResourceTrailer *)((const unsigned char *)resource + TRAILER_OFFSET(resource_sizes[kind]));
+    return (trailer->flags & RESOURCE_UNLOADED) != 0;
+}
+
+void disown_resource(lua_State *L, int index, size_t size) {
+    ResourceTrailer *trailer = get_trailer(L, index, size);
+    if (trailer == NULL) return;
+    untrack(trailer);   // now counted as part of its new owner
+    trailer->flags &= ~RESOURCE_OWNED;
+}
+
+// Estimated memory held by a resource: the CPU-side copy raylib keeps and
+// what it uploaded to the GPU. Texture sizes include the mip chain.
+static size_t texture_bytes(Texture2D texture) {
+    size_t bytes = 0;
+    int width = texture.width, height = texture.height;
+    for (int i = 0; i < (texture.mipmaps > 0 ? texture.mipmaps : 1); i++) {
+        bytes += (size_t)GetPixelDataSize(width, height, texture.format);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return bytes;
+}
+
+static size_t mesh_bytes(const Mesh *mesh) {
+    size_t floats = (mesh->vertices ? 3 : 0) + (mesh->texcoords ? 2 : 0) + (mesh->texcoords2 ? 2 : 0) +
+                    (mesh->normals ? 3 : 0) + (mesh->tangents ? 4 : 0);
+    size_t bytes = (size_t)mesh->vertexCount * (floats * sizeof(float) + (mesh->colors ? 4 : 0));
+    if (mesh->indices) bytes += (size_t)mesh->triangleCount * 3 * sizeof(unsigned short);
+    return bytes;
+}
+
+static size_t wave_bytes(unsigned int frameCount, unsigned int channels, unsigned int sampleSize) {
+    return (size_t)frameCount * channels * (sampleSize / 8);
+}
+
+static void resource_footprint(ResourceKind kind, const void *value, size_t *cpuBytes, size_t *gpuBytes) {
+    *cpuBytes = *gpuBytes = 0;
+    switch (kind) {
+        case RESOURCE_TEXTURE: *gpuBytes = texture_bytes(*(const Texture2D *)value); break;
+        case RESOURCE_RENDER_TEXTURE: {
+            const RenderTexture2D *target = value;
+            *gpuBytes = texture_bytes(target->texture) + (size_t)target->depth.width * (size_t)target->depth.height * 4;
+            break;
+        }
+        case RESOURCE_FONT: {
+            const Font *font = value;
+            *gpuBytes = texture_bytes(font->texture);
+            *cpuBytes = (size_t)font->glyphCount * (sizeof(GlyphInfo) + sizeof(Rectangle));
+            for (int i = 0; font->glyphs != NULL && i < font->glyphCount; i++) {
+                Image image = font->glyphs[i].image;
+                if (image.data != NULL) *cpuBytes += (size_t)GetPixelDataSize(image.width, image.height, image.format);
+            }
+            break;
+        }
+        case RESOURCE_SHADER:
+            if (((const Shader *)value)->locs != NULL) *cpuBytes = SHADER_LOCATION_BYTES;
+            break;
+        case RESOURCE_MESH: {
+            const Mesh *mesh = value;
+            *cpuBytes = mesh_bytes(mesh);
+            if (mesh->vaoId > 0 || mesh->vboId != NULL) *gpuBytes = *cpuBytes;
+            break;
+        }
+        case RESOURCE_MODEL: {
+            const Model *model = value;
+            *cpuBytes = (size_t)model->materialCount * sizeof(Material) +
+                        (size_t)model->skeleton.boneCount * (sizeof(BoneInfo) + sizeof(Transform) + sizeof(Matrix));
+            for (int i = 0; i < model->meshCount; i++) {
+                size_t bytes = mesh_bytes(&model->meshes[i]);
+                *cpuBytes += bytes;
+                if (model->meshes[i].vaoId > 0 || model->meshes[i].vboId != NULL) *gpuBytes += bytes;
+            }
+            break;
+        }
+        case RESOURCE_SOUND: {
+            const Sound *sound = value;
+            *cpuBytes = wave_bytes(sound->frameCount, sound->stream.channels, sound->stream.sampleSize);
+            break;
+        }
+        case RESOURCE_INSTANCE_BUFFER: {
+            const InstanceBuffer *buf = value;
+            size_t bytes = (size_t)buf->count * 16 * sizeof(float);
+            *cpuBytes = bytes + (size_t)(buf->count + INSTANCE_BUFFER_BLOCK - 1) / INSTANCE_BUFFER_BLOCK;
+            if (buf->vboId != 0) *gpuBytes = bytes;
+            break;
+        }
+        case RESOURCE_IMAGE: {
+            const Image *image = value;
+            if (image->data != NULL) *cpuBytes = texture_bytes((Texture2D){ 0, image->width, image->height, image->mipmaps, image->format });
+            break;
+        }
+        case RESOURCE_WAVE: {
+            const Wave *wave = value;
+            if (wave->data != NULL) *cpuBytes = wave_bytes(wave->frameCount, wave->channels, wave->sampleSize);
+            break;
+        }
+        default: break;   // aliases share their source's samples; music streams keep only a small ring
+    }
+}
+
+static int grow_unload_queue(int capacity) {
+    PendingUnload *queue = realloc(unload_queue, sizeof(PendingUnload) * (size_t)capacity);
+    if (queue == NULL) return 0;
+    unload_queue = queue;
+    unload_capacity = capacity;
+    return 1;
+}
+
+// Called whenever a finalizable resource is created, so a finalizer never has
+// to allocate: the queue keeps one slot for every counted resource of those
+// kinds, live or already queued.
+static void reserve_unload_slots(void) {
+    lua_Integer needed = 0;
+    for (int kind = 0; kind < RESOURCE_IMAGE; kind++) needed += resource_stats[kind].count;
+    if (needed <= unload_capacity) return;
+    int capacity = unload_capacity ? unload_capacity : 32;
+    while (capacity < needed) capacity *= 2;
+    if (!grow_unload_queue(capacity))
+        TraceLog(LOG_WARNING, "RESOURCES: Failed to reserve %d unload queue entries", capacity);
+}
+
+static void queue_unload(ResourceKind kind, const void *value, size_t cpuBytes, size_t gpuBytes) {
+    if (unload_count == unload_capacity && !grow_unload_queue(unload_capacity ? unload_capacity * 2 : 32)) {
+        // Only reachable if reserving failed earlier; the handle leaks, but
+        // stops being reported as live.
+        stats_add(kind, -1, -(lua_Integer)cpuBytes, -(lua_Integer)gpuBytes);
+        TraceLog(LOG_WARNING, "RESOURCES: Unload queue full, leaking a %s", resource_names[kind]);
+        return;
+    }
+    PendingUnload *entry = &unload_queue[unload_count++];
+    entry->kind = kind;
+    entry->cpuBytes = cpuBytes;
+    entry->gpuBytes = gpuBytes;
+    memcpy(&entry->as, value, resource_sizes[kind]);
+}
+
+int flush_unload_queue(void) {
+    // Without the window / audio device the handles died with it; the
+    // entries are simply dropped.
+    int gpu = IsWindowReady(), audio = IsAudioDeviceReady();
+    int unloaded = 0;
+    for (int i = 0; i < unload_count; i++) {
+        PendingUnload *e = &unload_queue[i];
+        stats_add(e->kind, -1, -(lua_Integer)e->cpuBytes, -(lua_Integer)e->gpuBytes);
+        if (e->kind == RESOURCE_INSTANCE_BUFFER) {   // its CPU copy is freed either way
+            unload_instance_buffer(&e->as.instanceBuffer, gpu);
+            unloaded++;
+            continue;
+        }
+        int ready = (e->kind == RESOURCE_SOUND || e->kind == RESOURCE_SOUND_ALIAS || e->kind == RESOURCE_MUSIC) ? audio : gpu;
+        if (!ready) continue;
+        switch (e->kind) {
+            case RESOURCE_TEXTURE:        UnloadTexture(e->as.texture); break;
+            case RESOURCE_RENDER_TEXTURE: UnloadRenderTexture(e->as.renderTexture); break;
+            case RESOURCE_FONT:           forget_text_layouts(&e->as.font); UnloadFont(e->as.font); break;
+            case RESOURCE_SHADER:         UnloadShader(e->as.shader); break;
+            case RESOURCE_MESH:           UnloadMesh(e->as.mesh); break;
+            case RESOURCE_MODEL:          UnloadModel(e->as.model); break;
+            case RESOURCE_SOUND:          detach_stream_feeds(&e->as.sound.stream); UnloadSound(e->as.sound); break;
+            case RESOURCE_SOUND_ALIAS:    detach_stream_feeds(&e->as.sound.stream); UnloadSoundAlias(e->as.sound); break;
+            case RESOURCE_MUSIC:          detach_stream_feeds(&e->as.music.stream); UnloadMusicStream(e->as.music); break;
+            default: continue;
+        }
+        unloaded++;
+    }
+    unload_count = 0;
+    return unloaded;
+}
+
+// __gc for every resource metatable; upvalue 1 is the struct size. Collection
+// means no reference is left, so a shared handle's count does not matter.
+static int resource_finalize(lua_State *L) {
+    size_t size = (size_t)lua_tointeger(L, lua_upvalueindex(1));
+    ResourceTrailer *trailer = get_trailer(L, 1, size);
+    if (trailer != NULL && (trailer->flags & (RESOURCE_OWNED | RESOURCE_UNLOADED)) == RESOURCE_OWNED) {
+        trailer->flags |= RESOURCE_UNLOADED;
+        if (trailer->managed != NULL) unmanage_texture(trailer);
+        queue_unload((ResourceKind)trailer->kind, lua_touserdata(L, 1), trailer->cpuBytes, trailer->gpuBytes);
+    }
+    return 0;
+}
+
+// __close (same upvalue): leaving a scope counts as one explicit Unload*, so
+// a handle shared through the asset cache only drops a reference until the
+// last one goes, and then leaves the cache before it is queued. A pinned
+// handle is left to its owner.
+static int resource_close(lua_State *L) {
+    size_t size = (size_t)lua_tointeger(L, lua_upvalueindex(1));
+    ResourceTrailer *trailer = get_trailer(L, 1, size);
+    if (trailer == NULL || (trailer->flags & (RESOURCE_OWNED | RESOURCE_UNLOADED | RESOURCE_PINNED)) != RESOURCE_OWNED) return 0;
+    if (trailer->refs > 1) {
+        trailer->refs--;
+        return 0;
+    }
+    if (trailer->flags & RESOURCE_CACHED) asset_cache_remove(L, 1);
+    return resource_finalize(L);
+}
+
+// ---------------------------------------------------------------------------
+// Texture VRAM budget
+// ---------------------------------------------------------------------------
+
+struct ManagedTexture {
+    ManagedTexture *prev;       // LRU list, most recently drawn first
+    ManagedTexture *next;
+    Texture2D *texture;         // inside the owning userdata; id is 0 while evicted
+    ResourceTrailer *trailer;
+    char *path;                 // reload source, or NULL when `image` is
+    Image image;
+    size_t bytes;               // VRAM while resident
+    unsigned int lastFrame;
+    int pinned;
+    int params[TEXTURE_PARAM_COUNT];   // settings replayed after a reload, -1 if never set
+};
+
+typedef struct TextureBudget {
+    size_t budget;              // 0: no new textures are managed, nothing is evicted
+    size_t residentBytes;
+    int managed;
+    int resident;
+    lua_Integer evictions;
+    lua_Integer reloads;
+    unsigned int frame;
+    ManagedTexture *head;
+    ManagedTexture *tail;
+} TextureBudget;
+
+// Process-wide: there is one GPU whichever state loaded the texture.
+static TextureBudget texture_budget;
+
+static void lru_unlink(ManagedTexture *m) {
+    if (m->prev) m->prev->next = m->next; else texture_budget.head = m->next;
+    if (m->next) m->next->prev = m->prev; else texture_budget.tail = m->prev;
+    m->prev = m->next = NULL;
+}
+
+static void lru_push_front(ManagedTexture *m) {
+    m->next = texture_budget.head;
+    if (texture_budget.head) texture_budget.head->prev = m; else texture_budget.tail = m;
+    texture_budget.head = m;
+}
+
+static void evict_texture(ManagedTexture *m) {
+    UnloadTexture(*m->texture);
+    m->texture->id = 0;
+    stats_add(RESOURCE_TEXTURE, 0, 0, -(lua_Integer)m->trailer->gpuBytes);
+    m->trailer->gpuBytes = 0;
+    texture_budget.residentBytes -= m->bytes;
+    texture_budget.resident--;
+    texture_budget.evictions++;
+}
+
+// Evicts from the cold end until the resident set fits, stopping at the
+// first texture drawn this frame (everything in front of it is newer).
+static void enforce_texture_budget(void) {
+    if (texture_budget.budget == 0 || !IsWindowReady()) return;
+    for (ManagedTexture *m = texture_budget.tail; m != NULL && texture_budget.residentBytes > texture_budget.budget; m = m->prev) {
+        if (m->lastFrame == texture_budget.frame) break;
+        if (!m->pinned && m->texture->id != 0) evict_texture(m);
+    }
+}
+
+static void reload_texture(ManagedTexture *m) {
+    Texture2D texture = (m->path != NULL) ? LoadTexture(m->path) : LoadTextureFromImage(m->image);
+    if (texture.id == 0) return;   // source gone: stays evicted, draws nothing
+    if (m->params[TEXTURE_PARAM_MIPMAPS] > 0) GenTextureMipmaps(&texture);
+    if (m->params[TEXTURE_PARAM_FILTER] >= 0) SetTextureFilter(texture, m->params[TEXTURE_PARAM_FILTER]);
+    if (m->params[TEXTURE_PARAM_WRAP] >= 0) SetTextureWrap(texture, m->params[TEXTURE_PARAM_WRAP]);
+    *m->texture = texture;
+    m->bytes = texture_bytes(texture);
+    m->trailer->gpuBytes = m->bytes;
+    stats_add(RESOURCE_TEXTURE, 0, 0, (lua_Integer)m->bytes);
+    texture_budget.residentBytes += m->bytes;
+    texture_budget.resident++;
+    texture_budget.reloads++;
+    enforce_texture_budget();
+}
+
+void manage_texture(lua_State *L, int index, int source) {
+    ResourceTrailer *trailer = get_trailer(L, index, sizeof(Texture2D));
+    Texture2D *texture = lua_touserdata(L, index);
+    if (texture_budget.budget == 0 || trailer == NULL || trailer->managed != NULL || texture->id == 0) return;
+    ManagedTexture *m = calloc(1, sizeof(ManagedTexture));
+    if (m == NULL) return;
+    if (lua_type(L, source) == LUA_TSTRING) {
+        const char *path = lua_tostring(L, source);
+        m->path = malloc(strlen(path) + 1);
+        if (m->path == NULL) {
+            free(m);
+            return;
+        }
+        strcpy(m->path, path);
+    } else {
+        m->image = ImageCopy(*(Image *)lua_touserdata(L, source));
+        size_t imageBytes, unused;
+        resource_footprint(RESOURCE_IMAGE, &m->image, &imageBytes, &unused);
+        trailer->cpuBytes += imageBytes;
+        stats_add(RESOURCE_TEXTURE, 0, (lua_Integer)imageBytes, 0);
+    }
+    m->texture = texture;
+    m->trailer = trailer;
+    m->bytes = texture_bytes(*texture);
+    m->lastFrame = texture_budget.frame;   // not evictable before its first draw
+    for (int i = 0; i < TEXTURE_PARAM_COUNT; i++) m->params[i] = -1;
+    trailer->managed = m;
+    lru_push_front(m);
+    texture_budget.managed++;
+    texture_budget.resident++;
+    texture_budget.residentBytes += m->bytes;
+    enforce_texture_budget();
+}
+
+// The texture grew or shrank in place (GenTextureMipmaps).
+static void retrack_managed(ResourceTrailer *trailer) {
+    ManagedTexture *m = trailer->managed;
+    if (m->texture->id == 0) return;
+    texture_budget.residentBytes += trailer->gpuBytes - m->bytes;
+    m->bytes = trailer->gpuBytes;
+}
+
+// Called once the texture is unloaded or queued; `m` goes away with it.
+static void unmanage_texture(ResourceTrailer *trailer) {
+    ManagedTexture *m = trailer->managed;
+    lru_unlink(m);
+    if (m->texture->id != 0) {
+        texture_budget.residentBytes -= m->bytes;
+        texture_budget.resident--;
+    }
+    texture_budget.managed--;
+    free(m->path);
+    if (m->image.data != NULL) UnloadImage(m->image);
+    free(m);
+    trailer->managed = NULL;
+}
+
+Texture2D *check_texture(lua_State *L, int index) {
+    Texture2D *texture = check_udata(L, index, Texture2D);
+    touch_texture(texture, texture_handle(L, index));
+    display_list_capture_texture(L, index);
+    return texture;
+}
+
+void *texture_handle(lua_State *L, int index) {
+    return get_trailer(L, index, sizeof(Texture2D));
+}
+
+void touch_texture(Texture2D *texture, void *handle) {
+    ResourceTrailer *trailer = handle;
+    ManagedTexture *m = (trailer != NULL) ? trailer->managed : NULL;
+    if (m == NULL) return;
+    m->lastFrame = texture_budget.frame;
+    if (texture_budget.head != m) {
+        lru_unlink(m);
+        lru_push_front(m);
+    }
+    if (texture->id == 0) reload_texture(m);
+}
+
+void pin_texture(lua_State *L, int index) {
+    ResourceTrailer *trailer = get_trailer(L, index, sizeof(Texture2D));
+    if (trailer != NULL && trailer->managed != NULL) trailer->managed->pinned = 1;
+}
+
+void remember_texture_param(lua_State *L, int index, TextureParam param, int value) {
+    ResourceTrailer *trailer = get_trailer(L, index, sizeof(Texture2D));
+    if (trailer != NULL && trailer->managed != NULL) trailer->managed->params[param] = value;
+}
+
+void texture_budget_end_frame(void) {
+    texture_budget.frame++;
+    enforce_texture_budget();
+}
+
+static int lua_SetTextureBudget(lua_State *L) {
+    lua_Integer bytes = luaL_checkinteger(L, 1);
+    luaL_argcheck(L, bytes >= 0, 1, "budget must be >= 0");
+    texture_budget.budget = (size_t)bytes;
+    enforce_texture_budget();
+    return 0;
+}
+
+static int lua_GetTextureBudgetStats(lua_State *L) {
+    lua_createtable(L, 0, 6);
+    lua_pushinteger(L, (lua_Integer)texture_budget.budget);
+    lua_setfield(L, -2, "budget");
+    lua_pushinteger(L, (lua_Integer)texture_budget.residentBytes);
+    lua_setfield(L, -2, "residentBytes");
+    lua_pushinteger(L, texture_budget.managed);
+    lua_setfield(L, -2, "managed");
+    lua_pushinteger(L, texture_budget.resident);
+    lua_setfield(L, -2, "resident");
+    lua_pushinteger(L, texture_budget.evictions);
+    lua_setfield(L, -2, "evictions");
+    lua_pushinteger(L, texture_budget.reloads);
+    lua_setfield(L, -2, "reloads");
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Asset cache
+// ---------------------------------------------------------------------------
+
+typedef struct AssetCache {
+    lua_Integer hits;
+    lua_Integer misses;
+    lua_Integer bytesSaved;
+} AssetCache;
+
+static const char asset_cache_key = 0;
+
+// Pushes the weak key -> resource table and returns the per-state counters.
+static AssetCache *get_asset_cache(lua_State *L) {
+    if (lua_rawgetp(L, LUA_REGISTRYINDEX, &asset_cache_key) == LUA_TNIL) {
+        lua_pop(L, 1);
+        AssetCache *cache = lua_newuserdatauv(L, sizeof(AssetCache), 1);
+        memset(cache, 0, sizeof(AssetCache));
+        lua_newtable(L);
+        lua_newtable(L);
+        lua_pushliteral(L, "v");
+        lua_setfield(L, -2, "__mode");
+        lua_setmetatable(L, -2);
+        lua_setiuservalue(L, -2, 1);
+        lua_pushvalue(L, -1);
+        lua_rawsetp(L, LUA_REGISTRYINDEX, &asset_cache_key);
+    }
+    AssetCache *cache = lua_touserdata(L, -1);
+    lua_getiuservalue(L, -1, 1);
+    lua_remove(L, -2);
+    return cache;
+}
+
+static int is_absolute_path(const char *path) {
+    return path[0] == '/' || path[0] == '\\' || (isalpha((unsigned char)path[0]) && path[1] == ':');
+}
+
+const char *push_asset_key(lua_State *L, const char *kind, const char *fileName, int param) {
+    // Resolve against the working directory (ChangeDirectory moves relative
+    // paths) and fold separators, "." and ".." so every spelling of a file
+    // maps to the same key. Purely textual: symlinks are not followed.
+    const char *base = is_absolute_path(fileName) ? "" : GetWorkingDirectory();
+    size_t length = strlen(base) + strlen(fileName) + 2;
+    char *path = scratch_alloc(L, length * 2);
+    char *out = path + length;
+    size_t used = 0;
+    snprintf(path, length, "%s/%s", base, fileName);
+    for (const char *segment = path; *segment != '\0';) {
+        size_t n = strcspn(segment, "/\\");
+        if (n == 2 && segment[0] == '.' && segment[1] == '.') {
+            while (used > 0 && out[--used] != '/') {}
+        } else if (n > 0 && !(n == 1 && segment[0] == '.')) {
+            out[used++] = '/';
+            memcpy(out + used, segment, n);
+            used += n;
+        }
+        segment += n;
+        if (*segment != '\0') segment++;
+    }
+    out[used] = '\0';
+    const char *key = (param >= 0) ? lua_pushfstring(L, "%s|%s|%d", kind, out, param)
+                                   : lua_pushfstring(L, "%s|%s", kind, out);
+    scratch_pop(L, path);
+    return key;
+}
+
+int asset_cache_lookup(lua_State *L, ResourceKind kind, const char *key) {
+    AssetCache *cache = get_asset_cache(L);
+    lua_getfield(L, -1, key);
+    ResourceTrailer *trailer = get_trailer(L, -1, resource_sizes[kind]);
+    if (trailer != NULL && !(trailer->flags & RESOURCE_UNLOADED)) {
+        trailer->refs++;
+        cache->hits++;
+        cache->bytesSaved += (lua_Integer)(trailer->cpuBytes + trailer->gpuBytes);
+        lua_remove(L, -2);
+        return 1;
+    }
+    cache->misses++;
+    lua_pop(L, 2);
+    return 0;
+}
+
+void asset_cache_insert(lua_State *L, ResourceKind kind, const char *key) {
+    ResourceTrailer *trailer = get_trailer(L, -1, resource_sizes[kind]);
+    if (trailer == NULL) return;
+    trailer->flags |= RESOURCE_CACHED;
+    lua_pushstring(L, key);
+    lua_setiuservalue(L, -2, 2);
+    get_asset_cache(L);
+    lua_pushvalue(L, -2);
+    lua_setfield(L, -2, key);
+    lua_pop(L, 1);
+}
+
+// Drops the entry for the resource at `index` once its last reference is gone.
+static void asset_cache_remove(lua_State *L, int index) {
+    index = lua_absindex(L, index);
+    if (lua_getiuservalue(L, index, 2) != LUA_TSTRING) {
+        lua_pop(L, 1);
+        return;
+    }
+    get_asset_cache(L);
+    lua_pushvalue(L, -2);
+    if (lua_rawget(L, -2) == LUA_TUSERDATA && lua_rawequal(L, -1, index)) {
+        lua_pushvalue(L, -3);
+        lua_pushnil(L);
+        lua_rawset(L, -4);
+    }
+    lua_pop(L, 3);
+}
+
+static int lua_GetAssetCacheStats(lua_State *L) {
+    AssetCache *cache = get_asset_cache(L);
+    lua_Integer entries = 0;
+    lua_pushnil(L);
+    while (lua_next(L, -2)) {
+        entries++;
+        lua_pop(L, 1);
+    }
+    lua_pop(L, 1);
+    lua_createtable(L, 0, 4);
+    lua_pushinteger(L, cache->hits);
+    lua_setfield(L, -2, "hits");
+    lua_pushinteger(L, cache->misses);
+    lua_setfield(L, -2, "misses");
+    lua_pushinteger(L, cache->bytesSaved);
+    lua_setfield(L, -2, "bytesSaved");
+    lua_pushinteger(L, entries);
+    lua_setfield(L, -2, "entries");
+    return 1;
+}
+
+static void push_stats(lua_State *L, const ResourceStats *st) {
+    lua_createtable(L, 0, 5);
+    lua_pushinteger(L, st->count);
+    lua_setfield(L, -2, "count");
+    lua_pushinteger(L, st->cpuBytes);
+    lua_setfield(L, -2, "cpuBytes");
+    lua_pushinteger(L, st->gpuBytes);
+    lua_setfield(L, -2, "gpuBytes");
+    lua_pushinteger(L, st->peakCpuBytes);
+    lua_setfield(L, -2, "peakCpuBytes");
+    lua_pushinteger(L, st->peakGpuBytes);
+    lua_setfield(L, -2, "peakGpuBytes");
+}
+
+// Per-kind live counts and byte estimates (queued-but-not-yet-flushed
+// resources still count), plus a "total" entry.
+static int lua_GetResourceStats(lua_State *L) {
+    lua_createtable(L, 0, RESOURCE_KIND_COUNT + 1);
+    for (int kind = 0; kind < RESOURCE_KIND_COUNT; kind++) {
+        push_stats(L, &resource_stats[kind]);
+        lua_setfield(L, -2, resource_names[kind]);
+    }
+    push_stats(L, &resource_stats[RESOURCE_KIND_COUNT]);
+    lua_setfield(L, -2, "total");
+    return 1;
+}
+
+static int lua_ResetResourcePeaks(lua_State *L) {
+    (void)L;
+    for (int kind = 0; kind <= RESOURCE_KIND_COUNT; kind++) {
+        resource_stats[kind].peakCpuBytes = resource_stats[kind].cpuBytes;
+        resource_stats[kind].peakGpuBytes = resource_stats[kind].gpuBytes;
+    }
+    return 0;
+}
+
+static int lua_FlushUnloadQueue(lua_State *L) {
+    lua_pushinteger(L, flush_unload_queue());
+    return 1;
+}
+
+static int lua_GetUnloadQueueSize(lua_State *L) {
+    lua_pushinteger(L, unload_count);
+    return 1;
+}
+
+static const luaL_Reg resource_functions[] = {
+    {"FlushUnloadQueue", lua_FlushUnloadQueue}, {"GetUnloadQueueSize", lua_GetUnloadQueueSize},
+    {"GetAssetCacheStats", lua_GetAssetCacheStats},
+    {"GetResourceStats", lua_GetResourceStats}, {"ResetResourcePeaks", lua_ResetResourcePeaks},
+    {"SetTextureBudget", lua_SetTextureBudget}, {"GetTextureBudgetStats", lua_GetTextureBudgetStats},
+    {NULL, NULL}
+};
+
+// Installs __gc/__close on the resource metatables (already created by
+// register_raylib_metatables, or register_commands for InstanceBuffer) and adds
+// the queue/cache functions onto the module table on top of the stack.
+void register_resources(lua_State *L) {
+    static const struct { const char *tname; size_t size; } managed[] = {
+        {"Texture2D", sizeof(Texture2D)}, {"TextureCubemap", sizeof(TextureCubemap)},
+        {"RenderTexture2D", sizeof(RenderTexture2D)}, {"Font", sizeof(Font)},
+        {"Shader", sizeof(Shader)}, {"Mesh", sizeof(Mesh)}, {"Model", sizeof(Model)},
+        {"Sound", sizeof(Sound)}, {"Music", sizeof(Music)},
+        {"InstanceBuffer", sizeof(InstanceBuffer)},
+    };
+    for (size_t i = 0; i < sizeof(managed) / sizeof(managed[0]); i++) {
+        luaL_getmetatable(L, managed[i].tname);
+        lua_pushinteger(L, (lua_Integer)managed[i].size);
+        lua_pushcclosure(L, resource_finalize, 1);
+        lua_setfield(L, -2, "__gc");
+        lua_pushinteger(L, (lua_Integer)managed[i].size);
+        lua_pushcclosure(L, resource_close, 1);
+        lua_setfield(L, -2, "__close");
+        lua_pop(L, 1);
+    }
+    luaL_setfuncs(L, resource_functions, 0);
+}
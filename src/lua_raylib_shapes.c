@@ -1,11 +1,13 @@
 #include <stdlib.h>
 #include "raylib_wrappers.h"
 #include "lua_raylib_shapes.h"
+#include "rlgl.h"
 
 int lua_SetShapesTexture(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     Rectangle source = get_rectangle_from_table(L, 2);
     SetShapesTexture(*texture, source);
+    pin_texture(L, 1);
     return 0;
 }
 
@@ -19,8 +21,7 @@ int lua_GetShapesTexture(lua_State *L) {
 
 int lua_GetShapesTextureRectangle(lua_State *L) {
     Rectangle rect = GetShapesTextureRectangle();
-    push_rectangle_to_table(L, rect);
-    return 1;
+    return return_rectangle(L, 1, rect);
 }
 
 int lua_DrawPixel(lua_State *L) {
@@ -125,52 +126,52 @@ int lua_DrawRectangleLinesEx(lua_State *L) {
 }
 
 int lua_DrawSplineLinear(lua_State *L) {
-    Vector2 *points = get_vector2_array_from_table(L, 1);
-    int pointCount = luaL_len(L, 1);
     float thick = luaL_checknumber(L, 2);
     Color color = get_color_from_table(L, 3);
+    int pointCount;
+    Vector2 *points = get_vector2_list(L, 1, &pointCount);
     DrawSplineLinear(points, pointCount, thick, color);
-    free(points);
+    release_vector2_list(L, 1, points);
     return 0;
 }
 
 int lua_DrawSplineBasis(lua_State *L) {
-    Vector2 *points = get_vector2_array_from_table(L, 1);
-    int pointCount = luaL_len(L, 1);
     float thick = luaL_checknumber(L, 2);
     Color color = get_color_from_table(L, 3);
+    int pointCount;
+    Vector2 *points = get_vector2_list(L, 1, &pointCount);
     DrawSplineBasis(points, pointCount, thick, color);
-    free(points);
+    release_vector2_list(L, 1, points);
     return 0;
 }
 
 int lua_DrawSplineCatmullRom(lua_State *L) {
-    Vector2 *points = get_vector2_array_from_table(L, 1);
-    int pointCount = luaL_len(L, 1);
     float thick = luaL_checknumber(L, 2);
     Color color = get_color_from_table(L, 3);
+    int pointCount;
+    Vector2 *points = get_vector2_list(L, 1, &pointCount);
     DrawSplineCatmullRom(points, pointCount, thick, color);
-    free(points);
+    release_vector2_list(L, 1, points);
     return 0;
 }
 
 int lua_DrawSplineBezierQuadratic(lua_State *L) {
-    Vector2 *points = get_vector2_array_from_table(L, 1);
-    int pointCount = luaL_len(L, 1);
     float thick = luaL_checknumber(L, 2);
     Color color = get_color_from_table(L, 3);
+    int pointCount;
+    Vector2 *points = get_vector2_list(L, 1, &pointCount);
     DrawSplineBezierQuadratic(points, pointCount, thick, color);
-    free(points);
+    release_vector2_list(L, 1, points);
     return 0;
 }
 
 int lua_DrawSplineBezierCubic(lua_State *L) {
-    Vector2 *points = get_vector2_array_from_table(L, 1);
-    int pointCount = luaL_len(L, 1);
     float thick = luaL_checknumber(L, 2);
     Color color = get_color_from_table(L, 3);
+    int pointCount;
+    Vector2 *points = get_vector2_list(L, 1, &pointCount);
     DrawSplineBezierCubic(points, pointCount, thick, color);
-    free(points);
+    release_vector2_list(L, 1, points);
     return 0;
 }
 
@@ -231,8 +232,7 @@ int lua_GetSplinePointLinear(lua_State *L) {
     Vector2 endPos = get_vector2_from_table(L, 2);
     float t = luaL_checknumber(L, 3);
     Vector2 point = GetSplinePointLinear(startPos, endPos, t);
-    push_vector2_to_table(L, point);
-    return 1;
+    return return_vector2(L, 4, point);
 }
 
 int lua_GetSplinePointBasis(lua_State *L) {
@@ -242,8 +242,7 @@ int lua_GetSplinePointBasis(lua_State *L) {
     Vector2 p4 = get_vector2_from_table(L, 4);
     float t = luaL_checknumber(L, 5);
     Vector2 point = GetSplinePointBasis(p1, p2, p3, p4, t);
-    push_vector2_to_table(L, point);
-    return 1;
+    return return_vector2(L, 6, point);
 }
 
 int lua_GetSplinePointCatmullRom(lua_State *L) {
@@ -253,8 +252,7 @@ int lua_GetSplinePointCatmullRom(lua_State *L) {
     Vector2 p4 = get_vector2_from_table(L, 4);
     float t = luaL_checknumber(L, 5);
     Vector2 point = GetSplinePointCatmullRom(p1, p2, p3, p4, t);
-    push_vector2_to_table(L, point);
-    return 1;
+    return return_vector2(L, 6, point);
 }
 
 int lua_GetSplinePointBezierQuad(lua_State *L) {
@@ -263,8 +261,7 @@ int lua_GetSplinePointBezierQuad(lua_State *L) {
     Vector2 p3 = get_vector2_from_table(L, 3);
     float t = luaL_checknumber(L, 4);
     Vector2 point = GetSplinePointBezierQuad(p1, c2, p3, t);
-    push_vector2_to_table(L, point);
-    return 1;
+    return return_vector2(L, 5, point);
 }
 
 int lua_GetSplinePointBezierCubic(lua_State *L) {
@@ -274,8 +271,7 @@ int lua_GetSplinePointBezierCubic(lua_State *L) {
     Vector2 p4 = get_vector2_from_table(L, 4);
     float t = luaL_checknumber(L, 5);
     Vector2 point = GetSplinePointBezierCubic(p1, c2, c3, p4, t);
-    push_vector2_to_table(L, point);
-    return 1;
+    return return_vector2(L, 6, point);
 }
 
 int lua_CheckCollisionRecs(lua_State *L) {
@@ -354,10 +350,10 @@ int lua_CheckCollisionPointLine(lua_State *L) {
 
 int lua_CheckCollisionPointPoly(lua_State *L) {
     Vector2 point = get_vector2_from_table(L, 1);
-    Vector2 *points = get_vector2_array_from_table(L, 2);
-    int pointCount = (int)luaL_len(L, 2);
+    int pointCount;
+    Vector2 *points = get_vector2_list(L, 2, &pointCount);
     bool result = CheckCollisionPointPoly(point, points, pointCount);
-    free(points);
+    release_vector2_list(L, 2, points);
     lua_pushboolean(L, result);
     return 1;
 }
@@ -370,14 +366,143 @@ int lua_CheckCollisionLines(lua_State *L) {
     Vector2 collisionPoint;
     bool result = CheckCollisionLines(startPos1, endPos1, startPos2, endPos2, &collisionPoint);
     lua_pushboolean(L, result);
-    push_vector2_to_table(L, collisionPoint);
-    return 2;
+    return 1 + return_vector2(L, 5, collisionPoint);
 }
 
 int lua_GetCollisionRec(lua_State *L) {
     Rectangle rec1 = get_rectangle_from_table(L, 1);
     Rectangle rec2 = get_rectangle_from_table(L, 2);
     Rectangle collisionRec = GetCollisionRec(rec1, rec2);
-    push_rectangle_to_table(L, collisionRec);
-    return 1;
+    return return_rectangle(L, 3, collisionRec);
+}
+
+// ---------------------------------------------------------------------------
+// Bulk shapes: many primitives per call from packed buffers
+// ---------------------------------------------------------------------------
+
+// Geometry for a bulk draw: a Vec3Array / Vec4Array used in place, or a flat
+// Lua array of numbers (`dims` per primitive) copied into the scratch arena.
+// Release with release_bulk_geometry.
+static const float *get_bulk_geometry(lua_State *L, int index, UdataType tag, const char *tname, int dims, int *count) {
+    PointArray *arr = test_udata_tag(L, index, tag, tname);
+    if (arr != NULL) {
+        *count = arr->count;
+        return arr->data;
+    }
+    if (!lua_istable(L, index)) luaL_typeerror(L, index, tname);
+    int len = (int)lua_rawlen(L, index);
+    if (len % dims != 0) luaL_argerror(L, index, lua_pushfstring(L, "number count must be a multiple of %d", dims));
+    float *data = scratch_alloc(L, sizeof(float) * (size_t)len);
+    for (int i = 0; i < len; i++) {
+        lua_rawgeti(L, index, i + 1);
+        data[i] = (float)luaL_checknumber(L, -1);
+        lua_pop(L, 1);
+    }
+    *count = len / dims;
+    return data;
+}
+
+static void release_bulk_geometry(lua_State *L, int index, UdataType tag, const char *tname, const float *data) {
+    if (test_udata_tag(L, index, tag, tname) == NULL) scratch_pop(L, (void *)data);
+}
+
+// Colors for a bulk draw of `count` primitives: one color (packed integer or
+// Color table) for all of them, or one each from a PixelBuffer (used in
+// place) or a Lua array of colors (copied into the scratch arena). Sets
+// *stride to 1, or 0 when the single color is repeated.
+static const Color *get_bulk_colors(lua_State *L, int index, int count, Color *single, int *stride) {
+    PixelBuffer *pb = test_udata(L, index, PixelBuffer);
+    if (pb != NULL) {
+        luaL_argcheck(L, pb->data != NULL, index, "PixelBuffer has been unloaded");
+        luaL_argcheck(L, (lua_Integer)pb->width * pb->height >= count, index, "fewer colors than primitives");
+        *stride = 1;
+        return pb->data;
+    }
+    if (lua_istable(L, index) && lua_rawlen(L, index) > 0) {
+        luaL_argcheck(L, lua_rawlen(L, index) >= (lua_Unsigned)count, index, "fewer colors than primitives");
+        Color *colors = scratch_alloc(L, sizeof(Color) * (size_t)count);
+        for (int i = 0; i < count; i++) {
+            lua_rawgeti(L, index, i + 1);
+            colors[i] = get_color_from_table(L, -1);
+            lua_pop(L, 1);
+        }
+        *stride = 1;
+        return colors;
+    }
+    *single = get_color_from_table(L, index);
+    *stride = 0;
+    return single;
+}
+
+static void release_bulk_colors(lua_State *L, const Color *colors, const Color *single, int index) {
+    if (colors != single && test_udata(L, index, PixelBuffer) == NULL) scratch_pop(L, (void *)colors);
+}
+
+int lua_DrawRectangles(lua_State *L) {
+    int count, stride;
+    Color single;
+    const float *r = get_bulk_geometry(L, 1, UDATA_Vec4Array, "Vec4Array", 4, &count);
+    const Color *colors = get_bulk_colors(L, 2, count, &single, &stride);
+    if (count > 0) {
+        // The quads DrawRectangleRec emits, in one batch with the shapes texture bound once.
+        Texture2D tex = GetShapesTexture();
+        Rectangle src = GetShapesTextureRectangle();
+        float u0 = src.x / tex.width, v0 = src.y / tex.height;
+        float u1 = (src.x + src.width) / tex.width, v1 = (src.y + src.height) / tex.height;
+        const Color *c = colors;
+        rlSetTexture(tex.id);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (int i = 0; i < count; i++, c += stride) {
+            float x = r[4*i], y = r[4*i + 1], w = r[4*i + 2], h = r[4*i + 3];
+            rlColor4ub(c->r, c->g, c->b, c->a);
+            rlTexCoord2f(u0, v0); rlVertex2f(x, y);
+            rlTexCoord2f(u0, v1); rlVertex2f(x, y + h);
+            rlTexCoord2f(u1, v1); rlVertex2f(x + w, y + h);
+            rlTexCoord2f(u1, v0); rlVertex2f(x + w, y);
+        }
+        rlEnd();
+        rlSetTexture(0);
+    }
+    release_bulk_colors(L, colors, &single, 2);
+    release_bulk_geometry(L, 1, UDATA_Vec4Array, "Vec4Array", r);
+    return 0;
+}
+
+int lua_DrawCircles(lua_State *L) {
+    int count, stride;
+    Color single;
+    const float *p = get_bulk_geometry(L, 1, UDATA_Vec3Array, "Vec3Array", 3, &count);
+    const Color *colors = get_bulk_colors(L, 2, count, &single, &stride);
+    const Color *c = colors;
+    for (int i = 0; i < count; i++, c += stride)
+        DrawCircleV((Vector2){ p[3*i], p[3*i + 1] }, p[3*i + 2], *c);
+    release_bulk_colors(L, colors, &single, 2);
+    release_bulk_geometry(L, 1, UDATA_Vec3Array, "Vec3Array", p);
+    return 0;
+}
+
+int lua_DrawLines(lua_State *L) {
+    int count, stride;
+    Color single;
+    const float *p = get_bulk_geometry(L, 1, UDATA_Vec4Array, "Vec4Array", 4, &count);
+    const Color *colors = get_bulk_colors(L, 2, count, &single, &stride);
+    float thick = (float)luaL_optnumber(L, 3, 0.0);
+    const Color *c = colors;
+    if (thick > 0.0f) {
+        for (int i = 0; i < count; i++, c += stride)
+            DrawLineEx((Vector2){ p[4*i], p[4*i + 1] }, (Vector2){ p[4*i + 2], p[4*i + 3] }, thick, *c);
+    } else if (count > 0) {
+        // The segments DrawLineV emits, in one RL_LINES batch.
+        rlBegin(RL_LINES);
+        for (int i = 0; i < count; i++, c += stride) {
+            rlColor4ub(c->r, c->g, c->b, c->a);
+            rlVertex2f(p[4*i], p[4*i + 1]);
+            rlVertex2f(p[4*i + 2], p[4*i + 3]);
+        }
+        rlEnd();
+    }
+    release_bulk_colors(L, colors, &single, 2);
+    release_bulk_geometry(L, 1, UDATA_Vec4Array, "Vec4Array", p);
+    return 0;
 }
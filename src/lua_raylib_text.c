@@ -2,6 +2,7 @@
 #include <string.h>
 #include "lua_raylib_text.h"
 #include "raylib_wrappers.h"
+#include "rlgl.h"
 #include "lauxlib.h"
 
 int lua_GetFontDefault(lua_State *L) {
@@ -14,10 +15,11 @@ int lua_GetFontDefault(lua_State *L) {
 
 int lua_LoadFont(lua_State *L) {
     const char *fileName = luaL_checkstring(L, 1);
+    const char *key = push_asset_key(L, "Font", fileName, -1);
+    if (asset_cache_lookup(L, RESOURCE_FONT, key)) return 1;
     Font font = LoadFont(fileName);
-    Font *pFont = lua_newuserdata(L, sizeof(Font));
-    *pFont = font;
-    luaL_setmetatable(L, "Font");
+    push_resource(L, RESOURCE_FONT, "Font", &font);
+    if (IsFontValid(font)) asset_cache_insert(L, RESOURCE_FONT, key);
     return 1;
 }
 
@@ -26,37 +28,31 @@ int lua_LoadFontEx(lua_State *L) {
     int fontSize = luaL_checkinteger(L, 2);
     int *codepoints = NULL;
     int codepointCount = 0;
+    const char *key = NULL;
 
     if (!lua_isnil(L, 3)) {
-        luaL_checktype(L, 3, LUA_TTABLE);
-        codepointCount = lua_rawlen(L, 3);
-        codepoints = (int *)malloc(sizeof(int) * codepointCount);
-
-        for (int i = 0; i < codepointCount; i++) {
-            lua_rawgeti(L, 3, i + 1);
-            codepoints[i] = luaL_checkinteger(L, -1);
-            lua_pop(L, 1);
-        }
+        codepoints = get_int_array_from_table(L, 3, &codepointCount);
+    } else {
+        // Only the default character set is shared; custom codepoint lists always load fresh.
+        key = push_asset_key(L, "Font", fileName, fontSize);
+        if (asset_cache_lookup(L, RESOURCE_FONT, key)) return 1;
     }
 
     Font font = LoadFontEx(fileName, fontSize, codepoints, codepointCount);
-    free(codepoints);
+    scratch_pop(L, codepoints);
 
-    Font *pFont = lua_newuserdata(L, sizeof(Font));
-    *pFont = font;
-    luaL_setmetatable(L, "Font");
+    push_resource(L, RESOURCE_FONT, "Font", &font);
+    if (key != NULL && IsFontValid(font)) asset_cache_insert(L, RESOURCE_FONT, key);
     return 1;
 }
 
 int lua_LoadFontFromImage(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Color key = get_color_from_table(L, 2);
     int firstChar = luaL_checkinteger(L, 3);
     Font font = LoadFontFromImage(*image, key, firstChar);
 
-    Font *pFont = lua_newuserdata(L, sizeof(Font));
-    *pFont = font;
-    luaL_setmetatable(L, "Font");
+    push_resource(L, RESOURCE_FONT, "Font", &font);
     return 1;
 }
 
@@ -69,40 +65,33 @@ int lua_LoadFontFromMemory(lua_State *L) {
     int codepointCount = 0;
 
     if (!lua_isnil(L, 4)) {
-        luaL_checktype(L, 4, LUA_TTABLE);
-        codepointCount = lua_rawlen(L, 4);
-        codepoints = (int *)malloc(sizeof(int) * codepointCount);
-
-        for (int i = 0; i < codepointCount; i++) {
-            lua_rawgeti(L, 4, i + 1);
-            codepoints[i] = luaL_checkinteger(L, -1);
-            lua_pop(L, 1);
-        }
+        codepoints = get_int_array_from_table(L, 4, &codepointCount);
     }
 
     Font font = LoadFontFromMemory(fileType, (unsigned char *)fileData, (int)dataSize, fontSize, codepoints, codepointCount);
-    free(codepoints);
+    scratch_pop(L, codepoints);
 
-    Font *pFont = lua_newuserdata(L, sizeof(Font));
-    *pFont = font;
-    luaL_setmetatable(L, "Font");
+    push_resource(L, RESOURCE_FONT, "Font", &font);
     return 1;
 }
 
 int lua_IsFontValid(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
+    Font *font = check_udata(L, 1, Font);
     lua_pushboolean(L, IsFontValid(*font));
     return 1;
 }
 
 int lua_UnloadFont(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
-    UnloadFont(*font);
+    Font *font = check_udata(L, 1, Font);
+    if (release_resource(L, 1, sizeof(Font))) {
+        forget_text_layouts(font);
+        UnloadFont(*font);
+    }
     return 0;
 }
 
 int lua_ExportFontAsCode(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
+    Font *font = check_udata(L, 1, Font);
     const char *fileName = luaL_checkstring(L, 2);
     lua_pushboolean(L, ExportFontAsCode(*font, fileName));
     return 1;
@@ -115,29 +104,308 @@ int lua_DrawFPS(lua_State *L) {
     return 0;
 }
 
+// ---------------------------------------------------------------------------
+// Glyph layout cache
+//
+// DrawText / DrawTextEx / DrawTextPro (and the CommandBuffer text commands)
+// look the string up by (font, text, size, spacing) in a process-wide cache
+// of pre-positioned glyph quads, built with the same math as raylib's
+// DrawTextEx + DrawTextCodepoint. A hit skips UTF-8 decoding and glyph lookup
+// entirely and emits the quads straight into the render batch. Entries sit on
+// an LRU list bounded by SetTextLayoutCacheSize; layouts of a font are dropped
+// when it is unloaded, and all of them when the line spacing changes or the
+// window closes.
+// ---------------------------------------------------------------------------
+
+#define TEXT_LAYOUT_DEFAULT_CAPACITY 1024
+
+typedef struct GlyphQuad {
+    float x0, y0, x1, y1;       // relative to the text position
+    float u0, v0, u1, v1;
+} GlyphQuad;
+
+typedef struct TextLayout TextLayout;
+struct TextLayout {
+    TextLayout *prev;           // LRU list, most recently drawn first
+    TextLayout *next;
+    TextLayout *chain;          // next entry in the same hash bucket
+    unsigned int hash;
+    const GlyphInfo *glyphs;    // identifies the font, with textureId and baseSize
+    unsigned int textureId;
+    int baseSize;
+    float fontSize;
+    float spacing;
+    size_t length;
+    int quadCount;
+    size_t bytes;               // the whole allocation
+    GlyphQuad *quads;           // follow the struct in the same allocation,
+    char *text;                 // then the text bytes
+};
+
+// One cache per process, like the GL context the font textures live in.
+static struct {
+    TextLayout **buckets;
+    int bucketCount;            // power of two, 0 until the first insert
+    int capacity;
+    int count;
+    size_t bytes;
+    TextLayout *head;
+    TextLayout *tail;
+    lua_Integer hits;
+    lua_Integer misses;
+    lua_Integer evictions;
+} layouts = { .capacity = TEXT_LAYOUT_DEFAULT_CAPACITY };
+
+// Tracks SetTextLineSpacing, which raylib does not let us read back.
+static int text_line_spacing = 2;
+
+static unsigned int layout_hash(Font font, const char *text, size_t length, float fontSize, float spacing) {
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < length; i++) h = (h ^ (unsigned char)text[i]) * 16777619u;
+    unsigned int key[4];
+    memcpy(&key[0], &fontSize, sizeof(float));
+    memcpy(&key[1], &spacing, sizeof(float));
+    key[2] = font.texture.id;
+    key[3] = (unsigned int)((size_t)font.glyphs >> 4);
+    for (int i = 0; i < 4; i++) h = (h ^ key[i]) * 16777619u;
+    return h;
+}
+
+static void layout_unlink_lru(TextLayout *e) {
+    if (e->prev) e->prev->next = e->next; else layouts.head = e->next;
+    if (e->next) e->next->prev = e->prev; else layouts.tail = e->prev;
+}
+
+static void layout_push_front(TextLayout *e) {
+    e->prev = NULL;
+    e->next = layouts.head;
+    if (layouts.head) layouts.head->prev = e; else layouts.tail = e;
+    layouts.head = e;
+}
+
+static void layout_remove(TextLayout *e) {
+    TextLayout **link = &layouts.buckets[e->hash & (unsigned int)(layouts.bucketCount - 1)];
+    while (*link != e) link = &(*link)->chain;
+    *link = e->chain;
+    layout_unlink_lru(e);
+    layouts.count--;
+    layouts.bytes -= e->bytes;
+    free(e);
+}
+
+static void layout_trim(int capacity) {
+    while (layouts.count > capacity) {
+        layout_remove(layouts.tail);
+        layouts.evictions++;
+    }
+}
+
+void forget_text_layouts(const Font *font) {
+    TextLayout *e = layouts.head;
+    while (e != NULL) {
+        TextLayout *next = e->next;
+        if (font == NULL || e->glyphs == font->glyphs) layout_remove(e);
+        e = next;
+    }
+}
+
+// Sizes the hash table for `capacity` entries (a power of two, at least 16)
+// and re-chains the entries already cached. Returns 0 if out of memory.
+static int layout_resize_buckets(int capacity) {
+    int bucketCount = 16;
+    while (bucketCount < capacity && bucketCount < (1 << 20)) bucketCount *= 2;
+    if (bucketCount == layouts.bucketCount) return 1;
+    TextLayout **buckets = calloc((size_t)bucketCount, sizeof(TextLayout *));
+    if (buckets == NULL) return 0;
+    for (TextLayout *e = layouts.head; e != NULL; e = e->next) {
+        TextLayout **bucket = &buckets[e->hash & (unsigned int)(bucketCount - 1)];
+        e->chain = *bucket;
+        *bucket = e;
+    }
+    free(layouts.buckets);
+    layouts.buckets = buckets;
+    layouts.bucketCount = bucketCount;
+    return 1;
+}
+
+// Walks `text` the way DrawTextEx does and writes one quad per visible glyph
+// to `out` (when not NULL); returns the quad count.
+static int layout_glyphs(Font font, const char *text, size_t length, float fontSize, float spacing, GlyphQuad *out) {
+    float scale = fontSize / (float)font.baseSize;
+    float pad = (float)font.glyphPadding;
+    float invWidth = 1.0f / (float)font.texture.width, invHeight = 1.0f / (float)font.texture.height;
+    float offsetX = 0.0f, offsetY = 0.0f;
+    int count = 0;
+    for (size_t i = 0; i < length;) {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(&text[i], &bytes);
+        int index = GetGlyphIndex(font, codepoint);
+        i += (size_t)bytes;
+        if (codepoint == '\n') {
+            offsetY += fontSize + (float)text_line_spacing;
+            offsetX = 0.0f;
+            continue;
+        }
+        Rectangle rec = font.recs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            if (out != NULL) {
+                GlyphQuad *q = &out[count];
+                q->x0 = offsetX + font.glyphs[index].offsetX * scale - pad * scale;
+                q->y0 = offsetY + font.glyphs[index].offsetY * scale - pad * scale;
+                q->x1 = q->x0 + (rec.width + 2.0f * pad) * scale;
+                q->y1 = q->y0 + (rec.height + 2.0f * pad) * scale;
+                q->u0 = (rec.x - pad) * invWidth;
+                q->v0 = (rec.y - pad) * invHeight;
+                q->u1 = (rec.x + rec.width + pad) * invWidth;
+                q->v1 = (rec.y + rec.height + pad) * invHeight;
+            }
+            count++;
+        }
+        if (font.glyphs[index].advanceX == 0) offsetX += rec.width * scale + spacing;
+        else offsetX += (float)font.glyphs[index].advanceX * scale + spacing;
+    }
+    return count;
+}
+
+// Finds the layout or builds and inserts it; NULL when the cache is disabled
+// or out of memory.
+static TextLayout *layout_get(Font font, const char *text, size_t length, float fontSize, float spacing) {
+    if (layouts.capacity == 0) return NULL;
+    unsigned int hash = layout_hash(font, text, length, fontSize, spacing);
+    if (layouts.buckets != NULL) {
+        for (TextLayout *e = layouts.buckets[hash & (unsigned int)(layouts.bucketCount - 1)]; e != NULL; e = e->chain) {
+            if (e->hash == hash && e->glyphs == font.glyphs && e->textureId == font.texture.id &&
+                e->baseSize == font.baseSize && e->fontSize == fontSize && e->spacing == spacing &&
+                e->length == length && memcmp(e->text, text, length) == 0) {
+                layouts.hits++;
+                if (e != layouts.head) {
+                    layout_unlink_lru(e);
+                    layout_push_front(e);
+                }
+                return e;
+            }
+        }
+    } else if (!layout_resize_buckets(layouts.capacity)) {
+        return NULL;
+    }
+    layouts.misses++;
+
+    int quadCount = layout_glyphs(font, text, length, fontSize, spacing, NULL);
+    size_t bytes = sizeof(TextLayout) + sizeof(GlyphQuad) * (size_t)quadCount + length;
+    TextLayout *e = malloc(bytes);
+    if (e == NULL) return NULL;
+    e->quads = (GlyphQuad *)(e + 1);
+    e->text = (char *)(e->quads + quadCount);
+    layout_glyphs(font, text, length, fontSize, spacing, e->quads);
+    memcpy(e->text, text, length);
+    e->hash = hash;
+    e->glyphs = font.glyphs;
+    e->textureId = font.texture.id;
+    e->baseSize = font.baseSize;
+    e->fontSize = fontSize;
+    e->spacing = spacing;
+    e->length = length;
+    e->quadCount = quadCount;
+    e->bytes = bytes;
+
+    TextLayout **bucket = &layouts.buckets[hash & (unsigned int)(layouts.bucketCount - 1)];
+    e->chain = *bucket;
+    *bucket = e;
+    layout_push_front(e);
+    layouts.count++;
+    layouts.bytes += bytes;
+    layout_trim(layouts.capacity);
+    return e;
+}
+
+void draw_text_cached(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint) {
+    if (font.texture.id == 0) font = GetFontDefault();   // as DrawTextEx
+    size_t length = strlen(text);
+    TextLayout *layout = layout_get(font, text, length, fontSize, spacing);
+    if (layout == NULL) {
+        DrawTextEx(font, text, position, fontSize, spacing, tint);
+        return;
+    }
+    if (layout->quadCount == 0) return;
+    rlSetTexture(font.texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    const GlyphQuad *q = layout->quads, *end = q + layout->quadCount;
+    for (; q < end; q++) {
+        float x0 = position.x + q->x0, y0 = position.y + q->y0;
+        float x1 = position.x + q->x1, y1 = position.y + q->y1;
+        rlTexCoord2f(q->u0, q->v0); rlVertex2f(x0, y0);
+        rlTexCoord2f(q->u0, q->v1); rlVertex2f(x0, y1);
+        rlTexCoord2f(q->u1, q->v1); rlVertex2f(x1, y1);
+        rlTexCoord2f(q->u1, q->v0); rlVertex2f(x1, y0);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void draw_text_default_cached(const char *text, int posX, int posY, int fontSize, Color color) {
+    Font font = GetFontDefault();
+    if (font.texture.id == 0) return;
+    if (fontSize < 10) fontSize = 10;   // DrawText's default font size floor and spacing
+    draw_text_cached(font, text, (Vector2){ (float)posX, (float)posY }, (float)fontSize, (float)(fontSize / 10), color);
+}
+
+int lua_SetTextLayoutCacheSize(lua_State *L) {
+    lua_Integer capacity = luaL_checkinteger(L, 1);
+    luaL_argcheck(L, capacity >= 0 && capacity <= 0x7fffffff, 1, "capacity out of range");
+    layouts.capacity = (int)capacity;
+    layout_trim(layouts.capacity);
+    if (layouts.count == 0) {           // sized for the new capacity on the next insert
+        free(layouts.buckets);
+        layouts.buckets = NULL;
+        layouts.bucketCount = 0;
+    } else {
+        layout_resize_buckets(layouts.capacity);   // on failure the old table still works
+    }
+    return 0;
+}
+
+int lua_GetTextLayoutCacheStats(lua_State *L) {
+    lua_createtable(L, 0, 6);
+    lua_pushinteger(L, layouts.hits);
+    lua_setfield(L, -2, "hits");
+    lua_pushinteger(L, layouts.misses);
+    lua_setfield(L, -2, "misses");
+    lua_pushinteger(L, layouts.evictions);
+    lua_setfield(L, -2, "evictions");
+    lua_pushinteger(L, layouts.count);
+    lua_setfield(L, -2, "entries");
+    lua_pushinteger(L, layouts.capacity);
+    lua_setfield(L, -2, "capacity");
+    lua_pushinteger(L, (lua_Integer)layouts.bytes);
+    lua_setfield(L, -2, "bytes");
+    return 1;
+}
+
 int lua_DrawText(lua_State *L) {
     const char *text = luaL_checkstring(L, 1);
     int posX = luaL_checkinteger(L, 2);
     int posY = luaL_checkinteger(L, 3);
     int fontSize = luaL_checkinteger(L, 4);
     Color color = get_color_from_table(L, 5);
-    DrawText(text, posX, posY, fontSize, color);
+    draw_text_default_cached(text, posX, posY, fontSize, color);
     return 0;
 }
 
 int lua_DrawTextEx(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
+    Font *font = check_udata(L, 1, Font);
     const char *text = luaL_checkstring(L, 2);
     Vector2 position = get_vector2_from_table(L, 3);
     float fontSize = luaL_checknumber(L, 4);
     float spacing = luaL_checknumber(L, 5);
     Color tint = get_color_from_table(L, 6);
-    DrawTextEx(*font, text, position, fontSize, spacing, tint);
+    draw_text_cached(*font, text, position, fontSize, spacing, tint);
     return 0;
 }
 
 int lua_DrawTextPro(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
+    Font *font = check_udata(L, 1, Font);
     const char *text = luaL_checkstring(L, 2);
     Vector2 position = get_vector2_from_table(L, 3);
     Vector2 origin = get_vector2_from_table(L, 4);
@@ -145,12 +413,18 @@ int lua_DrawTextPro(lua_State *L) {
     float fontSize = luaL_checknumber(L, 6);
     float spacing = luaL_checknumber(L, 7);
     Color tint = get_color_from_table(L, 8);
-    DrawTextPro(*font, text, position, origin, rotation, fontSize, spacing, tint);
+    // DrawTextPro's transform around a cached DrawTextEx at the origin
+    rlPushMatrix();
+    rlTranslatef(position.x, position.y, 0.0f);
+    rlRotatef(rotation, 0.0f, 0.0f, 1.0f);
+    rlTranslatef(-origin.x, -origin.y, 0.0f);
+    draw_text_cached(*font, text, (Vector2){ 0.0f, 0.0f }, fontSize, spacing, tint);
+    rlPopMatrix();
     return 0;
 }
 
 int lua_DrawTextCodepoint(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
+    Font *font = check_udata(L, 1, Font);
     int codepoint = luaL_checkinteger(L, 2);
     Vector2 position = get_vector2_from_table(L, 3);
     float fontSize = luaL_checknumber(L, 4);
@@ -160,16 +434,9 @@ int lua_DrawTextCodepoint(lua_State *L) {
 }
 
 int lua_DrawTextCodepoints(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
-    luaL_checktype(L, 2, LUA_TTABLE);
-    int codepointCount = lua_rawlen(L, 2);
-    int *codepoints = (int *)malloc(sizeof(int) * codepointCount);
-
-    for (int i = 0; i < codepointCount; i++) {
-        lua_rawgeti(L, 2, i + 1);
-        codepoints[i] = luaL_checkinteger(L, -1);
-        lua_pop(L, 1);
-    }
+    Font *font = check_udata(L, 1, Font);
+    int codepointCount;
+    int *codepoints = get_int_array_from_table(L, 2, &codepointCount);
 
     Vector2 position = get_vector2_from_table(L, 3);
     float fontSize = luaL_checknumber(L, 4);
@@ -178,13 +445,15 @@ int lua_DrawTextCodepoints(lua_State *L) {
 
     DrawTextCodepoints(*font, codepoints, codepointCount, position, fontSize, spacing, tint);
 
-    free(codepoints);
+    scratch_pop(L, codepoints);
     return 0;
 }
 
 int lua_SetTextLineSpacing(lua_State *L) {
     int spacing = luaL_checkinteger(L, 1);
     SetTextLineSpacing(spacing);
+    if (spacing != text_line_spacing) forget_text_layouts(NULL);   // multi-line layouts moved
+    text_line_spacing = spacing;
     return 0;
 }
 
@@ -196,24 +465,23 @@ int lua_MeasureText(lua_State *L) {
 }
 
 int lua_MeasureTextEx(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
+    Font *font = check_udata(L, 1, Font);
     const char *text = luaL_checkstring(L, 2);
     float fontSize = luaL_checknumber(L, 3);
     float spacing = luaL_checknumber(L, 4);
     Vector2 size = MeasureTextEx(*font, text, fontSize, spacing);
-    push_vector2_to_table(L, size);
-    return 1;
+    return return_vector2(L, 5, size);
 }
 
 int lua_GetGlyphIndex(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
+    Font *font = check_udata(L, 1, Font);
     int codepoint = luaL_checkinteger(L, 2);
     lua_pushinteger(L, GetGlyphIndex(*font, codepoint));
     return 1;
 }
 
 int lua_GetGlyphInfo(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
+    Font *font = check_udata(L, 1, Font);
     int codepoint = luaL_checkinteger(L, 2);
     GlyphInfo glyphInfo = GetGlyphInfo(*font, codepoint);
 
@@ -224,26 +492,18 @@ int lua_GetGlyphInfo(lua_State *L) {
 }
 
 int lua_GetGlyphAtlasRec(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
+    Font *font = check_udata(L, 1, Font);
     int codepoint = luaL_checkinteger(L, 2);
     Rectangle rec = GetGlyphAtlasRec(*font, codepoint);
-    push_rectangle_to_table(L, rec);
-    return 1;
+    return return_rectangle(L, 3, rec);
 }
 
 int lua_LoadUTF8(lua_State *L) {
-    luaL_checktype(L, 1, LUA_TTABLE);
-    int length = lua_rawlen(L, 1);
-    int *codepoints = malloc(sizeof(int) * length);
-
-    for (int i = 0; i < length; i++) {
-        lua_rawgeti(L, 1, i + 1);
-        codepoints[i] = luaL_checkinteger(L, -1);
-        lua_pop(L, 1);
-    }
+    int length;
+    int *codepoints = get_int_array_from_table(L, 1, &length);
 
     char *text = LoadUTF8(codepoints, length);
-    free(codepoints);
+    scratch_pop(L, codepoints);
     lua_pushstring(L, text);
     UnloadUTF8(text);
     return 1;
@@ -323,11 +583,11 @@ int lua_CodepointToUTF8(lua_State *L) {
 
 int lua_TextCopy(lua_State *L) {
     const char *src = luaL_checkstring(L, 1);
-    char *dst = malloc(strlen(src) + 1);
+    char *dst = scratch_alloc(L, strlen(src) + 1);
     int bytesCopied = TextCopy(dst, src);
     lua_pushstring(L, dst);
     lua_pushinteger(L, bytesCopied);
-    free(dst);
+    scratch_pop(L, dst);
     return 2;
 }
 
@@ -426,7 +686,7 @@ int lua_TextJoin(lua_State *L) {
     luaL_checktype(L, 1, LUA_TTABLE);
     const char *delimiter = luaL_checkstring(L, 2);
     int count = (int)lua_rawlen(L, 1);
-    char **textList = (char **)malloc(sizeof(char *) * count);
+    char **textList = (char **)scratch_alloc(L, sizeof(char *) * count);
 
     for (int i = 0; i < count; i++) {
         lua_rawgeti(L, 1, i + 1);
@@ -435,7 +695,7 @@ int lua_TextJoin(lua_State *L) {
     }
 
     lua_pushstring(L, TextJoin(textList, count, delimiter));
-    free(textList);
+    scratch_pop(L, textList);
     return 1;
 }
 
@@ -461,17 +721,14 @@ int lua_TextAppend(lua_State *L) {
     // Allocate buffer for appending
     size_t textLen = strlen(text);
     size_t appendLen = strlen(append);
-    char *buffer = malloc(textLen + appendLen + 1);
-    if (!buffer) {
-        return luaL_error(L, "Memory allocation failed for TextAppend");
-    }
+    char *buffer = scratch_alloc(L, textLen + appendLen + 1);
 
     strcpy(buffer, text);
     TextAppend(buffer, append, &position);
 
     lua_pushstring(L, buffer);
     lua_pushinteger(L, position);
-    free(buffer);
+    scratch_pop(L, buffer);
     return 2;
 }
 
@@ -551,19 +808,12 @@ int lua_LoadTextLines(lua_State *L) {
 }
 
 int lua_MeasureTextCodepoints(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
-    luaL_checktype(L, 2, LUA_TTABLE);
-    int length = (int)lua_rawlen(L, 2);
-    int *codepoints = (int *)malloc(sizeof(int) * length);
-    for (int i = 0; i < length; i++) {
-        lua_rawgeti(L, 2, i + 1);
-        codepoints[i] = luaL_checkinteger(L, -1);
-        lua_pop(L, 1);
-    }
+    Font *font = check_udata(L, 1, Font);
+    int length;
+    int *codepoints = get_int_array_from_table(L, 2, &length);
     float fontSize = (float)luaL_checknumber(L, 3);
     float spacing  = (float)luaL_checknumber(L, 4);
     Vector2 size = MeasureTextCodepoints(*font, codepoints, length, fontSize, spacing);
-    free(codepoints);
-    push_vector2_to_table(L, size);
-    return 1;
+    scratch_pop(L, codepoints);
+    return return_vector2(L, 5, size);
 }
\ No newline at end of file
@@ -1,89 +1,92 @@
+#include <math.h>
 #include "lua_raylib_textures.h"
 #include "raylib_wrappers.h"
+#include "rlgl.h"
 
 int lua_LoadImage(lua_State *L) {
     const char *fileName = luaL_checkstring(L, 1);
     Image image = LoadImage(fileName);
-    Image *pImage = lua_newuserdata(L, sizeof(Image));
-    *pImage = image;
-    luaL_setmetatable(L, "Image");
+    push_resource(L, RESOURCE_IMAGE, "Image", &image);
     return 1;
 }
 
 int lua_UnloadImage(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
-    UnloadImage(*image);
+    Image *image = check_udata(L, 1, Image);
+    if (release_resource(L, 1, sizeof(Image))) UnloadImage(*image);
     return 0;
 }
 
 int lua_LoadTexture(lua_State *L) {
     const char *fileName = luaL_checkstring(L, 1);
+    const char *key = push_asset_key(L, "Texture2D", fileName, -1);
+    if (asset_cache_lookup(L, RESOURCE_TEXTURE, key)) return 1;
     Texture2D texture = LoadTexture(fileName);
-    Texture2D *pTexture = lua_newuserdata(L, sizeof(Texture2D));
-    *pTexture = texture;
-    luaL_setmetatable(L, "Texture2D");
+    push_resource(L, RESOURCE_TEXTURE, "Texture2D", &texture);
+    if (IsTextureValid(texture)) asset_cache_insert(L, RESOURCE_TEXTURE, key);
+    manage_texture(L, -1, 1);
     return 1;
 }
 
 int lua_LoadTextureFromImage(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Texture2D texture = LoadTextureFromImage(*image);
-    Texture2D *pTexture = lua_newuserdata(L, sizeof(Texture2D));
-    *pTexture = texture;
-    luaL_setmetatable(L, "Texture2D");
+    push_resource(L, RESOURCE_TEXTURE, "Texture2D", &texture);
+    manage_texture(L, -1, 1);
     return 1;
 }
 
 int lua_UnloadTexture(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
-    UnloadTexture(*texture);
+    Texture2D *texture = check_udata(L, 1, Texture2D);
+    if (release_resource(L, 1, sizeof(Texture2D))) UnloadTexture(*texture);
     return 0;
 }
 
 int lua_UpdateTexture(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
-    const void *pixels = get_data_buffer(L, 2);
+    Texture2D *texture = check_texture(L, 1);
+    const void *pixels = get_pixel_data(L, 2, texture->format, texture->width * texture->height);
     UpdateTexture(*texture, pixels);
+    pin_texture(L, 1);   // a reload from the source would lose the update
     return 0;
 }
 
 int lua_GenTextureMipmaps(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     GenTextureMipmaps(texture);
+    retrack_resource(L, 1, RESOURCE_TEXTURE);
+    remember_texture_param(L, 1, TEXTURE_PARAM_MIPMAPS, 1);
     return 0;
 }
 
 int lua_ImageResize(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int width = luaL_checkinteger(L, 2);
     int height = luaL_checkinteger(L, 3);
     ImageResize(image, width, height);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageFlipHorizontal(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     ImageFlipHorizontal(image);
     return 0;
 }
 
 int lua_ImageFlipVertical(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     ImageFlipVertical(image);
     return 0;
 }
 
 int lua_ImageCopy(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Image copiedImage = ImageCopy(*image);
-    Image *pCopiedImage = lua_newuserdata(L, sizeof(Image));
-    *pCopiedImage = copiedImage;
-    luaL_setmetatable(L, "Image");
+    push_resource(L, RESOURCE_IMAGE, "Image", &copiedImage);
     return 1;
 }
 
 int lua_ImageCrop(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Rectangle cropRect = {
         luaL_checknumber(L, 2),
         luaL_checknumber(L, 3),
@@ -91,44 +94,45 @@ int lua_ImageCrop(lua_State *L) {
         luaL_checknumber(L, 5)
     };
     ImageCrop(image, cropRect);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageColorTint(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Color tint = get_color_from_table(L, 2);
     ImageColorTint(image, tint);
     return 0;
 }
 
 int lua_ImageColorInvert(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     ImageColorInvert(image);
     return 0;
 }
 
 int lua_ImageColorGrayscale(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     ImageColorGrayscale(image);
     return 0;
 }
 
 int lua_ImageColorBrightness(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int brightness = luaL_checkinteger(L, 2);
     ImageColorBrightness(image, brightness);
     return 0;
 }
 
 int lua_ImageColorContrast(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     float contrast = luaL_checknumber(L, 2);
     ImageColorContrast(image, contrast);
     return 0;
 }
 
 int lua_ImageColorReplace(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Color color = get_color_from_table(L, 2);
     Color replace = get_color_from_table(L, 3);
     ImageColorReplace(image, color, replace);
@@ -136,25 +140,24 @@ int lua_ImageColorReplace(lua_State *L) {
 }
 
 int lua_LoadTextureCubemap(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int layout = luaL_checkinteger(L, 2);
     TextureCubemap cubemap = LoadTextureCubemap(*image, layout);
-    TextureCubemap *pCubemap = lua_newuserdata(L, sizeof(TextureCubemap));
-    *pCubemap = cubemap;
-    luaL_setmetatable(L, "TextureCubemap");
+    push_resource(L, RESOURCE_TEXTURE, "TextureCubemap", &cubemap);
     return 1;
 }
 
 int lua_UpdateTextureRec(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     Rectangle rec = {
         luaL_checknumber(L, 2),
         luaL_checknumber(L, 3),
         luaL_checknumber(L, 4),
         luaL_checknumber(L, 5)
     };
-    const void *pixels = get_data_buffer(L, 6);
+    const void *pixels = get_pixel_data(L, 6, texture->format, (int)rec.width * (int)rec.height);
     UpdateTextureRec(*texture, rec, pixels);
+    pin_texture(L, 1);
     return 0;
 }
 
@@ -204,7 +207,7 @@ int lua_LoadImageFromMemory(lua_State *L) {
 }
 
 int lua_LoadImageFromTexture(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
 
     Image image = LoadImageFromTexture(*texture);
     push_image_to_userdata(L, image);
@@ -218,13 +221,13 @@ int lua_LoadImageFromScreen(lua_State *L) {
 }
 
 int lua_IsImageValid(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     lua_pushboolean(L, IsImageValid(*image));
     return 1;
 }
 
 int lua_ExportImage(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     const char *fileName = luaL_checkstring(L, 2);
 
     bool result = ExportImage(*image, fileName);
@@ -233,7 +236,7 @@ int lua_ExportImage(lua_State *L) {
 }
 
 int lua_ExportImageToMemory(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     const char *fileType = luaL_checkstring(L, 2);
     int fileSize;
 
@@ -249,7 +252,7 @@ int lua_ExportImageToMemory(lua_State *L) {
 }
 
 int lua_ExportImageAsCode(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     const char *fileName = luaL_checkstring(L, 2);
 
     bool result = ExportImageAsCode(*image, fileName);
@@ -350,7 +353,7 @@ int lua_GenImageText(lua_State *L) {
 }
 
 int lua_ImageFromImage(lua_State *L) {
-    Image *src = luaL_checkudata(L, 1, "Image");
+    Image *src = check_udata(L, 1, Image);
     Rectangle rect = get_rectangle_from_table(L, 2);
     Image image = ImageFromImage(*src, rect);
     push_image_to_userdata(L, image);
@@ -358,7 +361,7 @@ int lua_ImageFromImage(lua_State *L) {
 }
 
 int lua_ImageFromChannel(lua_State *L) {
-    Image *src = luaL_checkudata(L, 1, "Image");
+    Image *src = check_udata(L, 1, Image);
     int channel = luaL_checkinteger(L, 2);
     Image image = ImageFromChannel(*src, channel);
     push_image_to_userdata(L, image);
@@ -375,7 +378,7 @@ int lua_ImageText(lua_State *L) {
 }
 
 int lua_ImageTextEx(lua_State *L) {
-    Font *font = luaL_checkudata(L, 1, "Font");
+    Font *font = check_udata(L, 1, Font);
     const char *text = luaL_checkstring(L, 2);
     float fontSize = luaL_checknumber(L, 3);
     float spacing = luaL_checknumber(L, 4);
@@ -386,28 +389,31 @@ int lua_ImageTextEx(lua_State *L) {
 }
 
 int lua_ImageFormat(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int newFormat = luaL_checkinteger(L, 2);
     ImageFormat(image, newFormat);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageToPOT(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Color fill = get_color_from_table(L, 2);
     ImageToPOT(image, fill);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageAlphaCrop(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     float threshold = luaL_checknumber(L, 2);
     ImageAlphaCrop(image, threshold);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageAlphaClear(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Color color = get_color_from_table(L, 2);
     float threshold = luaL_checknumber(L, 3);
     ImageAlphaClear(image, color, threshold);
@@ -415,153 +421,161 @@ int lua_ImageAlphaClear(lua_State *L) {
 }
 
 int lua_ImageAlphaMask(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
-    Image *mask = luaL_checkudata(L, 2, "Image");
+    Image *image = check_udata(L, 1, Image);
+    Image *mask = check_udata(L, 2, Image);
     ImageAlphaMask(image, *mask);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageAlphaPremultiply(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     ImageAlphaPremultiply(image);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageBlurGaussian(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int blurSize = luaL_checkinteger(L, 2);
     ImageBlurGaussian(image, blurSize);
     return 0;
 }
 
 int lua_ImageKernelConvolution(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
-    luaL_checktype(L, 2, LUA_TTABLE);
-    int kernelSize = luaL_len(L, 2);
-    float *kernel = malloc(kernelSize * sizeof(float));
-    for (int i = 0; i < kernelSize; i++) {
-        lua_rawgeti(L, 2, i + 1);
-        kernel[i] = luaL_checknumber(L, -1);
-        lua_pop(L, 1);
-    }
+    Image *image = check_udata(L, 1, Image);
+    int kernelSize;
+    float *kernel = get_float_array_from_table(L, 2, &kernelSize);
     ImageKernelConvolution(image, kernel, kernelSize);
-    free(kernel);
+    scratch_pop(L, kernel);
     return 0;
 }
 
 int lua_ImageResizeNN(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int newWidth = luaL_checkinteger(L, 2);
     int newHeight = luaL_checkinteger(L, 3);
     ImageResizeNN(image, newWidth, newHeight);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageResizeCanvas(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int newWidth = luaL_checkinteger(L, 2);
     int newHeight = luaL_checkinteger(L, 3);
     int offsetX = luaL_checkinteger(L, 4);
     int offsetY = luaL_checkinteger(L, 5);
     Color fill = get_color_from_table(L, 6);
     ImageResizeCanvas(image, newWidth, newHeight, offsetX, offsetY, fill);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageMipmaps(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     ImageMipmaps(image);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageDither(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int rBpp = luaL_checkinteger(L, 2);
     int gBpp = luaL_checkinteger(L, 3);
     int bBpp = luaL_checkinteger(L, 4);
     int aBpp = luaL_checkinteger(L, 5);
     ImageDither(image, rBpp, gBpp, bBpp, aBpp);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageRotate(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int degrees = luaL_checkinteger(L, 2);
     ImageRotate(image, degrees);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageRotateCW(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     ImageRotateCW(image);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_ImageRotateCCW(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     ImageRotateCCW(image);
+    retrack_resource(L, 1, RESOURCE_IMAGE);
     return 0;
 }
 
 int lua_LoadImageColors(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Color *colors = LoadImageColors(*image);
-    lua_pushlightuserdata(L, colors);
+    push_pixel_buffer(L, colors, image->width, image->height);
     return 1;
 }
 
 int lua_LoadImagePalette(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int maxPaletteSize = luaL_checkinteger(L, 2);
     int colorCount;
     Color *palette = LoadImagePalette(*image, maxPaletteSize, &colorCount);
-    lua_pushlightuserdata(L, palette);
+    push_pixel_buffer(L, palette, colorCount, 1);
     lua_pushinteger(L, colorCount);
     return 2;
 }
 
-int lua_UnloadImageColors(lua_State *L) {
-    Color *colors = lua_touserdata(L, 1);
-    if (colors != NULL) {
-        UnloadImageColors(colors);
+// Releases a PixelBuffer early (its __gc then has nothing left to free); a
+// raw pointer from older code is still passed straight to raylib.
+static void unload_pixel_buffer(lua_State *L, int index) {
+    PixelBuffer *pb = test_udata(L, index, PixelBuffer);
+    if (pb != NULL) {
+        UnloadImageColors(pb->data);
+        pb->data = NULL;
+        pb->width = pb->height = 0;
+    } else if (lua_islightuserdata(L, index)) {
+        UnloadImageColors(lua_touserdata(L, index));
     }
+}
+
+int lua_UnloadImageColors(lua_State *L) {
+    unload_pixel_buffer(L, 1);
     return 0;
 }
 
 int lua_UnloadImagePalette(lua_State *L) {
-    Color *palette = lua_touserdata(L, 1);
-    if (palette != NULL) {
-        UnloadImagePalette(palette);
-    }
+    unload_pixel_buffer(L, 1);
     return 0;
 }
 
 int lua_GetImageAlphaBorder(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     float threshold = luaL_checknumber(L, 2);
     Rectangle border = GetImageAlphaBorder(*image, threshold);
-    push_rectangle_to_table(L, border);
-    return 1;
+    return return_rectangle(L, 3, border);
 }
 
 int lua_GetImageColor(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int x = luaL_checkinteger(L, 2);
     int y = luaL_checkinteger(L, 3);
     Color color = GetImageColor(*image, x, y);
-    push_color_to_table(L, color);
-    return 1;
+    return return_color(L, 4, color);
 }
 
 int lua_ImageClearBackground(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Color color = get_color_from_table(L, 2);
     ImageClearBackground(image, color);
     return 0;
 }
 
 int lua_ImageDrawPixel(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int posX = luaL_checkinteger(L, 2);
     int posY = luaL_checkinteger(L, 3);
     Color color = get_color_from_table(L, 4);
@@ -570,7 +584,7 @@ int lua_ImageDrawPixel(lua_State *L) {
 }
 
 int lua_ImageDrawPixelV(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Vector2 position = get_vector2_from_table(L, 2);
     Color color = get_color_from_table(L, 3);
     ImageDrawPixelV(image, position, color);
@@ -578,7 +592,7 @@ int lua_ImageDrawPixelV(lua_State *L) {
 }
 
 int lua_ImageDrawLine(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int startPosX = luaL_checkinteger(L, 2);
     int startPosY = luaL_checkinteger(L, 3);
     int endPosX = luaL_checkinteger(L, 4);
@@ -589,7 +603,7 @@ int lua_ImageDrawLine(lua_State *L) {
 }
 
 int lua_ImageDrawLineV(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Vector2 start = get_vector2_from_table(L, 2);
     Vector2 end = get_vector2_from_table(L, 3);
     Color color = get_color_from_table(L, 4);
@@ -598,7 +612,7 @@ int lua_ImageDrawLineV(lua_State *L) {
 }
 
 int lua_ImageDrawLineEx(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Vector2 start = get_vector2_from_table(L, 2);
     Vector2 end = get_vector2_from_table(L, 3);
     int thick = luaL_checkinteger(L, 4);
@@ -608,7 +622,7 @@ int lua_ImageDrawLineEx(lua_State *L) {
 }
 
 int lua_ImageDrawCircle(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     int centerX = luaL_checkinteger(L, 2);
     int centerY = luaL_checkinteger(L, 3);
     int radius = luaL_checkinteger(L, 4);
@@ -618,7 +632,7 @@ int lua_ImageDrawCircle(lua_State *L) {
 }
 
 int lua_ImageDrawCircleV(lua_State *L) {
-    Image *image = luaL_checkudata(L, 1, "Image");
+    Image *image = check_udata(L, 1, Image);
     Vector2 center = get_vector2_from_table(L, 2);
     int radius = luaL_checkinteger(L, 3);
     Color color = get_color_from_table(L, 4);
@@ -627,7 +641,7 @@ int lua_ImageDrawCircleV(lua_State *L) {
 }
 
 int lua_ImageDrawCircleLines(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
+    Image *dst = check_udata(L, 1, Image);
     int centerX = luaL_checkinteger(L, 2);
     int centerY = luaL_checkinteger(L, 3);
     int radius = luaL_checkinteger(L, 4);
@@ -637,7 +651,7 @@ int lua_ImageDrawCircleLines(lua_State *L) {
 }
 
 int lua_ImageDrawCircleLinesV(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
+    Image *dst = check_udata(L, 1, Image);
     Vector2 center = get_vector2_from_table(L, 2);
     int radius = luaL_checkinteger(L, 3);
     Color color = get_color_from_table(L, 4);
@@ -646,7 +660,7 @@ int lua_ImageDrawCircleLinesV(lua_State *L) {
 }
 
 int lua_ImageDrawRectangle(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
+    Image *dst = check_udata(L, 1, Image);
     int posX = luaL_checkinteger(L, 2);
     int posY = luaL_checkinteger(L, 3);
     int width = luaL_checkinteger(L, 4);
@@ -657,7 +671,7 @@ int lua_ImageDrawRectangle(lua_State *L) {
 }
 
 int lua_ImageDrawRectangleV(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
+    Image *dst = check_udata(L, 1, Image);
     Vector2 position = get_vector2_from_table(L, 2);
     Vector2 size = get_vector2_from_table(L, 3);
     Color color = get_color_from_table(L, 4);
@@ -666,7 +680,7 @@ int lua_ImageDrawRectangleV(lua_State *L) {
 }
 
 int lua_ImageDrawRectangleRec(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
+    Image *dst = check_udata(L, 1, Image);
     Rectangle rec = get_rectangle_from_table(L, 2);
     Color color = get_color_from_table(L, 3);
     ImageDrawRectangleRec(dst, rec, color);
@@ -674,7 +688,7 @@ int lua_ImageDrawRectangleRec(lua_State *L) {
 }
 
 int lua_ImageDrawRectangleLines(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
+    Image *dst = check_udata(L, 1, Image);
     Rectangle rec = get_rectangle_from_table(L, 2);
     int thick = luaL_checkinteger(L, 3);
     Color color = get_color_from_table(L, 4);
@@ -683,7 +697,7 @@ int lua_ImageDrawRectangleLines(lua_State *L) {
 }
 
 int lua_ImageDrawTriangle(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
+    Image *dst = check_udata(L, 1, Image);
     Vector2 v1 = get_vector2_from_table(L, 2);
     Vector2 v2 = get_vector2_from_table(L, 3);
     Vector2 v3 = get_vector2_from_table(L, 4);
@@ -693,7 +707,7 @@ int lua_ImageDrawTriangle(lua_State *L) {
 }
 
 int lua_ImageDrawTriangleEx(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
+    Image *dst = check_udata(L, 1, Image);
     Vector2 v1 = get_vector2_from_table(L, 2);
     Vector2 v2 = get_vector2_from_table(L, 3);
     Vector2 v3 = get_vector2_from_table(L, 4);
@@ -705,7 +719,7 @@ int lua_ImageDrawTriangleEx(lua_State *L) {
 }
 
 int lua_ImageDrawTriangleLines(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
+    Image *dst = check_udata(L, 1, Image);
     Vector2 v1 = get_vector2_from_table(L, 2);
     Vector2 v2 = get_vector2_from_table(L, 3);
     Vector2 v3 = get_vector2_from_table(L, 4);
@@ -715,38 +729,28 @@ int lua_ImageDrawTriangleLines(lua_State *L) {
 }
 
 int lua_ImageDrawTriangleFan(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
-    int count = luaL_len(L, 2);
-    Vector2 *points = malloc(count * sizeof(Vector2));
-    for (int i = 0; i < count; i++) {
-        lua_rawgeti(L, 2, i + 1);
-        points[i] = get_vector2_from_table(L, -1);
-        lua_pop(L, 1);
-    }
+    Image *dst = check_udata(L, 1, Image);
     Color color = get_color_from_table(L, 3);
+    int count;
+    Vector2 *points = get_vector2_list(L, 2, &count);
     ImageDrawTriangleFan(dst, points, count, color);
-    free(points);
+    release_vector2_list(L, 2, points);
     return 0;
 }
 
 int lua_ImageDrawTriangleStrip(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
-    int count = luaL_len(L, 2);
-    Vector2 *points = malloc(count * sizeof(Vector2));
-    for (int i = 0; i < count; i++) {
-        lua_rawgeti(L, 2, i + 1);
-        points[i] = get_vector2_from_table(L, -1);
-        lua_pop(L, 1);
-    }
+    Image *dst = check_udata(L, 1, Image);
     Color color = get_color_from_table(L, 3);
+    int count;
+    Vector2 *points = get_vector2_list(L, 2, &count);
     ImageDrawTriangleStrip(dst, points, count, color);
-    free(points);
+    release_vector2_list(L, 2, points);
     return 0;
 }
 
 int lua_ImageDraw(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
-    Image *src = luaL_checkudata(L, 2, "Image");
+    Image *dst = check_udata(L, 1, Image);
+    Image *src = check_udata(L, 2, Image);
     Rectangle srcRec = get_rectangle_from_table(L, 3);
     Rectangle dstRec = get_rectangle_from_table(L, 4);
     Color tint = get_color_from_table(L, 5);
@@ -755,7 +759,7 @@ int lua_ImageDraw(lua_State *L) {
 }
 
 int lua_ImageDrawText(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
+    Image *dst = check_udata(L, 1, Image);
     const char *text = luaL_checkstring(L, 2);
     int posX = luaL_checkinteger(L, 3);
     int posY = luaL_checkinteger(L, 4);
@@ -766,8 +770,8 @@ int lua_ImageDrawText(lua_State *L) {
 }
 
 int lua_ImageDrawTextEx(lua_State *L) {
-    Image *dst = luaL_checkudata(L, 1, "Image");
-    Font *font = luaL_checkudata(L, 2, "Font");
+    Image *dst = check_udata(L, 1, Image);
+    Font *font = check_udata(L, 2, Font);
     const char *text = luaL_checkstring(L, 3);
     Vector2 position = get_vector2_from_table(L, 4);
     float fontSize = luaL_checknumber(L, 5);
@@ -781,46 +785,46 @@ int lua_LoadRenderTexture(lua_State *L) {
     int width = luaL_checkinteger(L, 1);
     int height = luaL_checkinteger(L, 2);
     RenderTexture2D renderTexture = LoadRenderTexture(width, height);
-    RenderTexture2D *pRenderTexture = lua_newuserdata(L, sizeof(RenderTexture2D));
-    *pRenderTexture = renderTexture;
-    luaL_setmetatable(L, "RenderTexture2D");
+    push_resource(L, RESOURCE_RENDER_TEXTURE, "RenderTexture2D", &renderTexture);
     return 1;
 }
 
 int lua_IsTextureValid(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     lua_pushboolean(L, IsTextureValid(*texture));
     return 1;
 }
 
 int lua_IsRenderTextureValid(lua_State *L) {
-    RenderTexture2D *renderTexture = luaL_checkudata(L, 1, "RenderTexture2D");
+    RenderTexture2D *renderTexture = check_udata(L, 1, RenderTexture2D);
     lua_pushboolean(L, IsRenderTextureValid(*renderTexture));
     return 1;
 }
 
 int lua_UnloadRenderTexture(lua_State *L) {
-    RenderTexture2D *renderTexture = luaL_checkudata(L, 1, "RenderTexture2D");
-    UnloadRenderTexture(*renderTexture);
+    RenderTexture2D *renderTexture = check_udata(L, 1, RenderTexture2D);
+    if (release_resource(L, 1, sizeof(RenderTexture2D))) UnloadRenderTexture(*renderTexture);
     return 0;
 }
 
 int lua_SetTextureFilter(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     int filter = luaL_checkinteger(L, 2);
     SetTextureFilter(*texture, filter);
+    remember_texture_param(L, 1, TEXTURE_PARAM_FILTER, filter);
     return 0;
 }
 
 int lua_SetTextureWrap(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     int wrap = luaL_checkinteger(L, 2);
     SetTextureWrap(*texture, wrap);
+    remember_texture_param(L, 1, TEXTURE_PARAM_WRAP, wrap);
     return 0;
 }
 
 int lua_DrawTexture(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     int posX = luaL_checkinteger(L, 2);
     int posY = luaL_checkinteger(L, 3);
     Color color = get_color_from_table(L, 4);
@@ -829,7 +833,7 @@ int lua_DrawTexture(lua_State *L) {
 }
 
 int lua_DrawTextureV(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     Vector2 position = get_vector2_from_table(L, 2);
     Color color = get_color_from_table(L, 3);
     DrawTextureV(*texture, position, color);
@@ -837,7 +841,7 @@ int lua_DrawTextureV(lua_State *L) {
 }
 
 int lua_DrawTextureEx(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     Vector2 position = get_vector2_from_table(L, 2);
     float rotation = luaL_checknumber(L, 3);
     float scale = luaL_checknumber(L, 4);
@@ -847,7 +851,7 @@ int lua_DrawTextureEx(lua_State *L) {
 }
 
 int lua_DrawTextureRec(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     Rectangle source = get_rectangle_from_table(L, 2);
     Vector2 position = get_vector2_from_table(L, 3);
     Color color = get_color_from_table(L, 4);
@@ -856,7 +860,7 @@ int lua_DrawTextureRec(lua_State *L) {
 }
 
 int lua_DrawTexturePro(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     Rectangle source = get_rectangle_from_table(L, 2);
     Rectangle dest = get_rectangle_from_table(L, 3);
     Vector2 origin = get_vector2_from_table(L, 4);
@@ -866,8 +870,70 @@ int lua_DrawTexturePro(lua_State *L) {
     return 0;
 }
 
+// Same quads as DrawTexturePro, but the texture is bound and the batch opened
+// once for the whole range instead of once per sprite; rlVertex flushes the
+// batch on a quad boundary when it fills up.
+int lua_DrawTextureProBatch(lua_State *L) {
+    Texture2D *texture = check_texture(L, 1);
+    SpriteArray *sprites = check_udata(L, 2, SpriteArray);
+    lua_Integer first = luaL_optinteger(L, 3, 1);
+    luaL_argcheck(L, first >= 1 && first <= (lua_Integer)sprites->count + 1, 3, "first sprite out of range");
+    lua_Integer count = luaL_optinteger(L, 4, sprites->count - first + 1);
+    luaL_argcheck(L, count >= 0 && count <= sprites->count - first + 1, 4, "sprite count out of range");
+    if (texture->id == 0 || count == 0) return 0;
+
+    float invWidth = 1.0f / (float)texture->width;
+    float invHeight = 1.0f / (float)texture->height;
+    const SpriteInstance *s = sprites->data + (first - 1);
+    const SpriteInstance *end = s + count;
+
+    rlSetTexture(texture->id);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    for (; s < end; s++) {
+        Rectangle src = s->source;
+        float dw = fabsf(s->dest.width), dh = fabsf(s->dest.height);
+        if (src.height < 0) src.y -= src.height;
+
+        // Texture coordinates; a negative source width or height mirrors that axis.
+        float u0 = src.x * invWidth, u1 = (src.x + fabsf(src.width)) * invWidth;
+        float v0 = src.y * invHeight, v1 = (src.y + src.height) * invHeight;
+        if (src.width < 0) { float t = u0; u0 = u1; u1 = t; }
+
+        // Corners: top-left, bottom-left, bottom-right, top-right.
+        float x[4], y[4];
+        float dx = -s->origin.x, dy = -s->origin.y;
+        if (s->rotation == 0.0f) {
+            float left = s->dest.x + dx, top = s->dest.y + dy;
+            x[0] = left;      y[0] = top;
+            x[1] = left;      y[1] = top + dh;
+            x[2] = left + dw; y[2] = top + dh;
+            x[3] = left + dw; y[3] = top;
+        } else {
+            float sn = sinf(s->rotation * DEG2RAD), cs = cosf(s->rotation * DEG2RAD);
+            float ax = dx * cs, ay = dx * sn;                    // origin offset, rotated
+            float bx = -dy * sn, by = dy * cs;
+            float wx = dw * cs, wy = dw * sn;                    // width and height edges, rotated
+            float hx = -dh * sn, hy = dh * cs;
+            x[0] = s->dest.x + ax + bx; y[0] = s->dest.y + ay + by;
+            x[1] = x[0] + hx;           y[1] = y[0] + hy;
+            x[2] = x[1] + wx;           y[2] = y[1] + wy;
+            x[3] = x[0] + wx;           y[3] = y[0] + wy;
+        }
+
+        rlColor4ub(s->tint.r, s->tint.g, s->tint.b, s->tint.a);
+        rlTexCoord2f(u0, v0); rlVertex2f(x[0], y[0]);
+        rlTexCoord2f(u0, v1); rlVertex2f(x[1], y[1]);
+        rlTexCoord2f(u1, v1); rlVertex2f(x[2], y[2]);
+        rlTexCoord2f(u1, v0); rlVertex2f(x[3], y[3]);
+    }
+    rlEnd();
+    rlSetTexture(0);
+    return 0;
+}
+
 int lua_DrawTextureNPatch(lua_State *L) {
-    Texture2D *texture = luaL_checkudata(L, 1, "Texture2D");
+    Texture2D *texture = check_texture(L, 1);
     NPatchInfo nPatchInfo = get_npatchinfo_from_table(L, 2);
     Rectangle dest = get_rectangle_from_table(L, 3);
     Vector2 origin = get_vector2_from_table(L, 4);
@@ -888,8 +954,7 @@ int lua_Fade(lua_State *L) {
     Color color = get_color_from_table(L, 1);
     float alpha = luaL_checknumber(L, 2);
     Color fadedColor = Fade(color, alpha);
-    push_color_to_table(L, fadedColor);
-    return 1;
+    return return_color(L, 3, fadedColor);
 }
 
 int lua_ColorToInt(lua_State *L) {
@@ -902,22 +967,19 @@ int lua_ColorToInt(lua_State *L) {
 int lua_ColorNormalize(lua_State *L) {
     Color color = get_color_from_table(L, 1);
     Vector4 normalized = ColorNormalize(color);
-    push_vector4_to_table(L, normalized);
-    return 1;
+    return return_vector4(L, 2, normalized);
 }
 
 int lua_ColorFromNormalized(lua_State *L) {
     Vector4 normalized = get_vector4_from_table(L, 1);
     Color color = ColorFromNormalized(normalized);
-    push_color_to_table(L, color);
-    return 1;
+    return return_color(L, 2, color);
 }
 
 int lua_ColorToHSV(lua_State *L) {
     Color color = get_color_from_table(L, 1);
     Vector3 hsv = ColorToHSV(color);
-    push_vector3_to_table(L, hsv);
-    return 1;
+    return return_vector3(L, 2, hsv);
 }
 
 int lua_ColorFromHSV(lua_State *L) {
@@ -925,40 +987,35 @@ int lua_ColorFromHSV(lua_State *L) {
     float saturation = luaL_checknumber(L, 2);
     float value = luaL_checknumber(L, 3);
     Color color = ColorFromHSV(hue, saturation, value);
-    push_color_to_table(L, color);
-    return 1;
+    return return_color(L, 4, color);
 }
 
 int lua_ColorTint(lua_State *L) {
     Color color = get_color_from_table(L, 1);
     Color tint = get_color_from_table(L, 2);
     Color tintedColor = ColorTint(color, tint);
-    push_color_to_table(L, tintedColor);
-    return 1;
+    return return_color(L, 3, tintedColor);
 }
 
 int lua_ColorBrightness(lua_State *L) {
     Color color = get_color_from_table(L, 1);
     float factor = luaL_checknumber(L, 2);
     Color result = ColorBrightness(color, factor);
-    push_color_to_table(L, result);
-    return 1;
+    return return_color(L, 3, result);
 }
 
 int lua_ColorContrast(lua_State *L) {
     Color color = get_color_from_table(L, 1);
     float contrast = luaL_checknumber(L, 2);
     Color result = ColorContrast(color, contrast);
-    push_color_to_table(L, result);
-    return 1;
+    return return_color(L, 3, result);
 }
 
 int lua_ColorAlpha(lua_State *L) {
     Color color = get_color_from_table(L, 1);
     float alpha = luaL_checknumber(L, 2);
     Color result = ColorAlpha(color, alpha);
-    push_color_to_table(L, result);
-    return 1;
+    return return_color(L, 3, result);
 }
 
 int lua_ColorAlphaBlend(lua_State *L) {
@@ -966,8 +1023,7 @@ int lua_ColorAlphaBlend(lua_State *L) {
     Color src = get_color_from_table(L, 2);
     Color tint = get_color_from_table(L, 3);
     Color result = ColorAlphaBlend(dst, src, tint);
-    push_color_to_table(L, result);
-    return 1;
+    return return_color(L, 4, result);
 }
 
 int lua_ColorLerp(lua_State *L) {
@@ -975,29 +1031,109 @@ int lua_ColorLerp(lua_State *L) {
     Color color2 = get_color_from_table(L, 2);
     float factor = luaL_checknumber(L, 3);
     Color result = ColorLerp(color1, color2, factor);
-    push_color_to_table(L, result);
+    return return_color(L, 4, result);
+}
+
+// Packed-integer variants: same math as above, but the result is returned as a
+// 0xRRGGBBAA integer so hot draw loops never allocate a color table.
+
+int lua_FadeInt(lua_State *L) {
+    Color color = get_color_from_table(L, 1);
+    float alpha = luaL_checknumber(L, 2);
+    lua_pushinteger(L, pack_color(Fade(color, alpha)));
+    return 1;
+}
+
+int lua_ColorFromNormalizedInt(lua_State *L) {
+    Vector4 normalized = get_vector4_from_table(L, 1);
+    lua_pushinteger(L, pack_color(ColorFromNormalized(normalized)));
+    return 1;
+}
+
+int lua_ColorFromHSVInt(lua_State *L) {
+    float hue = luaL_checknumber(L, 1);
+    float saturation = luaL_checknumber(L, 2);
+    float value = luaL_checknumber(L, 3);
+    lua_pushinteger(L, pack_color(ColorFromHSV(hue, saturation, value)));
+    return 1;
+}
+
+int lua_ColorTintInt(lua_State *L) {
+    Color color = get_color_from_table(L, 1);
+    Color tint = get_color_from_table(L, 2);
+    lua_pushinteger(L, pack_color(ColorTint(color, tint)));
+    return 1;
+}
+
+int lua_ColorBrightnessInt(lua_State *L) {
+    Color color = get_color_from_table(L, 1);
+    float factor = luaL_checknumber(L, 2);
+    lua_pushinteger(L, pack_color(ColorBrightness(color, factor)));
+    return 1;
+}
+
+int lua_ColorContrastInt(lua_State *L) {
+    Color color = get_color_from_table(L, 1);
+    float contrast = luaL_checknumber(L, 2);
+    lua_pushinteger(L, pack_color(ColorContrast(color, contrast)));
+    return 1;
+}
+
+int lua_ColorAlphaInt(lua_State *L) {
+    Color color = get_color_from_table(L, 1);
+    float alpha = luaL_checknumber(L, 2);
+    lua_pushinteger(L, pack_color(ColorAlpha(color, alpha)));
+    return 1;
+}
+
+int lua_ColorAlphaBlendInt(lua_State *L) {
+    Color dst = get_color_from_table(L, 1);
+    Color src = get_color_from_table(L, 2);
+    Color tint = get_color_from_table(L, 3);
+    lua_pushinteger(L, pack_color(ColorAlphaBlend(dst, src, tint)));
+    return 1;
+}
+
+int lua_ColorLerpInt(lua_State *L) {
+    Color color1 = get_color_from_table(L, 1);
+    Color color2 = get_color_from_table(L, 2);
+    float factor = luaL_checknumber(L, 3);
+    lua_pushinteger(L, pack_color(ColorLerp(color1, color2, factor)));
     return 1;
 }
 
 int lua_GetColor(lua_State *L) {
     unsigned int hexValue = luaL_checkinteger(L, 1);
     Color result = GetColor(hexValue);
-    push_color_to_table(L, result);
-    return 1;
+    return return_color(L, 2, result);
+}
+
+// Resolves the pixel pointer for Get/SetPixelColor: a PixelBuffer is read in
+// place (its RGBA8 block must hold one pixel of `format`), anything else must
+// be a real light userdata pointer.
+static void *check_pixel_pointer(lua_State *L, int index, int format) {
+    PixelBuffer *pb = test_udata(L, index, PixelBuffer);
+    if (pb != NULL) {
+        luaL_argcheck(L, pb->data != NULL, index, "PixelBuffer has been unloaded");
+        luaL_argcheck(L, GetPixelDataSize(1, 1, format) <= (lua_Integer)pb->width * pb->height * (lua_Integer)sizeof(Color),
+                      index, "PixelBuffer too small for pixel format");
+        return pb->data;
+    }
+    luaL_checktype(L, index, LUA_TLIGHTUSERDATA);
+    return lua_touserdata(L, index);
 }
 
 int lua_GetPixelColor(lua_State *L) {
-    void *srcPtr = lua_touserdata(L, 1);
     int format = luaL_checkinteger(L, 2);
+    void *srcPtr = check_pixel_pointer(L, 1, format);
     Color result = GetPixelColor(srcPtr, format);
-    push_color_to_table(L, result);
-    return 1;
+    return return_color(L, 3, result);
 }
 
 int lua_SetPixelColor(lua_State *L) {
-    void *dstPtr = lua_touserdata(L, 1);
     Color color = get_color_from_table(L, 2);
     int format = luaL_checkinteger(L, 3);
+    void *dstPtr = check_pixel_pointer(L, 1, format);
     SetPixelColor(dstPtr, color, format);
     return 0;
 }
@@ -0,0 +1,919 @@
+// lua_raylib_types.c
+//
+// Native value types for the hot marshalling paths.
+//
+// A "Vector2" / "Vector3" / "Vector4" userdata stores the raylib struct
+// verbatim, so every binding that reads a vector through
+// get_vector*_from_table() copies it out after one type check instead of one
+// lua_getfield() per component. The plain {x=..., y=...} table form keeps
+// working everywhere. A "Matrix" userdata does the same for the 16-float
+// transform used by DrawMesh, SetShaderValueMatrix and DrawMeshInstanced.
+//
+// "Vec2Array" / "Vec3Array" hold whole point lists as packed C arrays, which
+// the strip, fan, spline and poly bindings use in place via
+// get_vector*_list(). "Vec4Array" packs rectangles and segments as four
+// floats each for the bulk shape bindings.
+//
+// A "PixelBuffer" owns an RGBA8 pixel block for CPU-side image work, and a
+// "SpriteArray" packs DrawTexturePro parameters for DrawTextureProBatch.
+//
+// A "SampleBuffer" owns interleaved PCM that UpdateAudioStream, UpdateSound
+// and AudioRing pushes upload without a per-sample conversion.
+//
+// Everything here is registered onto the module table by register_types(),
+// which is called from luaopen_raylib after luaL_newlib(). All wrapper
+// functions are static; only register_types() is exported.
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "raylib.h"
+#define RAYMATH_STATIC_INLINE
+#include "raymath.h"
+#include <lua.h>
+#include <lauxlib.h>
+#include "raylib_wrappers.h"
+
+// ---------------------------------------------------------------------------
+// Vector2 / Vector3 / Vector4 ("Vector2", "Vector3", "Vector4" userdata)
+// ---------------------------------------------------------------------------
+
+// Maps a single-character field name onto its float slot, or -1 if the key is
+// not one of the first `count` components of x, y, z, w.
+static int vector_slot(lua_State *L, int idx, int count) {
+    size_t len;
+    const char *key = (lua_type(L, idx) == LUA_TSTRING) ? lua_tolstring(L, idx, &len) : NULL;
+    if (key == NULL || len != 1) return -1;
+    int slot;
+    switch (key[0]) {
+        case 'x': slot = 0; break;
+        case 'y': slot = 1; break;
+        case 'z': slot = 2; break;
+        case 'w': slot = 3; break;
+        default: return -1;
+    }
+    return (slot < count) ? slot : -1;
+}
+
+static int vector_index(lua_State *L, UdataType tag, const char *tname, int count) {
+    float *v = (float *)check_udata_tag(L, 1, tag, tname);
+    int slot = vector_slot(L, 2, count);
+    if (slot < 0) lua_pushnil(L);
+    else lua_pushnumber(L, v[slot]);
+    return 1;
+}
+
+static int vector_newindex(lua_State *L, UdataType tag, const char *tname, int count) {
+    float *v = (float *)check_udata_tag(L, 1, tag, tname);
+    int slot = vector_slot(L, 2, count);
+    if (slot < 0) return luaL_error(L, "%s has no field '%s'", tname, luaL_tolstring(L, 2, NULL));
+    v[slot] = (float)luaL_checknumber(L, 3);
+    return 0;
+}
+
+static int vector_eq(lua_State *L, UdataType tag, const char *tname, int count) {
+    float *a = (float *)test_udata_tag(L, 1, tag, tname);
+    float *b = (float *)test_udata_tag(L, 2, tag, tname);
+    int equal = (a != NULL && b != NULL);
+    for (int i = 0; equal && i < count; i++) equal = (a[i] == b[i]);
+    lua_pushboolean(L, equal);
+    return 1;
+}
+
+static int lua_Vector2(lua_State *L) {
+    push_vector2_to_userdata(L, (Vector2){ (float)luaL_optnumber(L, 1, 0.0), (float)luaL_optnumber(L, 2, 0.0) });
+    return 1;
+}
+static int vector2_index(lua_State *L)    { return vector_index(L, UDATA_Vector2, "Vector2", 2); }
+static int vector2_newindex(lua_State *L) { return vector_newindex(L, UDATA_Vector2, "Vector2", 2); }
+static int vector2_eq(lua_State *L)       { return vector_eq(L, UDATA_Vector2, "Vector2", 2); }
+static int vector2_tostring(lua_State *L) {
+    Vector2 *v = check_udata(L, 1, Vector2);
+    lua_pushfstring(L, "Vector2(%f, %f)", (lua_Number)v->x, (lua_Number)v->y);
+    return 1;
+}
+
+static int lua_Vector3(lua_State *L) {
+    push_vector3_to_userdata(L, (Vector3){ (float)luaL_optnumber(L, 1, 0.0), (float)luaL_optnumber(L, 2, 0.0),
+                                           (float)luaL_optnumber(L, 3, 0.0) });
+    return 1;
+}
+static int vector3_index(lua_State *L)    { return vector_index(L, UDATA_Vector3, "Vector3", 3); }
+static int vector3_newindex(lua_State *L) { return vector_newindex(L, UDATA_Vector3, "Vector3", 3); }
+static int vector3_eq(lua_State *L)       { return vector_eq(L, UDATA_Vector3, "Vector3", 3); }
+static int vector3_tostring(lua_State *L) {
+    Vector3 *v = check_udata(L, 1, Vector3);
+    lua_pushfstring(L, "Vector3(%f, %f, %f)", (lua_Number)v->x, (lua_Number)v->y, (lua_Number)v->z);
+    return 1;
+}
+
+static int lua_Vector4(lua_State *L) {
+    push_vector4_to_userdata(L, (Vector4){ (float)luaL_optnumber(L, 1, 0.0), (float)luaL_optnumber(L, 2, 0.0),
+                                           (float)luaL_optnumber(L, 3, 0.0), (float)luaL_optnumber(L, 4, 0.0) });
+    return 1;
+}
+static int vector4_index(lua_State *L)    { return vector_index(L, UDATA_Vector4, "Vector4", 4); }
+static int vector4_newindex(lua_State *L) { return vector_newindex(L, UDATA_Vector4, "Vector4", 4); }
+static int vector4_eq(lua_State *L)       { return vector_eq(L, UDATA_Vector4, "Vector4", 4); }
+static int vector4_tostring(lua_State *L) {
+    Vector4 *v = check_udata(L, 1, Vector4);
+    lua_pushfstring(L, "Vector4(%f, %f, %f, %f)", (lua_Number)v->x, (lua_Number)v->y, (lua_Number)v->z, (lua_Number)v->w);
+    return 1;
+}
+
+static const luaL_Reg vector2_meta[] = {
+    {"__index", vector2_index}, {"__newindex", vector2_newindex},
+    {"__eq", vector2_eq}, {"__tostring", vector2_tostring},
+    {NULL, NULL}
+};
+static const luaL_Reg vector3_meta[] = {
+    {"__index", vector3_index}, {"__newindex", vector3_newindex},
+    {"__eq", vector3_eq}, {"__tostring", vector3_tostring},
+    {NULL, NULL}
+};
+static const luaL_Reg vector4_meta[] = {
+    {"__index", vector4_index}, {"__newindex", vector4_newindex},
+    {"__eq", vector4_eq}, {"__tostring", vector4_tostring},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// Matrix ("Matrix" userdata)
+//
+// Fields are exposed under the same "m0".."m15" names as the table form. The
+// raylib struct is laid out row by row (m0, m4, m8, m12, m1, ...), so field mN
+// lives at float offset (N % 4) * 4 + N / 4.
+// ---------------------------------------------------------------------------
+
+static int matrix_slot(lua_State *L, int idx) {
+    size_t len;
+    const char *key = (lua_type(L, idx) == LUA_TSTRING) ? lua_tolstring(L, idx, &len) : NULL;
+    if (key == NULL || len < 2 || len > 3 || key[0] != 'm') return -1;
+    int n = 0;
+    for (size_t i = 1; i < len; i++) {
+        if (key[i] < '0' || key[i] > '9') return -1;
+        n = n * 10 + (key[i] - '0');
+    }
+    if (n > 15 || (len == 3 && key[1] == '0')) return -1;
+    return (n % 4) * 4 + n / 4;
+}
+
+static int matrix_index(lua_State *L) {
+    float *m = (float *)check_udata(L, 1, Matrix);
+    int slot = matrix_slot(L, 2);
+    if (slot < 0) lua_pushnil(L);
+    else lua_pushnumber(L, m[slot]);
+    return 1;
+}
+
+static int matrix_newindex(lua_State *L) {
+    float *m = (float *)check_udata(L, 1, Matrix);
+    int slot = matrix_slot(L, 2);
+    if (slot < 0) return luaL_error(L, "Matrix has no field '%s'", luaL_tolstring(L, 2, NULL));
+    m[slot] = (float)luaL_checknumber(L, 3);
+    return 0;
+}
+
+static int matrix_eq(lua_State *L) {
+    return vector_eq(L, UDATA_Matrix, "Matrix", 16);
+}
+
+static int matrix_tostring(lua_State *L) {
+    Matrix *m = check_udata(L, 1, Matrix);
+    lua_pushfstring(L, "Matrix(%f, %f, %f, %f | %f, %f, %f, %f | %f, %f, %f, %f | %f, %f, %f, %f)",
+        (lua_Number)m->m0, (lua_Number)m->m4, (lua_Number)m->m8,  (lua_Number)m->m12,
+        (lua_Number)m->m1, (lua_Number)m->m5, (lua_Number)m->m9,  (lua_Number)m->m13,
+        (lua_Number)m->m2, (lua_Number)m->m6, (lua_Number)m->m10, (lua_Number)m->m14,
+        (lua_Number)m->m3, (lua_Number)m->m7, (lua_Number)m->m11, (lua_Number)m->m15);
+    return 1;
+}
+
+// Matrix([src]) — identity, or a copy of a Matrix userdata / {m0..m15} table.
+static int lua_Matrix(lua_State *L) {
+    if (lua_isnoneornil(L, 1)) push_matrix_to_userdata(L, MatrixIdentity());
+    else push_matrix_to_userdata(L, get_matrix_from_table(L, 1));
+    return 1;
+}
+
+static int lua_MatrixIdentity(lua_State *L) { return return_matrix(L, 1, MatrixIdentity()); }
+
+static int lua_MatrixTranslate(lua_State *L) {
+    float x = (float)luaL_checknumber(L, 1);
+    float y = (float)luaL_checknumber(L, 2);
+    float z = (float)luaL_checknumber(L, 3);
+    return return_matrix(L, 4, MatrixTranslate(x, y, z));
+}
+
+static int lua_MatrixScale(lua_State *L) {
+    float x = (float)luaL_checknumber(L, 1);
+    float y = (float)luaL_checknumber(L, 2);
+    float z = (float)luaL_checknumber(L, 3);
+    return return_matrix(L, 4, MatrixScale(x, y, z));
+}
+
+static int lua_MatrixRotate(lua_State *L) {
+    Vector3 axis = get_vector3_from_table(L, 1);
+    float angle = (float)luaL_checknumber(L, 2);
+    return return_matrix(L, 3, MatrixRotate(axis, angle));
+}
+
+static int lua_MatrixRotateX(lua_State *L) { return return_matrix(L, 2, MatrixRotateX((float)luaL_checknumber(L, 1))); }
+static int lua_MatrixRotateY(lua_State *L) { return return_matrix(L, 2, MatrixRotateY((float)luaL_checknumber(L, 1))); }
+static int lua_MatrixRotateZ(lua_State *L) { return return_matrix(L, 2, MatrixRotateZ((float)luaL_checknumber(L, 1))); }
+static int lua_MatrixRotateXYZ(lua_State *L) { return return_matrix(L, 2, MatrixRotateXYZ(get_vector3_from_table(L, 1))); }
+
+static int lua_MatrixMultiply(lua_State *L) {
+    Matrix left  = get_matrix_from_table(L, 1);
+    Matrix right = get_matrix_from_table(L, 2);
+    return return_matrix(L, 3, MatrixMultiply(left, right));
+}
+
+static int lua_MatrixInvert(lua_State *L)    { return return_matrix(L, 2, MatrixInvert(get_matrix_from_table(L, 1))); }
+static int lua_MatrixTranspose(lua_State *L) { return return_matrix(L, 2, MatrixTranspose(get_matrix_from_table(L, 1))); }
+
+static int lua_MatrixLookAt(lua_State *L) {
+    Vector3 eye    = get_vector3_from_table(L, 1);
+    Vector3 target = get_vector3_from_table(L, 2);
+    Vector3 up     = get_vector3_from_table(L, 3);
+    return return_matrix(L, 4, MatrixLookAt(eye, target, up));
+}
+
+static int lua_MatrixPerspective(lua_State *L) {
+    double fovY   = luaL_checknumber(L, 1);
+    double aspect = luaL_checknumber(L, 2);
+    double nearPlane = luaL_checknumber(L, 3);
+    double farPlane  = luaL_checknumber(L, 4);
+    return return_matrix(L, 5, MatrixPerspective(fovY, aspect, nearPlane, farPlane));
+}
+
+static int lua_MatrixOrtho(lua_State *L) {
+    double left   = luaL_checknumber(L, 1);
+    double right  = luaL_checknumber(L, 2);
+    double bottom = luaL_checknumber(L, 3);
+    double top    = luaL_checknumber(L, 4);
+    double nearPlane = luaL_checknumber(L, 5);
+    double farPlane  = luaL_checknumber(L, 6);
+    return return_matrix(L, 7, MatrixOrtho(left, right, bottom, top, nearPlane, farPlane));
+}
+
+static const luaL_Reg matrix_meta[] = {
+    {"__index", matrix_index}, {"__newindex", matrix_newindex},
+    {"__eq", matrix_eq}, {"__tostring", matrix_tostring},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// Vec2Array / Vec3Array / Vec4Array ("Vec2Array", "Vec3Array", "Vec4Array"
+// userdata, see PointArray)
+//
+// Indices are 1-based like Lua arrays. get/set move plain numbers so that a
+// per-point update loop never allocates.
+// ---------------------------------------------------------------------------
+
+static PointArray *check_point_array(lua_State *L, int idx) {
+    PointArray *arr = test_udata(L, idx, Vec2Array);
+    if (arr == NULL) arr = test_udata(L, idx, Vec3Array);
+    if (arr == NULL) arr = check_udata(L, idx, Vec4Array);
+    return arr;
+}
+
+static void point_array_reserve(lua_State *L, PointArray *arr, int capacity) {
+    if (capacity <= arr->capacity) return;
+    float *data = realloc(arr->data, sizeof(float) * arr->dims * (size_t)capacity);
+    if (data == NULL) luaL_error(L, "out of memory growing point array to %d points", capacity);
+    arr->data = data;
+    arr->capacity = capacity;
+}
+
+static void point_array_resize(lua_State *L, PointArray *arr, int count) {
+    if (count < 0) luaL_error(L, "point count must be non-negative");
+    point_array_reserve(L, arr, count);
+    if (count > arr->count)
+        memset(arr->data + (size_t)arr->count * arr->dims, 0, sizeof(float) * arr->dims * (size_t)(count - arr->count));
+    arr->count = count;
+}
+
+static int check_point_index(lua_State *L, PointArray *arr, int idx) {
+    lua_Integer i = luaL_checkinteger(L, idx);
+    luaL_argcheck(L, i >= 1 && i <= arr->count, idx, "point index out of range");
+    return (int)(i - 1);
+}
+
+// Reads one point at stack index `idx` — either dims numbers or a vector value.
+static void read_point(lua_State *L, PointArray *arr, int idx, float *dst) {
+    if (lua_type(L, idx) == LUA_TNUMBER) {
+        for (int c = 0; c < arr->dims; c++) dst[c] = (float)luaL_checknumber(L, idx + c);
+    } else if (arr->dims == 2) {
+        Vector2 v = get_vector2_from_table(L, idx);
+        dst[0] = v.x; dst[1] = v.y;
+    } else if (arr->dims == 3) {
+        Vector3 v = get_vector3_from_table(L, idx);
+        dst[0] = v.x; dst[1] = v.y; dst[2] = v.z;
+    } else {
+        Vector4 v = get_vector4_from_table(L, idx);
+        dst[0] = v.x; dst[1] = v.y; dst[2] = v.z; dst[3] = v.w;
+    }
+}
+
+// Vec2Array([n | points]) / Vec3Array(…) / Vec4Array(…): n zeroed points, or a copy
+// of a Lua array of vectors.
+static int new_point_array(lua_State *L, const char *tname, int dims) {
+    int fromTable = lua_istable(L, 1);
+    int n = fromTable ? (int)luaL_len(L, 1) : (int)luaL_optinteger(L, 1, 0);
+    PointArray *arr = lua_newuserdatauv(L, sizeof(PointArray), 0);
+    arr->count = 0; arr->capacity = 0; arr->dims = dims; arr->data = NULL;
+    luaL_setmetatable(L, tname);
+    point_array_resize(L, arr, n);
+    if (fromTable) {
+        for (int i = 0; i < n; i++) {
+            lua_rawgeti(L, 1, i + 1);
+            read_point(L, arr, lua_gettop(L), arr->data + (size_t)i * dims);
+            lua_pop(L, 1);
+        }
+    }
+    return 1;
+}
+static int lua_Vec2Array(lua_State *L) { return new_point_array(L, "Vec2Array", 2); }
+static int lua_Vec3Array(lua_State *L) { return new_point_array(L, "Vec3Array", 3); }
+static int lua_Vec4Array(lua_State *L) { return new_point_array(L, "Vec4Array", 4); }
+
+// arr:get(i) -> x, y[, z[, w]]
+static int point_array_get(lua_State *L) {
+    PointArray *arr = check_point_array(L, 1);
+    const float *p = arr->data + (size_t)check_point_index(L, arr, 2) * arr->dims;
+    for (int c = 0; c < arr->dims; c++) lua_pushnumber(L, p[c]);
+    return arr->dims;
+}
+
+// arr:set(i, x, y[, z[, w]]) or arr:set(i, vec)
+static int point_array_set(lua_State *L) {
+    PointArray *arr = check_point_array(L, 1);
+    int i = check_point_index(L, arr, 2);
+    read_point(L, arr, 3, arr->data + (size_t)i * arr->dims);
+    return 0;
+}
+
+// arr:push(x, y[, z[, w]]) or arr:push(vec) — appends, growing geometrically.
+static int point_array_push(lua_State *L) {
+    PointArray *arr = check_point_array(L, 1);
+    float p[4];
+    read_point(L, arr, 2, p);
+    if (arr->count == arr->capacity) point_array_reserve(L, arr, arr->capacity ? arr->capacity * 2 : 16);
+    memcpy(arr->data + (size_t)arr->count * arr->dims, p, sizeof(float) * arr->dims);
+    arr->count++;
+    return 0;
+}
+
+static int point_array_resize_m(lua_State *L) {
+    PointArray *arr = check_point_array(L, 1);
+    point_array_resize(L, arr, (int)luaL_checkinteger(L, 2));
+    return 0;
+}
+
+// Drops all points but keeps the storage for reuse.
+static int point_array_clear(lua_State *L) {
+    check_point_array(L, 1)->count = 0;
+    return 0;
+}
+
+static int point_array_len(lua_State *L) {
+    lua_pushinteger(L, check_point_array(L, 1)->count);
+    return 1;
+}
+
+static int point_array_gc(lua_State *L) {
+    PointArray *arr = check_point_array(L, 1);
+    free(arr->data);
+    arr->data = NULL;
+    arr->count = arr->capacity = 0;
+    return 0;
+}
+
+static const luaL_Reg point_array_methods[] = {
+    {"get", point_array_get}, {"set", point_array_set}, {"push", point_array_push},
+    {"resize", point_array_resize_m}, {"clear", point_array_clear},
+    {NULL, NULL}
+};
+static const luaL_Reg point_array_meta[] = {
+    {"__len", point_array_len}, {"__gc", point_array_gc},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// PixelBuffer ("PixelBuffer" userdata, see raylib_wrappers.h)
+//
+// An owned RGBA8 pixel block with its own dimensions. Pixels move in and out
+// as packed 0xRRGGBBAA integers, so a per-pixel effect loop never allocates.
+// UpdateTexture / UpdateTextureRec take it in place via get_pixel_data().
+// ---------------------------------------------------------------------------
+
+static PixelBuffer *check_pixel_buffer(lua_State *L, int idx) {
+    PixelBuffer *pb = check_udata(L, idx, PixelBuffer);
+    luaL_argcheck(L, pb->data != NULL, idx, "PixelBuffer has been unloaded");
+    return pb;
+}
+
+static int check_pixel_index(lua_State *L, PixelBuffer *pb, int idx) {
+    lua_Integer i = luaL_checkinteger(L, idx);
+    luaL_argcheck(L, i >= 1 && i <= (lua_Integer)pb->width * pb->height, idx, "pixel index out of range");
+    return (int)(i - 1);
+}
+
+// PixelBuffer(width, height[, color]) — filled with `color` (default blank).
+static int lua_PixelBuffer(lua_State *L) {
+    int width  = (int)luaL_checkinteger(L, 1);
+    int height = (int)luaL_checkinteger(L, 2);
+    luaL_argcheck(L, width > 0, 1, "width must be positive");
+    luaL_argcheck(L, height > 0 && (size_t)width * height <= 0x3FFFFFFF / sizeof(Color), 2, "invalid height");
+    Color fill = lua_isnoneornil(L, 3) ? BLANK : get_color_from_table(L, 3);
+    Color *data = MemAlloc((unsigned int)(sizeof(Color) * width * height));   // zeroed
+    if (data == NULL) return luaL_error(L, "out of memory allocating %dx%d PixelBuffer", width, height);
+    if (fill.r | fill.g | fill.b | fill.a)
+        for (int i = 0; i < width * height; i++) data[i] = fill;
+    push_pixel_buffer(L, data, width, height);
+    return 1;
+}
+
+// LoadImageFromPixelBuffer(pb) — a new RGBA8 Image holding a copy of the pixels.
+static int lua_LoadImageFromPixelBuffer(lua_State *L) {
+    PixelBuffer *pb = check_pixel_buffer(L, 1);
+    size_t size = sizeof(Color) * pb->width * pb->height;
+    Image image = { MemAlloc((unsigned int)size), pb->width, pb->height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    if (image.data == NULL) return luaL_error(L, "out of memory copying PixelBuffer");
+    memcpy(image.data, pb->data, size);
+    push_image_to_userdata(L, image);
+    return 1;
+}
+
+// pb:get(i) -> 0xRRGGBBAA (1-based, row-major)
+static int pixel_buffer_get(lua_State *L) {
+    PixelBuffer *pb = check_pixel_buffer(L, 1);
+    lua_pushinteger(L, pack_color(pb->data[check_pixel_index(L, pb, 2)]));
+    return 1;
+}
+
+// pb:set(i, color) — color is a packed integer or a Color table
+static int pixel_buffer_set(lua_State *L) {
+    PixelBuffer *pb = check_pixel_buffer(L, 1);
+    int i = check_pixel_index(L, pb, 2);
+    pb->data[i] = get_color_from_table(L, 3);
+    return 0;
+}
+
+static int pixel_buffer_fill(lua_State *L) {
+    PixelBuffer *pb = check_pixel_buffer(L, 1);
+    Color c = get_color_from_table(L, 2);
+    int n = pb->width * pb->height;
+    for (int i = 0; i < n; i++) pb->data[i] = c;
+    return 0;
+}
+
+// dst:blit(src, dx, dy) — copies src into dst with its top-left at pixel
+// (dx, dy), clipped to dst. Overlapping self-blits are handled row-wise.
+static int pixel_buffer_blit(lua_State *L) {
+    PixelBuffer *dst = check_pixel_buffer(L, 1);
+    PixelBuffer *src = check_pixel_buffer(L, 2);
+    int dx = (int)luaL_optinteger(L, 3, 0);
+    int dy = (int)luaL_optinteger(L, 4, 0);
+    int sx = dx < 0 ? -dx : 0, sy = dy < 0 ? -dy : 0;
+    int w = src->width - sx, h = src->height - sy;
+    if (dx + sx + w > dst->width)  w = dst->width - (dx + sx);
+    if (dy + sy + h > dst->height) h = dst->height - (dy + sy);
+    if (w <= 0 || h <= 0) return 0;
+    for (int row = 0; row < h; row++) {
+        int r = (dst == src && dy > 0) ? h - 1 - row : row;   // walk bottom-up when shifting down in place
+        memmove(dst->data + (size_t)(dy + sy + r) * dst->width + dx + sx,
+                src->data + (size_t)(sy + r) * src->width + sx, sizeof(Color) * w);
+    }
+    return 0;
+}
+
+static int pixel_buffer_len(lua_State *L) {
+    PixelBuffer *pb = check_udata(L, 1, PixelBuffer);
+    lua_pushinteger(L, (lua_Integer)pb->width * pb->height);
+    return 1;
+}
+
+// Methods first, then the read-only fields width / height / format.
+static int pixel_buffer_index(lua_State *L) {
+    PixelBuffer *pb = check_udata(L, 1, PixelBuffer);
+    lua_pushvalue(L, 2);
+    if (lua_rawget(L, lua_upvalueindex(1)) != LUA_TNIL) return 1;
+    const char *key = lua_tostring(L, 2);
+    if (key == NULL) return 1;
+    if (strcmp(key, "width") == 0) lua_pushinteger(L, pb->width);
+    else if (strcmp(key, "height") == 0) lua_pushinteger(L, pb->height);
+    else if (strcmp(key, "format") == 0) lua_pushinteger(L, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    else lua_pushnil(L);
+    return 1;
+}
+
+static int pixel_buffer_gc(lua_State *L) {
+    PixelBuffer *pb = check_udata(L, 1, PixelBuffer);
+    if (pb->data != NULL) UnloadImageColors(pb->data);
+    pb->data = NULL;
+    pb->width = pb->height = 0;
+    return 0;
+}
+
+static const luaL_Reg pixel_buffer_methods[] = {
+    {"get", pixel_buffer_get}, {"set", pixel_buffer_set},
+    {"fill", pixel_buffer_fill}, {"blit", pixel_buffer_blit},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// SampleBuffer ("SampleBuffer" userdata, see raylib_wrappers.h)
+//
+// An owned block of interleaved PCM with its own frame count, channel count
+// and sample format (32-bit float or 16-bit integer). Samples move in and out
+// as numbers in [-1, 1] whatever the format. UpdateAudioStream, UpdateSound
+// and AudioRing:push read it in place via get_sample_data().
+// ---------------------------------------------------------------------------
+
+static SampleBuffer *check_sample_buffer(lua_State *L, int idx) {
+    SampleBuffer *sb = check_udata(L, idx, SampleBuffer);
+    luaL_argcheck(L, sb->data != NULL, idx, "SampleBuffer has been unloaded");
+    return sb;
+}
+
+static size_t check_sample_index(lua_State *L, SampleBuffer *sb, int idx) {
+    lua_Integer i = luaL_checkinteger(L, idx);
+    luaL_argcheck(L, i >= 1 && i <= (lua_Integer)sb->frames * sb->channels, idx, "sample index out of range");
+    return (size_t)(i - 1);
+}
+
+static float read_sample(const SampleBuffer *sb, size_t i) {
+    if (sb->sampleSize == 16) return ((const short *)sb->data)[i] / 32767.0f;
+    return ((const float *)sb->data)[i];
+}
+
+static void write_sample(SampleBuffer *sb, size_t i, float v) {
+    if (sb->sampleSize == 16) {
+        if (v > 1.0f) v = 1.0f;
+        if (v < -1.0f) v = -1.0f;
+        ((short *)sb->data)[i] = (short)lrintf(v * 32767.0f);
+    } else {
+        ((float *)sb->data)[i] = v;
+    }
+}
+
+// SampleBuffer(frames, channels[, sampleSize]) — silent; sampleSize is 32
+// (float, the default) or 16 (signed integer).
+static int lua_SampleBuffer(lua_State *L) {
+    lua_Integer frames = luaL_checkinteger(L, 1);
+    lua_Integer channels = luaL_checkinteger(L, 2);
+    lua_Integer sampleSize = luaL_optinteger(L, 3, 32);
+    luaL_argcheck(L, channels >= 1 && channels <= 8, 2, "channels out of range");
+    luaL_argcheck(L, sampleSize == 16 || sampleSize == 32, 3, "sampleSize must be 16 or 32");
+    luaL_argcheck(L, frames > 0 && frames * channels * (sampleSize / 8) <= 0x3FFFFFFF, 1, "invalid frame count");
+    void *data = MemAlloc((unsigned int)(frames * channels * (sampleSize / 8)));   // zeroed
+    if (data == NULL) return luaL_error(L, "out of memory allocating a %d-frame SampleBuffer", (int)frames);
+    push_sample_buffer(L, data, (int)frames, (int)channels, (int)sampleSize);
+    return 1;
+}
+
+// LoadWaveFromSamples(sb, sampleRate) — a new Wave holding a copy of the samples.
+static int lua_LoadWaveFromSamples(lua_State *L) {
+    SampleBuffer *sb = check_sample_buffer(L, 1);
+    lua_Integer sampleRate = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, sampleRate > 0, 2, "sampleRate must be positive");
+    size_t size = (size_t)sb->frames * sb->channels * (sb->sampleSize / 8);
+    Wave wave = { (unsigned int)sb->frames, (unsigned int)sampleRate, (unsigned int)sb->sampleSize,
+                  (unsigned int)sb->channels, MemAlloc((unsigned int)size) };
+    if (wave.data == NULL) return luaL_error(L, "out of memory copying SampleBuffer");
+    memcpy(wave.data, sb->data, size);
+    push_resource(L, RESOURCE_WAVE, "Wave", &wave);
+    return 1;
+}
+
+// sb:get(i) -> sample in [-1, 1] (1-based, interleaved)
+static int sample_buffer_get(lua_State *L) {
+    SampleBuffer *sb = check_sample_buffer(L, 1);
+    lua_pushnumber(L, read_sample(sb, check_sample_index(L, sb, 2)));
+    return 1;
+}
+
+// sb:set(i, v) — 16-bit buffers clip v to [-1, 1]
+static int sample_buffer_set(lua_State *L) {
+    SampleBuffer *sb = check_sample_buffer(L, 1);
+    size_t i = check_sample_index(L, sb, 2);
+    write_sample(sb, i, (float)luaL_checknumber(L, 3));
+    return 0;
+}
+
+// sb:setRange(first, values) — writes a Lua array of samples from index `first`
+static int sample_buffer_set_range(lua_State *L) {
+    SampleBuffer *sb = check_sample_buffer(L, 1);
+    size_t first = check_sample_index(L, sb, 2);
+    luaL_checktype(L, 3, LUA_TTABLE);
+    lua_Integer n = luaL_len(L, 3);
+    luaL_argcheck(L, (lua_Integer)first + n <= (lua_Integer)sb->frames * sb->channels, 3, "range past the end of the buffer");
+    for (lua_Integer k = 0; k < n; k++) {
+        lua_rawgeti(L, 3, k + 1);
+        write_sample(sb, first + (size_t)k, (float)luaL_checknumber(L, -1));
+        lua_pop(L, 1);
+    }
+    return 0;
+}
+
+// sb:fill(v[, firstFrame, frames]) — every channel of the given frames
+static int sample_buffer_fill(lua_State *L) {
+    SampleBuffer *sb = check_sample_buffer(L, 1);
+    float v = (float)luaL_checknumber(L, 2);
+    lua_Integer first = luaL_optinteger(L, 3, 1);
+    lua_Integer count = luaL_optinteger(L, 4, sb->frames - first + 1);
+    luaL_argcheck(L, first >= 1 && count >= 0 && first - 1 + count <= sb->frames, 4, "range past the end of the buffer");
+    for (size_t i = (size_t)(first - 1) * sb->channels; i < (size_t)(first - 1 + count) * sb->channels; i++)
+        write_sample(sb, i, v);
+    return 0;
+}
+
+// sb:sine(freq, sampleRate[, amplitude, phase]) -> next phase. Writes a sine
+// wave into every channel, starting at `phase` radians, so consecutive calls
+// continue the tone without a click.
+static int sample_buffer_sine(lua_State *L) {
+    SampleBuffer *sb = check_sample_buffer(L, 1);
+    double freq = luaL_checknumber(L, 2);
+    double sampleRate = luaL_checknumber(L, 3);
+    double amplitude = luaL_optnumber(L, 4, 1.0);
+    double phase = luaL_optnumber(L, 5, 0.0);
+    luaL_argcheck(L, sampleRate > 0, 3, "sampleRate must be positive");
+    double step = 2.0 * PI * freq / sampleRate;
+    for (int f = 0; f < sb->frames; f++) {
+        float v = (float)(sin(phase) * amplitude);
+        for (int c = 0; c < sb->channels; c++) write_sample(sb, (size_t)f * sb->channels + c, v);
+        phase += step;
+        if (phase >= 2.0 * PI) phase -= 2.0 * PI;
+    }
+    lua_pushnumber(L, phase);
+    return 1;
+}
+
+// dst:mix(src[, gain]) — adds gain * src (same channel count, any format)
+// into dst over the frames both hold
+static int sample_buffer_mix(lua_State *L) {
+    SampleBuffer *dst = check_sample_buffer(L, 1);
+    SampleBuffer *src = check_sample_buffer(L, 2);
+    float gain = (float)luaL_optnumber(L, 3, 1.0);
+    luaL_argcheck(L, src->channels == dst->channels, 2, "channel counts differ");
+    size_t n = (size_t)(src->frames < dst->frames ? src->frames : dst->frames) * dst->channels;
+    for (size_t i = 0; i < n; i++) write_sample(dst, i, read_sample(dst, i) + gain * read_sample(src, i));
+    return 0;
+}
+
+static int sample_buffer_len(lua_State *L) {
+    SampleBuffer *sb = check_udata(L, 1, SampleBuffer);
+    lua_pushinteger(L, sb->frames);
+    return 1;
+}
+
+// Methods first, then the read-only fields frames / channels / sampleSize.
+static int sample_buffer_index(lua_State *L) {
+    SampleBuffer *sb = check_udata(L, 1, SampleBuffer);
+    lua_pushvalue(L, 2);
+    if (lua_rawget(L, lua_upvalueindex(1)) != LUA_TNIL) return 1;
+    const char *key = lua_tostring(L, 2);
+    if (key == NULL) return 1;
+    if (strcmp(key, "frames") == 0) lua_pushinteger(L, sb->frames);
+    else if (strcmp(key, "channels") == 0) lua_pushinteger(L, sb->channels);
+    else if (strcmp(key, "sampleSize") == 0) lua_pushinteger(L, sb->sampleSize);
+    else lua_pushnil(L);
+    return 1;
+}
+
+static int sample_buffer_gc(lua_State *L) {
+    SampleBuffer *sb = check_udata(L, 1, SampleBuffer);
+    if (sb->data != NULL) MemFree(sb->data);
+    sb->data = NULL;
+    sb->frames = 0;
+    return 0;
+}
+
+static const luaL_Reg sample_buffer_methods[] = {
+    {"get", sample_buffer_get}, {"set", sample_buffer_set},
+    {"setRange", sample_buffer_set_range}, {"fill", sample_buffer_fill},
+    {"sine", sample_buffer_sine}, {"mix", sample_buffer_mix},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// SpriteArray ("SpriteArray" userdata, see raylib_wrappers.h)
+//
+// Indices are 1-based. A sprite is (sx, sy, sw, sh, dx, dy, dw, dh, ox, oy,
+// rotation, tint) — DrawTexturePro's source, dest, origin, rotation and tint
+// as plain numbers, with tint a packed 0xRRGGBBAA integer (or Color table).
+// Per-field setters let an update loop move or spin sprites without
+// rewriting the rest.
+// ---------------------------------------------------------------------------
+
+static SpriteArray *check_sprite_array(lua_State *L, int idx) {
+    return check_udata(L, idx, SpriteArray);
+}
+
+static void sprite_array_reserve(lua_State *L, SpriteArray *arr, int capacity) {
+    if (capacity <= arr->capacity) return;
+    SpriteInstance *data = realloc(arr->data, sizeof(SpriteInstance) * (size_t)capacity);
+    if (data == NULL) luaL_error(L, "out of memory growing sprite array to %d sprites", capacity);
+    arr->data = data;
+    arr->capacity = capacity;
+}
+
+// New sprites are zero-sized with a white tint.
+static void sprite_array_resize(lua_State *L, SpriteArray *arr, lua_Integer count) {
+    if (count < 0 || count > 0x7fffffff / (lua_Integer)sizeof(SpriteInstance)) luaL_error(L, "sprite count out of range");
+    sprite_array_reserve(L, arr, (int)count);
+    for (int i = arr->count; i < count; i++) arr->data[i] = (SpriteInstance){ .tint = WHITE };
+    arr->count = (int)count;
+}
+
+static SpriteInstance *check_sprite(lua_State *L, SpriteArray *arr, int idx) {
+    lua_Integer i = luaL_checkinteger(L, idx);
+    luaL_argcheck(L, i >= 1 && i <= arr->count, idx, "sprite index out of range");
+    return &arr->data[i - 1];
+}
+
+// Reads sx, sy, sw, sh, dx, dy, dw, dh, ox, oy, rotation[, tint] from `idx` on.
+static SpriteInstance read_sprite(lua_State *L, int idx) {
+    float f[11];
+    for (int c = 0; c < 11; c++) f[c] = (float)luaL_checknumber(L, idx + c);
+    return (SpriteInstance){
+        { f[0], f[1], f[2], f[3] }, { f[4], f[5], f[6], f[7] }, { f[8], f[9] }, f[10],
+        lua_isnoneornil(L, idx + 11) ? WHITE : get_color_from_table(L, idx + 11)
+    };
+}
+
+// SpriteArray([n]): n zero-sized white sprites.
+static int lua_SpriteArray(lua_State *L) {
+    lua_Integer n = luaL_optinteger(L, 1, 0);
+    SpriteArray *arr = lua_newuserdatauv(L, sizeof(SpriteArray), 0);
+    arr->count = 0; arr->capacity = 0; arr->data = NULL;
+    luaL_setmetatable(L, "SpriteArray");
+    sprite_array_resize(L, arr, n);
+    return 1;
+}
+
+// arr:get(i) -> sx, sy, sw, sh, dx, dy, dw, dh, ox, oy, rotation, tint
+static int sprite_array_get(lua_State *L) {
+    SpriteArray *arr = check_sprite_array(L, 1);
+    const SpriteInstance *s = check_sprite(L, arr, 2);
+    const float f[11] = { s->source.x, s->source.y, s->source.width, s->source.height,
+                          s->dest.x, s->dest.y, s->dest.width, s->dest.height,
+                          s->origin.x, s->origin.y, s->rotation };
+    for (int c = 0; c < 11; c++) lua_pushnumber(L, f[c]);
+    lua_pushinteger(L, pack_color(s->tint));
+    return 12;
+}
+
+// arr:set(i, sx, sy, sw, sh, dx, dy, dw, dh, ox, oy, rotation[, tint])
+static int sprite_array_set(lua_State *L) {
+    SpriteArray *arr = check_sprite_array(L, 1);
+    SpriteInstance *s = check_sprite(L, arr, 2);
+    *s = read_sprite(L, 3);
+    return 0;
+}
+
+// arr:push(sx, sy, sw, sh, dx, dy, dw, dh, ox, oy, rotation[, tint]) -> index
+static int sprite_array_push(lua_State *L) {
+    SpriteArray *arr = check_sprite_array(L, 1);
+    SpriteInstance s = read_sprite(L, 2);
+    if (arr->count == arr->capacity) sprite_array_reserve(L, arr, arr->capacity ? arr->capacity * 2 : 16);
+    arr->data[arr->count++] = s;
+    lua_pushinteger(L, arr->count);
+    return 1;
+}
+
+// arr:setSource(i, x, y, width, height)
+static int sprite_array_set_source(lua_State *L) {
+    SpriteInstance *s = check_sprite(L, check_sprite_array(L, 1), 2);
+    s->source = (Rectangle){ (float)luaL_checknumber(L, 3), (float)luaL_checknumber(L, 4),
+                             (float)luaL_checknumber(L, 5), (float)luaL_checknumber(L, 6) };
+    return 0;
+}
+
+// arr:setDest(i, x, y[, width, height]) — the size is kept when omitted.
+static int sprite_array_set_dest(lua_State *L) {
+    SpriteInstance *s = check_sprite(L, check_sprite_array(L, 1), 2);
+    s->dest.x = (float)luaL_checknumber(L, 3);
+    s->dest.y = (float)luaL_checknumber(L, 4);
+    if (!lua_isnoneornil(L, 5)) {
+        s->dest.width = (float)luaL_checknumber(L, 5);
+        s->dest.height = (float)luaL_checknumber(L, 6);
+    }
+    return 0;
+}
+
+// arr:setRotation(i, degrees)
+static int sprite_array_set_rotation(lua_State *L) {
+    SpriteInstance *s = check_sprite(L, check_sprite_array(L, 1), 2);
+    s->rotation = (float)luaL_checknumber(L, 3);
+    return 0;
+}
+
+// arr:setTint(i, color)
+static int sprite_array_set_tint(lua_State *L) {
+    SpriteInstance *s = check_sprite(L, check_sprite_array(L, 1), 2);
+    s->tint = get_color_from_table(L, 3);
+    return 0;
+}
+
+static int sprite_array_resize_m(lua_State *L) {
+    sprite_array_resize(L, check_sprite_array(L, 1), luaL_checkinteger(L, 2));
+    return 0;
+}
+
+// Drops all sprites but keeps the storage for reuse.
+static int sprite_array_clear(lua_State *L) {
+    check_sprite_array(L, 1)->count = 0;
+    return 0;
+}
+
+static int sprite_array_len(lua_State *L) {
+    lua_pushinteger(L, check_sprite_array(L, 1)->count);
+    return 1;
+}
+
+static int sprite_array_gc(lua_State *L) {
+    SpriteArray *arr = check_sprite_array(L, 1);
+    free(arr->data);
+    arr->data = NULL;
+    arr->count = arr->capacity = 0;
+    return 0;
+}
+
+static const luaL_Reg sprite_array_methods[] = {
+    {"get", sprite_array_get}, {"set", sprite_array_set}, {"push", sprite_array_push},
+    {"setSource", sprite_array_set_source}, {"setDest", sprite_array_set_dest},
+    {"setRotation", sprite_array_set_rotation}, {"setTint", sprite_array_set_tint},
+    {"resize", sprite_array_resize_m}, {"clear", sprite_array_clear},
+    {NULL, NULL}
+};
+static const luaL_Reg sprite_array_meta[] = {
+    {"__len", sprite_array_len}, {"__gc", sprite_array_gc},
+    {NULL, NULL}
+};
+
+// ---------------------------------------------------------------------------
+// Registration
+// ---------------------------------------------------------------------------
+
+static const luaL_Reg types_functions[] = {
+    {"Vector2", lua_Vector2}, {"Vector3", lua_Vector3}, {"Vector4", lua_Vector4},
+    // Matrix constructors; each takes an optional trailing destination Matrix
+    {"Matrix", lua_Matrix}, {"MatrixIdentity", lua_MatrixIdentity},
+    {"MatrixTranslate", lua_MatrixTranslate}, {"MatrixScale", lua_MatrixScale},
+    {"MatrixRotate", lua_MatrixRotate}, {"MatrixRotateX", lua_MatrixRotateX},
+    {"MatrixRotateY", lua_MatrixRotateY}, {"MatrixRotateZ", lua_MatrixRotateZ},
+    {"MatrixRotateXYZ", lua_MatrixRotateXYZ}, {"MatrixMultiply", lua_MatrixMultiply},
+    {"MatrixInvert", lua_MatrixInvert}, {"MatrixTranspose", lua_MatrixTranspose},
+    {"MatrixLookAt", lua_MatrixLookAt}, {"MatrixPerspective", lua_MatrixPerspective},
+    {"MatrixOrtho", lua_MatrixOrtho},
+    {"Vec2Array", lua_Vec2Array}, {"Vec3Array", lua_Vec3Array}, {"Vec4Array", lua_Vec4Array},
+    {"PixelBuffer", lua_PixelBuffer}, {"LoadImageFromPixelBuffer", lua_LoadImageFromPixelBuffer},
+    {"SampleBuffer", lua_SampleBuffer}, {"LoadWaveFromSamples", lua_LoadWaveFromSamples},
+    {"SpriteArray", lua_SpriteArray},
+    {NULL, NULL}
+};
+
+static void register_type_metatable(lua_State *L, const char *tname, const luaL_Reg *meta) {
+    luaL_newmetatable(L, tname);
+    luaL_setfuncs(L, meta, 0);
+    lua_pop(L, 1);
+}
+
+// Creates the value-type metatables and adds their constructors onto the
+// module table currently on top of the stack.
+void register_types(lua_State *L) {
+    register_type_metatable(L, "Vector2", vector2_meta);
+    register_type_metatable(L, "Vector3", vector3_meta);
+    register_type_metatable(L, "Vector4", vector4_meta);
+    register_type_metatable(L, "Matrix", matrix_meta);
+    static const char *const pointArrayNames[] = { "Vec2Array", "Vec3Array", "Vec4Array" };
+    for (int i = 0; i < 3; i++) {
+        luaL_newmetatable(L, pointArrayNames[i]);
+        luaL_setfuncs(L, point_array_meta, 0);
+        luaL_newlib(L, point_array_methods);
+        lua_setfield(L, -2, "__index");
+        lua_pop(L, 1);
+    }
+    luaL_newmetatable(L, "PixelBuffer");
+    lua_pushcfunction(L, pixel_buffer_len); lua_setfield(L, -2, "__len");
+    lua_pushcfunction(L, pixel_buffer_gc);  lua_setfield(L, -2, "__gc");
+    luaL_newlib(L, pixel_buffer_methods);
+    lua_pushcclosure(L, pixel_buffer_index, 1);
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+    luaL_newmetatable(L, "SampleBuffer");
+    lua_pushcfunction(L, sample_buffer_len); lua_setfield(L, -2, "__len");
+    lua_pushcfunction(L, sample_buffer_gc);  lua_setfield(L, -2, "__gc");
+    luaL_newlib(L, sample_buffer_methods);
+    lua_pushcclosure(L, sample_buffer_index, 1);
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+    luaL_newmetatable(L, "SpriteArray");
+    luaL_setfuncs(L, sprite_array_meta, 0);
+    luaL_newlib(L, sprite_array_methods);
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+    luaL_setfuncs(L, types_functions, 0);
+}
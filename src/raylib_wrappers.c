@@ -1,13 +1,120 @@
 #include <stdlib.h>
+#include <string.h>
 #include "raylib_wrappers.h"
 #include "lauxlib.h"
 
+// ---------------------------------------------------------------------------
+// Tagged userdata type checks
+//
+// Every metatable in RAYLIB_UDATA_TYPES holds, at integer key 1, a light
+// userdata pointing at its entry in udata_tags. The metatables are created
+// with that slot in their array part, so a check is one indexed load from the
+// value's own metatable and an address compare, with no registry or string
+// lookup. The tags live in each state's own metatables, so nothing is shared
+// between states, and Lua code cannot forge a light userdata to plant one.
+// ---------------------------------------------------------------------------
+
+static const char *const udata_names[UDATA_TYPE_COUNT] = {
+#define UDATA_NAME(name) #name,
+    RAYLIB_UDATA_TYPES(UDATA_NAME)
+#undef UDATA_NAME
+};
+static const char udata_tags[UDATA_TYPE_COUNT];
+
+void register_udata_metatables(lua_State *L) {
+    for (int i = 0; i < UDATA_TYPE_COUNT; i++) {
+        if (luaL_getmetatable(L, udata_names[i]) == LUA_TNIL) {   // else: required before
+            lua_pop(L, 1);
+            lua_createtable(L, 1, 2);
+            lua_pushstring(L, udata_names[i]);
+            lua_setfield(L, -2, "__name");                        // as luaL_newmetatable does
+            lua_pushvalue(L, -1);
+            lua_setfield(L, LUA_REGISTRYINDEX, udata_names[i]);
+        }
+        lua_pushlightuserdata(L, (void *)&udata_tags[i]);
+        lua_rawseti(L, -2, 1);
+        lua_pop(L, 1);
+    }
+}
+
+// Whether the userdata at `index` carries the metatable tagged `tag`.
+static int has_udata_tag(lua_State *L, int index, UdataType tag) {
+    if (!lua_getmetatable(L, index)) return 0;
+    lua_rawgeti(L, -1, 1);
+    const void *mark = lua_touserdata(L, -1);
+    lua_pop(L, 2);
+    return mark == &udata_tags[tag];
+}
+
+void *check_udata_tag(lua_State *L, int index, UdataType tag, const char *tname) {
+    void *p = lua_touserdata(L, index);
+    if (p == NULL || !has_udata_tag(L, index, tag)) luaL_typeerror(L, index, tname);
+    return p;
+}
+
+void *test_udata_tag(lua_State *L, int index, UdataType tag, const char *tname) {
+    (void)tname;
+    void *p = lua_touserdata(L, index);
+    return (p != NULL && has_udata_tag(L, index, tag)) ? p : NULL;
+}
+
 const void *get_data_buffer(lua_State *L, int index) {
     if (lua_type(L, index) == LUA_TSTRING)
         return lua_tostring(L, index);
+    PixelBuffer *pb = (PixelBuffer *)test_udata(L, index, PixelBuffer);
+    if (pb != NULL) {
+        luaL_argcheck(L, pb->data != NULL, index, "PixelBuffer has been unloaded");
+        return pb->data;
+    }
+    SampleBuffer *sb = (SampleBuffer *)test_udata(L, index, SampleBuffer);
+    if (sb != NULL) {
+        luaL_argcheck(L, sb->data != NULL, index, "SampleBuffer has been unloaded");
+        return sb->data;
+    }
     return lua_touserdata(L, index);
 }
 
+const void *get_pixel_data(lua_State *L, int index, int format, int pixelCount) {
+    PixelBuffer *pb = (PixelBuffer *)test_udata(L, index, PixelBuffer);
+    if (pb == NULL) return get_data_buffer(L, index);
+    luaL_argcheck(L, pb->data != NULL, index, "PixelBuffer has been unloaded");
+    luaL_argcheck(L, format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, index, "target is not RGBA8");
+    luaL_argcheck(L, (lua_Integer)pb->width * pb->height >= pixelCount, index, "PixelBuffer too small");
+    return pb->data;
+}
+
+void push_pixel_buffer(lua_State *L, Color *data, int width, int height) {
+    PixelBuffer *pb = (PixelBuffer *)lua_newuserdatauv(L, sizeof(PixelBuffer), 0);
+    pb->width = data ? width : 0;
+    pb->height = data ? height : 0;
+    pb->data = data;
+    luaL_setmetatable(L, "PixelBuffer");
+}
+
+const void *get_sample_data(lua_State *L, int index, int sampleSize, int channels, int countIndex, int *frameCount) {
+    SampleBuffer *sb = (SampleBuffer *)test_udata(L, index, SampleBuffer);
+    if (sb == NULL) {
+        const void *data = get_data_buffer(L, index);
+        *frameCount = (int)luaL_checkinteger(L, countIndex);
+        return data;
+    }
+    luaL_argcheck(L, sb->data != NULL, index, "SampleBuffer has been unloaded");
+    luaL_argcheck(L, sb->sampleSize == sampleSize && sb->channels == channels, index, "SampleBuffer format does not match");
+    lua_Integer frames = luaL_optinteger(L, countIndex, sb->frames);
+    luaL_argcheck(L, frames >= 0 && frames <= sb->frames, countIndex, "more frames than the SampleBuffer holds");
+    *frameCount = (int)frames;
+    return sb->data;
+}
+
+void push_sample_buffer(lua_State *L, void *data, int frames, int channels, int sampleSize) {
+    SampleBuffer *sb = (SampleBuffer *)lua_newuserdatauv(L, sizeof(SampleBuffer), 0);
+    sb->frames = data ? frames : 0;
+    sb->channels = channels;
+    sb->sampleSize = sampleSize;
+    sb->data = data;
+    luaL_setmetatable(L, "SampleBuffer");
+}
+
 Color convert_color(int color) {
     return (Color){
         (unsigned char)((color >> 24) & 0xFF),
@@ -17,8 +124,15 @@ Color convert_color(int color) {
     };
 }
 
+lua_Integer pack_color(Color color) {
+    return (lua_Integer)(((unsigned int)color.r << 24) | ((unsigned int)color.g << 16) |
+                         ((unsigned int)color.b << 8)  |  (unsigned int)color.a);
+}
+
 Color get_color_from_table(lua_State *L, int index) {
-    luaL_checktype(L, index, LUA_TTABLE);
+    if (lua_isinteger(L, index))
+        return convert_color((int)lua_tointeger(L, index));
+    if (!lua_istable(L, index)) luaL_typeerror(L, index, "Color table or 0xRRGGBBAA integer");
     Color color;
     lua_getfield(L, index, "r"); color.r = (unsigned char)luaL_checkinteger(L, -1); lua_pop(L, 1);
     lua_getfield(L, index, "g"); color.g = (unsigned char)luaL_checkinteger(L, -1); lua_pop(L, 1);
@@ -28,6 +142,8 @@ Color get_color_from_table(lua_State *L, int index) {
 }
 
 Vector2 get_vector2_from_table(lua_State *L, int index) {
+    Vector2 *ud = (Vector2 *)test_udata(L, index, Vector2);
+    if (ud != NULL) return *ud;
     luaL_checktype(L, index, LUA_TTABLE);
     Vector2 vec;
     lua_getfield(L, index, "x"); vec.x = (float)luaL_checknumber(L, -1); lua_pop(L, 1);
@@ -36,6 +152,8 @@ Vector2 get_vector2_from_table(lua_State *L, int index) {
 }
 
 Vector3 get_vector3_from_table(lua_State *L, int index) {
+    Vector3 *ud = (Vector3 *)test_udata(L, index, Vector3);
+    if (ud != NULL) return *ud;
     luaL_checktype(L, index, LUA_TTABLE);
     Vector3 vec;
     lua_getfield(L, index, "x"); vec.x = (float)luaL_checknumber(L, -1); lua_pop(L, 1);
@@ -45,6 +163,8 @@ Vector3 get_vector3_from_table(lua_State *L, int index) {
 }
 
 Vector4 get_vector4_from_table(lua_State *L, int index) {
+    Vector4 *ud = (Vector4 *)test_udata(L, index, Vector4);
+    if (ud != NULL) return *ud;
     luaL_checktype(L, index, LUA_TTABLE);
     Vector4 vec;
     lua_getfield(L, index, "x"); vec.x = (float)luaL_checknumber(L, -1); lua_pop(L, 1);
@@ -55,6 +175,12 @@ Vector4 get_vector4_from_table(lua_State *L, int index) {
 }
 
 Matrix get_matrix_from_table(lua_State *L, int index) {
+    Matrix *ud = (Matrix *)test_udata(L, index, Matrix);
+    if (ud != NULL) {
+        Matrix mat;
+        memcpy(&mat, ud, sizeof(Matrix));
+        return mat;
+    }
     luaL_checktype(L, index, LUA_TTABLE);
     Matrix mat;
     lua_getfield(L, index, "m0");  mat.m0  = (float)luaL_checknumber(L, -1); lua_pop(L, 1);
@@ -127,18 +253,195 @@ NPatchInfo get_npatchinfo_from_table(lua_State *L, int index) {
     return info;
 }
 
-Vector2 *get_vector2_array_from_table(lua_State *L, int index) {
+// ---------------------------------------------------------------------------
+// Per-state scratch arena
+//
+// A chain of bump-allocated blocks hung off the registry as a full userdata, so
+// each lua_State gets its own and the GC frees it with the state. Outgrown
+// blocks stay alive (older pointers remain valid) until the next reset, which
+// folds the chain into one block sized for the peak — after warm-up every
+// transient buffer is carved out of that single block.
+// ---------------------------------------------------------------------------
+
+#define SCRATCH_ALIGN        16
+#define SCRATCH_MIN_CAPACITY (64 * 1024)
+#define SCRATCH_ALIGN_UP(n)  (((n) + (SCRATCH_ALIGN - 1)) & ~(size_t)(SCRATCH_ALIGN - 1))
+
+typedef struct ScratchBlock {
+    struct ScratchBlock *prev;
+    size_t capacity;
+} ScratchBlock;
+
+#define SCRATCH_HEADER SCRATCH_ALIGN_UP(sizeof(ScratchBlock))
+#define SCRATCH_DATA(b) ((unsigned char *)(b) + SCRATCH_HEADER)
+
+typedef struct ScratchArena {
+    ScratchBlock *block;   // current block; older blocks hang off block->prev
+    size_t used;           // bytes handed out from the current block
+    size_t retired;        // total capacity of the outgrown blocks
+    size_t peak;           // high-water mark of retired + used
+} ScratchArena;
+
+static const char scratch_key = 0;   // its address is the registry key
+
+static void scratch_free_chain(ScratchBlock *block) {
+    while (block != NULL) {
+        ScratchBlock *prev = block->prev;
+        free(block);
+        block = prev;
+    }
+}
+
+static int scratch_gc(lua_State *L) {
+    ScratchArena *arena = (ScratchArena *)lua_touserdata(L, 1);
+    scratch_free_chain(arena->block);
+    arena->block = NULL;
+    return 0;
+}
+
+static ScratchArena *get_scratch(lua_State *L) {
+    if (lua_rawgetp(L, LUA_REGISTRYINDEX, &scratch_key) == LUA_TUSERDATA) {
+        ScratchArena *arena = (ScratchArena *)lua_touserdata(L, -1);
+        lua_pop(L, 1);
+        return arena;
+    }
+    lua_pop(L, 1);
+    ScratchArena *arena = (ScratchArena *)lua_newuserdatauv(L, sizeof(ScratchArena), 0);
+    memset(arena, 0, sizeof(ScratchArena));
+    lua_createtable(L, 0, 1);
+    lua_pushcfunction(L, scratch_gc);
+    lua_setfield(L, -2, "__gc");
+    lua_setmetatable(L, -2);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &scratch_key);
+    return arena;
+}
+
+void *scratch_alloc(lua_State *L, size_t size) {
+    ScratchArena *arena = get_scratch(L);
+    size = SCRATCH_ALIGN_UP(size);
+    if (arena->block == NULL || arena->used + size > arena->block->capacity) {
+        size_t capacity = arena->block ? arena->block->capacity * 2 : SCRATCH_MIN_CAPACITY;
+        if (capacity < size) capacity = SCRATCH_ALIGN_UP(size);
+        ScratchBlock *block = (ScratchBlock *)malloc(SCRATCH_HEADER + capacity);
+        if (block == NULL) luaL_error(L, "out of memory allocating %d scratch bytes", (int)size);
+        block->prev = arena->block;
+        block->capacity = capacity;
+        if (arena->block != NULL) arena->retired += arena->block->capacity;
+        arena->block = block;
+        arena->used = 0;
+    }
+    void *p = SCRATCH_DATA(arena->block) + arena->used;
+    arena->used += size;
+    if (arena->retired + arena->used > arena->peak) arena->peak = arena->retired + arena->used;
+    return p;
+}
+
+void scratch_pop(lua_State *L, void *p) {
+    ScratchArena *arena = get_scratch(L);
+    if (arena->block == NULL || p == NULL) return;
+    unsigned char *data = SCRATCH_DATA(arena->block);
+    if ((unsigned char *)p >= data && (unsigned char *)p <= data + arena->used)
+        arena->used = (size_t)((unsigned char *)p - data);
+}
+
+void scratch_reset(lua_State *L) {
+    ScratchArena *arena = get_scratch(L);
+    if (arena->block != NULL && arena->block->prev != NULL) {
+        size_t capacity = SCRATCH_ALIGN_UP(arena->peak);
+        scratch_free_chain(arena->block);
+        arena->block = (ScratchBlock *)malloc(SCRATCH_HEADER + capacity);
+        if (arena->block != NULL) {
+            arena->block->prev = NULL;
+            arena->block->capacity = capacity;
+        }
+    }
+    arena->used = 0;
+    arena->retired = 0;
+}
+
+void push_scratch_stats(lua_State *L) {
+    ScratchArena *arena = get_scratch(L);
+    size_t capacity = arena->retired;
+    int blocks = 0;
+    for (ScratchBlock *b = arena->block; b != NULL; b = b->prev) blocks++;
+    if (arena->block != NULL) capacity += arena->block->capacity;
+    lua_createtable(L, 0, 4);
+    lua_pushinteger(L, (lua_Integer)capacity);                      lua_setfield(L, -2, "capacity");
+    lua_pushinteger(L, (lua_Integer)(arena->retired + arena->used)); lua_setfield(L, -2, "used");
+    lua_pushinteger(L, (lua_Integer)arena->peak);                    lua_setfield(L, -2, "peak");
+    lua_pushinteger(L, blocks);                                      lua_setfield(L, -2, "blocks");
+}
+
+int *get_int_array_from_table(lua_State *L, int index, int *count) {
+    luaL_checktype(L, index, LUA_TTABLE);
+    int len = (int)lua_rawlen(L, index);
+    int *values = (int *)scratch_alloc(L, sizeof(int) * (size_t)len);
+    for (int i = 0; i < len; i++) {
+        lua_rawgeti(L, index, i + 1);
+        values[i] = (int)luaL_checkinteger(L, -1);
+        lua_pop(L, 1);
+    }
+    *count = len;
+    return values;
+}
+
+float *get_float_array_from_table(lua_State *L, int index, int *count) {
     luaL_checktype(L, index, LUA_TTABLE);
-    int len = (int)luaL_len(L, index);
-    Vector2 *points = (Vector2 *)malloc(len * sizeof(Vector2));
+    int len = (int)lua_rawlen(L, index);
+    float *values = (float *)scratch_alloc(L, sizeof(float) * (size_t)len);
+    for (int i = 0; i < len; i++) {
+        lua_rawgeti(L, index, i + 1);
+        values[i] = (float)luaL_checknumber(L, -1);
+        lua_pop(L, 1);
+    }
+    *count = len;
+    return values;
+}
+
+Vector2 *get_vector2_list(lua_State *L, int index, int *count) {
+    PointArray *arr = (PointArray *)test_udata(L, index, Vec2Array);
+    if (arr != NULL) {
+        *count = arr->count;
+        return (Vector2 *)arr->data;
+    }
+    luaL_checktype(L, index, LUA_TTABLE);
+    int len = (int)lua_rawlen(L, index);
+    Vector2 *points = (Vector2 *)scratch_alloc(L, sizeof(Vector2) * (size_t)len);
     for (int i = 0; i < len; i++) {
         lua_rawgeti(L, index, i + 1);
         points[i] = get_vector2_from_table(L, -1);
         lua_pop(L, 1);
     }
+    *count = len;
+    return points;
+}
+
+void release_vector2_list(lua_State *L, int index, Vector2 *points) {
+    if (test_udata(L, index, Vec2Array) == NULL) scratch_pop(L, points);
+}
+
+Vector3 *get_vector3_list(lua_State *L, int index, int *count) {
+    PointArray *arr = (PointArray *)test_udata(L, index, Vec3Array);
+    if (arr != NULL) {
+        *count = arr->count;
+        return (Vector3 *)arr->data;
+    }
+    luaL_checktype(L, index, LUA_TTABLE);
+    int len = (int)lua_rawlen(L, index);
+    Vector3 *points = (Vector3 *)scratch_alloc(L, sizeof(Vector3) * (size_t)len);
+    for (int i = 0; i < len; i++) {
+        lua_rawgeti(L, index, i + 1);
+        points[i] = get_vector3_from_table(L, -1);
+        lua_pop(L, 1);
+    }
+    *count = len;
     return points;
 }
 
+void release_vector3_list(lua_State *L, int index, Vector3 *points) {
+    if (test_udata(L, index, Vec3Array) == NULL) scratch_pop(L, points);
+}
+
 void push_vector2_to_table(lua_State *L, Vector2 vec) {
     lua_createtable(L, 0, 2);
     lua_pushnumber(L, vec.x); lua_setfield(L, -2, "x");
@@ -196,10 +499,111 @@ void push_color_to_table(lua_State *L, Color color) {
     lua_pushinteger(L, color.a); lua_setfield(L, -2, "a");
 }
 
+int return_vector2(lua_State *L, int out, Vector2 vec) {
+    if (lua_isnoneornil(L, out)) { push_vector2_to_table(L, vec); return 1; }
+    Vector2 *ud = (Vector2 *)test_udata(L, out, Vector2);
+    if (ud != NULL) {
+        *ud = vec;
+    } else {
+        luaL_argexpected(L, lua_istable(L, out), out, "Vector2 or table");
+        lua_pushnumber(L, vec.x); lua_setfield(L, out, "x");
+        lua_pushnumber(L, vec.y); lua_setfield(L, out, "y");
+    }
+    lua_pushvalue(L, out);
+    return 1;
+}
+
+int return_vector3(lua_State *L, int out, Vector3 vec) {
+    if (lua_isnoneornil(L, out)) { push_vector3_to_table(L, vec); return 1; }
+    Vector3 *ud = (Vector3 *)test_udata(L, out, Vector3);
+    if (ud != NULL) {
+        *ud = vec;
+    } else {
+        luaL_argexpected(L, lua_istable(L, out), out, "Vector3 or table");
+        lua_pushnumber(L, vec.x); lua_setfield(L, out, "x");
+        lua_pushnumber(L, vec.y); lua_setfield(L, out, "y");
+        lua_pushnumber(L, vec.z); lua_setfield(L, out, "z");
+    }
+    lua_pushvalue(L, out);
+    return 1;
+}
+
+int return_vector4(lua_State *L, int out, Vector4 vec) {
+    if (lua_isnoneornil(L, out)) { push_vector4_to_table(L, vec); return 1; }
+    Vector4 *ud = (Vector4 *)test_udata(L, out, Vector4);
+    if (ud != NULL) {
+        *ud = vec;
+    } else {
+        luaL_argexpected(L, lua_istable(L, out), out, "Vector4 or table");
+        lua_pushnumber(L, vec.x); lua_setfield(L, out, "x");
+        lua_pushnumber(L, vec.y); lua_setfield(L, out, "y");
+        lua_pushnumber(L, vec.z); lua_setfield(L, out, "z");
+        lua_pushnumber(L, vec.w); lua_setfield(L, out, "w");
+    }
+    lua_pushvalue(L, out);
+    return 1;
+}
+
+int return_matrix(lua_State *L, int out, Matrix mat) {
+    Matrix *dst = test_udata(L, out, Matrix);
+    if (dst != NULL) {
+        memcpy(dst, &mat, sizeof(Matrix));
+        lua_pushvalue(L, out);
+    } else {
+        if (!lua_isnoneornil(L, out)) luaL_typeerror(L, out, "Matrix");
+        push_matrix_to_userdata(L, mat);
+    }
+    return 1;
+}
+
+int return_rectangle(lua_State *L, int out, Rectangle rect) {
+    if (lua_isnoneornil(L, out)) { push_rectangle_to_table(L, rect); return 1; }
+    luaL_argexpected(L, lua_istable(L, out), out, "table");
+    lua_pushnumber(L, rect.x);      lua_setfield(L, out, "x");
+    lua_pushnumber(L, rect.y);      lua_setfield(L, out, "y");
+    lua_pushnumber(L, rect.width);  lua_setfield(L, out, "width");
+    lua_pushnumber(L, rect.height); lua_setfield(L, out, "height");
+    lua_pushvalue(L, out);
+    return 1;
+}
+
+int return_color(lua_State *L, int out, Color color) {
+    if (lua_isnoneornil(L, out)) { push_color_to_table(L, color); return 1; }
+    luaL_argexpected(L, lua_istable(L, out), out, "table");
+    lua_pushinteger(L, color.r); lua_setfield(L, out, "r");
+    lua_pushinteger(L, color.g); lua_setfield(L, out, "g");
+    lua_pushinteger(L, color.b); lua_setfield(L, out, "b");
+    lua_pushinteger(L, color.a); lua_setfield(L, out, "a");
+    lua_pushvalue(L, out);
+    return 1;
+}
+
+void push_vector2_to_userdata(lua_State *L, Vector2 vec) {
+    Vector2 *p = (Vector2 *)lua_newuserdatauv(L, sizeof(Vector2), 0);
+    *p = vec;
+    luaL_setmetatable(L, "Vector2");
+}
+
+void push_vector3_to_userdata(lua_State *L, Vector3 vec) {
+    Vector3 *p = (Vector3 *)lua_newuserdatauv(L, sizeof(Vector3), 0);
+    *p = vec;
+    luaL_setmetatable(L, "Vector3");
+}
+
+void push_vector4_to_userdata(lua_State *L, Vector4 vec) {
+    Vector4 *p = (Vector4 *)lua_newuserdatauv(L, sizeof(Vector4), 0);
+    *p = vec;
+    luaL_setmetatable(L, "Vector4");
+}
+
+void push_matrix_to_userdata(lua_State *L, Matrix mat) {
+    Matrix *p = (Matrix *)lua_newuserdatauv(L, sizeof(Matrix), 0);
+    memcpy(p, &mat, sizeof(Matrix));
+    luaL_setmetatable(L, "Matrix");
+}
+
 void push_image_to_userdata(lua_State *L, Image image) {
-    Image *pImage = (Image *)lua_newuserdata(L, sizeof(Image));
-    *pImage = image;
-    luaL_setmetatable(L, "Image");
+    push_resource(L, RESOURCE_IMAGE, "Image", &image);
 }
 
 void push_bounding_box_to_table(lua_State *L, BoundingBox bbox) {
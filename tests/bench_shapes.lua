@@ -0,0 +1,74 @@
+-- Benchmark for the bulk shape bindings against one binding call per shape.
+-- Not part of the unit suites; run from the repo root:
+--   LUA_CPATH="./?.so" lua tests/bench_shapes.lua [shapes] [frames]
+-- Or via:
+--   make bench
+--
+-- Each case submits the same shapes inside BeginDrawing/EndDrawing (hidden
+-- window) and reports nanoseconds per shape, averaged over the frames. The
+-- buffers are filled once up front, as a static overlay or tile grid would be.
+
+local r = require("raylib")
+local N = tonumber(arg and arg[1]) or 20000
+local FRAMES = tonumber(arg and arg[2]) or 20
+
+r.SetTraceLogLevel(4)                                -- LOG_WARNING: keep the report readable
+r.SetConfigFlags(0x80)                               -- FLAG_WINDOW_HIDDEN
+r.InitWindow(640, 480, "bench_shapes")
+if not r.IsWindowReady() then
+    print("bench_shapes: no window available")
+    return
+end
+
+local rectTables, circleXY, lineXY = {}, {}, {}
+local rects, circles, lines = r.Vec4Array(), r.Vec3Array(), r.Vec4Array()
+local colors = r.PixelBuffer(N, 1)
+for i = 1, N do
+    local x, y = (i * 7) % 640, (i * 13) % 480
+    rectTables[i] = {x = x, y = y, width = 4, height = 4}
+    circleXY[i] = {x = x, y = y}
+    lineXY[i] = {x, y, x + 8, y + 8}
+    rects:push(x, y, 4, 4)
+    circles:push(x, y, 3)
+    lines:push(x, y, x + 8, y + 8)
+    colors:set(i, (i * 0x9E3779B1) & 0xFFFFFF00 | 0xFF)
+end
+local red = r.RED
+
+local function bench(name, draw)
+    r.BeginDrawing() draw() r.EndDrawing()           -- warm up
+    local total = 0
+    for _ = 1, FRAMES do
+        r.BeginDrawing()
+        local t0 = os.clock()
+        draw()
+        total = total + (os.clock() - t0)
+        r.EndDrawing()
+    end
+    print(string.format("%-44s %8.1f ns/shape", name, total * 1e9 / (N * FRAMES)))
+end
+
+print(string.format("%d shapes x %d frames", N, FRAMES))
+bench("DrawRectangleRec per shape", function()
+    local f = r.DrawRectangleRec
+    for i = 1, N do f(rectTables[i], red) end
+end)
+bench("DrawRectangle per shape (numbers)", function()
+    local f = r.DrawRectangle
+    for i = 1, N do local t = rectTables[i] f(t.x, t.y, 4, 4, red) end
+end)
+bench("DrawRectangles(Vec4Array, color)", function() r.DrawRectangles(rects, red) end)
+bench("DrawRectangles(Vec4Array, PixelBuffer)", function() r.DrawRectangles(rects, colors) end)
+bench("DrawCircleV per shape", function()
+    local f = r.DrawCircleV
+    for i = 1, N do f(circleXY[i], 3, red) end
+end)
+bench("DrawCircles(Vec3Array, color)", function() r.DrawCircles(circles, red) end)
+bench("DrawLine per shape", function()
+    local f = r.DrawLine
+    for i = 1, N do local l = lineXY[i] f(l[1], l[2], l[3], l[4], red) end
+end)
+bench("DrawLines(Vec4Array, color)", function() r.DrawLines(lines, red) end)
+bench("DrawLines(Vec4Array, PixelBuffer)", function() r.DrawLines(lines, colors) end)
+
+r.CloseWindow()
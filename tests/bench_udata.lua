@@ -0,0 +1,46 @@
+-- Microbenchmark for userdata type checks on the binding hot path.
+-- Not part of the unit suites; run from the repo root:
+--   LUA_CPATH="./?.so" lua tests/bench_udata.lua [iterations]
+-- Or via:
+--   make bench
+--
+-- Each case calls a window-free binding whose cost is dominated by argument
+-- checking, and reports nanoseconds per call after subtracting an empty loop.
+
+local r = require("raylib")
+local N = tonumber(arg and arg[1]) or 2000000
+
+local function time(fn)
+    local t0 = os.clock()
+    fn()
+    return os.clock() - t0
+end
+
+local base = time(function() local f = function() end for _ = 1, N do f() end end)
+
+local function bench(name, fn)
+    fn()   -- warm up
+    local t = time(fn) - base
+    print(string.format("%-44s %8.1f ns/call", name, t * 1e9 / N))
+end
+
+local img = r.GenImageColor(4, 4, r.RED)
+local pb = r.LoadImageColors(img)
+local a, b, out = r.Vector2(0, 0), r.Vector2(10, 10), r.Vector2()
+
+print(string.format("%d iterations", N))
+bench("IsImageValid(Image)", function()
+    local IsImageValid = r.IsImageValid
+    for _ = 1, N do IsImageValid(img) end
+end)
+bench("PixelBuffer:get(i)", function()
+    local get = pb.get
+    for _ = 1, N do get(pb, 1) end
+end)
+bench("GetSplinePointLinear(Vector2 x2, out)", function()
+    local f = r.GetSplinePointLinear
+    for _ = 1, N do f(a, b, 0.5, out) end
+end)
+
+r.UnloadImageColors(pb)
+r.UnloadImage(img)
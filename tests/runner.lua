@@ -50,6 +50,10 @@ local suite_files = {
     "tests/test_image.lua",
     "tests/test_filesystem.lua",
     "tests/test_extra.lua",
+    "tests/test_types.lua",
+    "tests/test_commands.lua",
+    "tests/test_mixer.lua",
+    "tests/test_generated.lua",
 }
 
 for _, path in ipairs(suite_files) do
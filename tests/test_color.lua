@@ -89,3 +89,28 @@ for _ = 1, 20 do
     T.assert_true("GetRandomValue in [0,100]", v >= 0 and v <= 100)
 end
 T.assert_true("GetRandomValue exact range [5,5]", r.GetRandomValue(5, 5) == 5)
+
+-- Packed 0xRRGGBBAA integers are accepted by every Color parameter
+T.assert_eq("ColorToInt packed int arg",     r.ColorToInt(0x01020304), 16909060)
+T.assert_true("ColorIsEqual int vs table",   r.ColorIsEqual(0xE62937FF, {r=230, g=41, b=55, a=255}))
+local fromInt = r.ColorTint(0xFFFFFFFF, 0xFF0000FF)
+T.assert_eq("ColorTint int args r", fromInt.r, 255)
+T.assert_eq("ColorTint int args g", fromInt.g, 0)
+T.assert_false("Color rejects string", pcall(r.ColorToInt, "red"))
+
+-- Module-level integer color constants mirror the global tables
+T.assert_eq("raylib.RED packed",      r.RED, 0xE62937FF)
+T.assert_eq("raylib.RAYWHITE packed", r.RAYWHITE, 0xF5F5F5FF)
+T.assert_eq("raylib.BLANK packed",    r.BLANK, 0)
+T.assert_true("raylib.RED matches global RED", r.ColorIsEqual(r.RED, RED))
+
+-- Integer-returning variants
+T.assert_eq("FadeInt",          r.FadeInt(0xFF0000FF, 0.0), 0xFF000000)
+T.assert_eq("ColorAlphaInt",    r.ColorAlphaInt({r=200, g=100, b=50, a=255}, 1.0), 0xC86432FF)
+T.assert_eq("ColorLerpInt ends", r.ColorLerpInt(r.BLACK, r.WHITE, 1.0), 0xFFFFFFFF)
+T.assert_eq("ColorTintInt",     r.ColorTintInt(r.WHITE, 0xFF0000FF), 0xFF0000FF)
+T.assert_eq("ColorFromHSVInt red", r.ColorFromHSVInt(0.0, 1.0, 1.0), 0xFF0000FF)
+T.assert_eq("ColorFromNormalizedInt", r.ColorFromNormalizedInt({x=0, y=1, z=0, w=1}), 0x00FF00FF)
+T.assert_eq("ColorBrightnessInt factor 0", r.ColorBrightnessInt(0x646464FF, 0.0), 0x646464FF)
+local lerpT = r.ColorLerp(r.RED, r.BLUE, 0.5)
+T.assert_eq("ColorLerpInt matches ColorLerp", r.ColorLerpInt(r.RED, r.BLUE, 0.5), r.ColorToInt(lerpT) & 0xFFFFFFFF)
@@ -0,0 +1,223 @@
+-- tests/test_commands.lua
+-- Batched draw submission (CommandBuffer / ExecuteCommandBuffer, DrawTextureProBatch,
+-- DrawRectangles / DrawCircles / DrawLines, display lists, instance buffers,
+-- the glyph layout cache)
+
+local T = ...
+local r = T.raylib
+
+-- ---------------------------------------------------------------------------
+-- Recording (no window needed)
+-- ---------------------------------------------------------------------------
+local cb = r.CommandBuffer(4)
+T.assert_eq("CommandBuffer: starts empty", #cb, 0)
+cb:rect(0, 0, 10, 10, 0xFF0000FF)
+cb:rectLines(0, 0, 10, 10, {r = 0, g = 255, b = 0, a = 255})
+cb:circle(5, 5, 3, r.BLUE)
+cb:line(0, 0, 10, 10, r.WHITE)
+cb:text("hello", 1, 2, 10, r.BLACK)
+T.assert_eq("CommandBuffer: grows past its capacity", #cb, 5)
+cb:clear()
+T.assert_eq("CommandBuffer: clear empties", #cb, 0)
+
+T.assert_false("CommandBuffer: rejects a bad color", pcall(cb.rect, cb, 0, 0, 1, 1, "red"))
+T.assert_eq("CommandBuffer: failed append leaves no command", #cb, 0)
+T.assert_false("CommandBuffer: rejects a bad coordinate", pcall(cb.circle, cb, 5, "x", 3, r.BLUE))
+T.assert_eq("CommandBuffer: bad coordinate leaves no command", #cb, 0)
+T.assert_false("CommandBuffer: sprite needs a texture", pcall(cb.sprite, cb, {}, {x = 0, y = 0, width = 1, height = 1},
+    {x = 0, y = 0, width = 1, height = 1}, {x = 0, y = 0}, 0, r.WHITE))
+T.assert_false("ExecuteCommandBuffer: rejects other values", pcall(r.ExecuteCommandBuffer, {}))
+T.assert_false("DrawTextureProBatch: needs a texture", pcall(r.DrawTextureProBatch, {}, r.SpriteArray(1)))
+
+-- Bulk shapes reject bad buffers before drawing anything
+T.assert_false("DrawRectangles: flat array must hold whole rects", pcall(r.DrawRectangles, {1, 2, 3}, r.RED))
+T.assert_false("DrawRectangles: Vec3Array is not a rect buffer", pcall(r.DrawRectangles, r.Vec3Array(1), r.RED))
+T.assert_false("DrawCircles: fewer colors than circles", pcall(r.DrawCircles, {1, 2, 3, 4, 5, 6}, {r.RED}))
+T.assert_false("DrawLines: PixelBuffer too small", pcall(r.DrawLines, r.Vec4Array(5), r.PixelBuffer(2, 2)))
+local scratchBefore = r.GetScratchArenaStats().used
+r.DrawRectangles({}, r.RED)                          -- nothing to draw, no window needed
+T.assert_eq("DrawRectangles: scratch released", r.GetScratchArenaStats().used, scratchBefore)
+T.assert_false("EndDisplayList: nothing being recorded", pcall(r.EndDisplayList))
+T.assert_false("SetTextLayoutCacheSize: rejects negative sizes", pcall(r.SetTextLayoutCacheSize, -1))
+T.assert_eq("TextLayoutCache: default capacity", r.GetTextLayoutCacheStats().capacity, 1024)
+
+local instStats = r.GetResourceStats().InstanceBuffer
+local inst = r.InstanceBuffer(300)                  -- spans two dirty blocks
+T.assert_eq("InstanceBuffer: length", #inst, 300)
+T.assert_eq("InstanceBuffer: starts as identity", inst:get(300), r.MatrixIdentity())
+inst:set(2, r.MatrixTranslate(1, 2, 3))
+T.assert_eq("InstanceBuffer: set/get round-trip", inst:get(2), r.MatrixTranslate(1, 2, 3))
+local moved = {}
+for k = 0, 15 do moved["m" .. k] = (k % 5 == 0) and 1 or 0 end
+moved.m12 = 7
+inst:setRange(299, {r.MatrixScale(2, 2, 2), moved})
+T.assert_eq("InstanceBuffer: setRange writes Matrix values", inst:get(299), r.MatrixScale(2, 2, 2))
+T.assert_eq("InstanceBuffer: setRange writes tables", inst:get(300).m12, 7)
+T.assert_false("InstanceBuffer: index out of range", pcall(inst.set, inst, 301, r.MatrixIdentity()))
+T.assert_false("InstanceBuffer: range past the end", pcall(inst.setRange, inst, 300, {r.MatrixIdentity(), r.MatrixIdentity()}))
+T.assert_false("InstanceBuffer: needs instances", pcall(r.InstanceBuffer, 0))
+local fromList = r.InstanceBuffer({r.MatrixTranslate(4, 5, 6), r.MatrixIdentity()})
+T.assert_eq("InstanceBuffer: built from a list", fromList:get(1), r.MatrixTranslate(4, 5, 6))
+T.assert_eq("InstanceBuffer: counted as a resource", r.GetResourceStats().InstanceBuffer.count - instStats.count, 2)
+T.assert_eq("InstanceBuffer: CPU copy counted",
+    r.GetResourceStats().InstanceBuffer.cpuBytes - instStats.cpuBytes, 302 * 64 + 2 + 1)
+r.UnloadInstanceBuffer(fromList)
+r.UnloadInstanceBuffer(fromList)                     -- a second unload is a no-op
+T.assert_eq("UnloadInstanceBuffer: empties the buffer", #fromList, 0)
+fromList = nil
+collectgarbage()
+r.FlushUnloadQueue()
+T.assert_eq("InstanceBuffer: unload and collection are counted once",
+    r.GetResourceStats().InstanceBuffer.count - instStats.count, 1)
+
+-- ---------------------------------------------------------------------------
+-- Execution (needs a window; skipped where none can be opened)
+-- ---------------------------------------------------------------------------
+r.SetConfigFlags(0x80)                               -- FLAG_WINDOW_HIDDEN
+r.InitWindow(32, 32, "command buffer")
+if r.IsWindowReady() then
+    local img = r.GenImageColor(4, 4, 0x00FF00FF)   -- 64 bytes as RGBA8
+    r.SetTextureBudget(64)
+    local base = r.GetTextureBudgetStats()           -- counters are process-wide
+    local tex = r.LoadTextureFromImage(img)
+    local other = r.LoadTextureFromImage(img)
+    r.UnloadImage(img)
+    r.BeginDrawing()
+    r.EndDrawing()                                   -- evicts `tex`, the coldest
+    T.assert_eq("CommandBuffer: texture evicted before recording", r.GetTextureBudgetStats().evictions - base.evictions, 1)
+
+    local scene = r.CommandBuffer()
+    scene:rect(0, 0, 32, 32, 0xFF0000FF)
+    scene:sprite(tex, {x = 0, y = 0, width = 4, height = 4}, {x = 16, y = 0, width = 16, height = 16},
+        {x = 0, y = 0}, 0, r.WHITE)
+    scene:texture(tex, 0, 28, r.WHITE)
+    scene:textEx(r.GetFontDefault(), "x", {x = 0, y = 0}, 10, 1, r.BLACK)
+    T.assert_eq("CommandBuffer: recording does not reload", r.GetTextureBudgetStats().reloads - base.reloads, 0)
+    tex = nil
+    collectgarbage()                                 -- the buffer keeps the texture alive
+    T.assert_eq("CommandBuffer: anchored texture not collected", r.GetTextureBudgetStats().managed, 2)
+
+    for _ = 1, 2 do                                  -- replayed unchanged every frame
+        r.BeginDrawing()
+        r.ExecuteCommandBuffer(scene)
+        r.EndDrawing()
+    end
+    T.assert_eq("ExecuteCommandBuffer: buffer kept after execution", #scene, 4)
+    T.assert_eq("ExecuteCommandBuffer: evicted texture reloaded once", r.GetTextureBudgetStats().reloads - base.reloads, 1)
+
+    local sprites = r.SpriteArray()
+    for i = 1, 3000 do                               -- more quads than one render batch holds
+        sprites:push(0, 0, 4, 4, i % 32, i % 29, 4, 4, 2, 2, i, 0xFFFFFF80)
+    end
+    local before = r.GetTextureBudgetStats().reloads -- `other` was evicted when `tex` came back
+    r.BeginDrawing()
+    r.DrawTextureProBatch(other, sprites)
+    r.DrawTextureProBatch(other, sprites, 2999, 2)
+    r.DrawTextureProBatch(other, sprites, 3001, 0)
+    T.assert_false("DrawTextureProBatch: range past the end", pcall(r.DrawTextureProBatch, other, sprites, 2999, 3))
+    T.assert_false("DrawTextureProBatch: first out of range", pcall(r.DrawTextureProBatch, other, sprites, 0))
+    r.EndDrawing()
+    T.assert_eq("DrawTextureProBatch: reloads an evicted texture", r.GetTextureBudgetStats().reloads - before, 1)
+
+    local rects, circles, lines = r.Vec4Array(), r.Vec3Array(), r.Vec4Array()
+    for i = 1, 5000 do                               -- past one render batch
+        rects:push(i % 32, i % 31, 2, 2)
+        circles:push(i % 32, i % 30, 3)
+        lines:push(0, i % 32, 32, i % 29)
+    end
+    local perRect = r.PixelBuffer(5000, 1, 0x336699FF)
+    local used = r.GetScratchArenaStats().used
+    r.BeginDrawing()
+    r.DrawRectangles(rects, r.RED)
+    r.DrawRectangles(rects, perRect)
+    r.DrawRectangles({0, 0, 4, 4, 8, 8, 4, 4}, {0xFF0000FF, {r = 0, g = 255, b = 0, a = 255}})
+    r.DrawCircles(circles, r.BLUE)
+    r.DrawCircles({16, 16, 4}, {0x00FF00FF})
+    r.DrawLines(lines, r.GREEN)
+    r.DrawLines(lines, perRect, 2)
+    T.assert_eq("bulk shapes: scratch released", r.GetScratchArenaStats().used, used)
+    r.EndDrawing()
+
+    -- Display lists: record once, replay with or without a transform.
+    -- Recording needs rlgl's render batch; immediate-mode renderers refuse it.
+    local canRecord, recordErr = pcall(r.BeginDisplayList)
+    if not canRecord then
+        T.assert_true("BeginDisplayList: explains a missing render batch",
+            tostring(recordErr):find("batching renderer", 1, true) ~= nil)
+    else
+        T.assert_false("BeginDisplayList: no nesting", pcall(r.BeginDisplayList))
+        r.DrawRectangle(0, 0, 8, 8, r.RED)
+        r.DrawLine(0, 0, 8, 8, r.GREEN)              -- a mode switch between quads and lines
+        r.DrawRectangleRec({x = 8, y = 8, width = 8, height = 8}, r.BLUE)
+        r.DrawTexture(other, 16, 16, r.WHITE)
+        local list = r.EndDisplayList()
+        T.assert_eq("DisplayList: captured every vertex", #list, 4 + 2 + 4 + 4)
+        r.BeginDrawing()
+        r.DrawDisplayList(list)
+        r.DrawDisplayList(list, r.MatrixTranslate(10, 10, 0))
+        r.EndDrawing()
+        T.assert_true("DisplayList: replay keeps the texture resident", r.IsTextureValid(other))
+
+        r.BeginDisplayList(8)                        -- two quads
+        for i = 1, 3 do r.DrawRectangle(i, i, 2, 2, r.RED) end
+        local okOverflow, errOverflow = pcall(r.EndDisplayList)
+        T.assert_false("EndDisplayList: overflow is an error", okOverflow)
+        T.assert_true("EndDisplayList: overflow message", tostring(errOverflow):find("flushed", 1, true) ~= nil)
+        r.BeginDisplayList()                         -- the failed recording was cleaned up
+        T.assert_eq("DisplayList: empty recording", #r.EndDisplayList(), 0)
+    end
+
+    -- Glyph layout cache: a string drawn again is a hit; the LRU bound evicts.
+    r.SetTextLayoutCacheSize(0)                      -- drop layouts drawn above
+    r.SetTextLayoutCacheSize(2)
+    local ts = r.GetTextLayoutCacheStats()
+    r.BeginDrawing()
+    r.DrawText("score: 100", 0, 0, 10, r.WHITE)
+    r.DrawText("score: 100", 0, 12, 10, r.WHITE)     -- same layout, other position
+    local hud = r.CommandBuffer()
+    hud:text("score: 100", 0, 24, 10, r.WHITE)
+    r.ExecuteCommandBuffer(hud)
+    r.DrawTextEx(r.GetFontDefault(), "lives\n3", {x = 0, y = 0}, 10, 2, r.WHITE)
+    r.DrawTextPro(r.GetFontDefault(), "lives\n3", {x = 16, y = 16}, {x = 0, y = 0}, 90, 10, 2, r.WHITE)
+    r.EndDrawing()
+    local te = r.GetTextLayoutCacheStats()
+    T.assert_eq("TextLayoutCache: repeats are hits", te.hits - ts.hits, 3)
+    T.assert_eq("TextLayoutCache: first draws are misses", te.misses - ts.misses, 2)
+    T.assert_eq("TextLayoutCache: holds both layouts", te.entries, 2)
+    T.assert_true("TextLayoutCache: reports its memory", te.bytes > 0)
+    r.DrawText("level 1", 0, 0, 10, r.WHITE)         -- a third layout evicts the oldest
+    T.assert_eq("TextLayoutCache: bounded by its capacity", r.GetTextLayoutCacheStats().entries, 2)
+    T.assert_eq("TextLayoutCache: evicts the least recent", r.GetTextLayoutCacheStats().evictions - ts.evictions, 1)
+    r.DrawText("lives\n3", 0, 0, 10, r.WHITE)       -- DrawText spacing differs from the DrawTextEx above
+    T.assert_eq("TextLayoutCache: size and spacing are part of the key", r.GetTextLayoutCacheStats().misses - ts.misses, 4)
+    r.SetTextLineSpacing(4)
+    T.assert_eq("TextLayoutCache: line spacing change drops layouts", r.GetTextLayoutCacheStats().entries, 0)
+    r.SetTextLineSpacing(2)
+    r.SetTextLayoutCacheSize(0)
+    r.DrawText("score: 100", 0, 0, 10, r.WHITE)      -- uncached draws still work
+    T.assert_eq("TextLayoutCache: disabled cache stays empty", r.GetTextLayoutCacheStats().entries, 0)
+    r.SetTextLayoutCacheSize(1024)
+
+    -- Instanced meshes from a persistent buffer (falls back to DrawMeshInstanced
+    -- with the CPU copy where the renderer has no vertex buffers).
+    local cube = r.GenMeshCube(1, 1, 1)
+    local material = r.LoadMaterialDefault()
+    local scratchUsed = r.GetScratchArenaStats().used
+    r.BeginDrawing()
+    r.DrawMeshInstancedBuffer(cube, material, inst)
+    inst:set(1, r.MatrixTranslate(0, 1, 0))          -- re-uploads only the first block
+    r.DrawMeshInstancedBuffer(cube, material, inst, 10)
+    r.DrawMeshInstancedBuffer(cube, material, inst, 0)
+    r.EndDrawing()
+    T.assert_false("DrawMeshInstancedBuffer: count past the end", pcall(r.DrawMeshInstancedBuffer, cube, material, inst, 301))
+    T.assert_eq("DrawMeshInstancedBuffer: scratch released", r.GetScratchArenaStats().used, scratchUsed)
+    inst = nil
+
+    scene:clear()
+    collectgarbage()
+    r.FlushUnloadQueue()
+    T.assert_eq("CommandBuffer: clear releases the texture", r.GetTextureBudgetStats().managed, 1)
+    r.UnloadTexture(other)
+    r.SetTextureBudget(0)
+    r.CloseWindow()
+end
@@ -153,6 +153,180 @@ mp = r.MemRealloc(mp, 128)
 T.assert_true("MemRealloc returns userdata", type(mp) == "userdata")
 r.MemFree(mp)
 T.assert_true("MemFree no crash", true)
+T.assert_false("MemRealloc rejects full userdata", pcall(r.MemRealloc, r.PixelBuffer(1, 1), 8))
+
+-- ---------------------------------------------------------------------------
+-- Scratch arena (transient marshalling buffers)
+-- ---------------------------------------------------------------------------
+r.ResetScratchArena()
+T.assert_eq("LoadUTF8 via scratch", r.LoadUTF8({72, 105}), "Hi")
+local st = r.GetScratchArenaStats()
+T.assert_eq("scratch released after call", st.used, 0)
+T.assert_true("scratch peak recorded", st.peak >= 8)
+
+local big = {}
+for i = 1, 20000 do big[i] = 65 end            -- 80000 bytes: outgrows the first block
+T.assert_eq("large codepoint list", #r.LoadUTF8(big), 20000)
+st = r.GetScratchArenaStats()
+T.assert_eq("scratch chained a second block", st.blocks, 2)
+r.ResetScratchArena()
+st = r.GetScratchArenaStats()
+T.assert_eq("reset folds chain into one block", st.blocks, 1)
+T.assert_true("folded block fits the peak", st.capacity >= 80000)
+
+T.assert_false("bad element raises", pcall(r.LoadUTF8, {65, "x"}))
+T.assert_true("error strands scratch until reset", r.GetScratchArenaStats().used > 0)
+r.ResetScratchArena()
+T.assert_eq("reset reclaims stranded scratch", r.GetScratchArenaStats().used, 0)
+
+-- ---------------------------------------------------------------------------
+-- Pool allocator (opt-in: nothing is chained on require)
+-- ---------------------------------------------------------------------------
+T.assert_false("pools are opt-in", r.GetAllocatorStats().luaPooled)
+T.assert_true("EnablePoolAllocator chains the pools", r.EnablePoolAllocator())
+T.assert_true("EnablePoolAllocator is idempotent", r.EnablePoolAllocator())
+local as = r.GetAllocatorStats()
+T.assert_true("Lua state uses the pools", as.luaPooled)
+T.assert_eq("16 size classes", #as.classes, 16)
+T.assert_eq("largest class", as.classes[16].size, 256)
+local keep = {}
+for i = 1, 1000 do keep[i] = {x = i, y = i} end
+local as2 = r.GetAllocatorStats()
+T.assert_true("small tables come from the pools", as2.current.pooled - as.current.pooled >= 1000)
+T.assert_true("live blocks grow", as2.liveBlocks >= as.liveBlocks + 1000)
+keep = nil
+collectgarbage("collect")
+T.assert_true("collected tables return to the pools", r.GetAllocatorStats().liveBlocks < as2.liveBlocks - 900)
+local big = string.rep("x", 4096) .. "!"            -- above the largest class: system allocator
+T.assert_true("large blocks fall back", r.GetAllocatorStats().current.fallback > as2.current.fallback)
+
+-- ---------------------------------------------------------------------------
+-- Deferred resource finalizers (no window / audio device: loads fail and
+-- return zeroed handles, which are still owned and finalized)
+-- ---------------------------------------------------------------------------
+r.FlushUnloadQueue()
+local tex = r.LoadTexture("/nonexistent/missing.png")
+do
+    local scoped <close> = tex
+end
+T.assert_eq("__close queues the texture", r.GetUnloadQueueSize(), 1)
+T.assert_eq("no window: queued entry dropped", r.FlushUnloadQueue(), 0)
+T.assert_eq("queue drained", r.GetUnloadQueueSize(), 0)
+r.UnloadTexture(tex)                 -- already released: must not reach raylib
+T.assert_eq("explicit unload after close is a no-op", r.GetUnloadQueueSize(), 0)
+
+local snd = r.LoadSound("/nonexistent/missing.wav")
+r.UnloadSound(snd)
+snd = nil
+collectgarbage("collect")
+T.assert_eq("explicitly unloaded sound is not re-queued", r.GetUnloadQueueSize(), 0)
+for _ = 1, 3 do r.LoadSound("/nonexistent/missing.wav") end
+collectgarbage("collect")
+T.assert_eq("collected sounds are queued", r.GetUnloadQueueSize(), 3)
+r.FlushUnloadQueue()
+for _ = 1, 100 do r.LoadSound("/nonexistent/missing.wav") end
+collectgarbage("collect")
+T.assert_eq("queue slots reserved past the initial capacity", r.GetUnloadQueueSize(), 100)
+r.FlushUnloadQueue()
+
+-- ---------------------------------------------------------------------------
+-- Asset cache (a null-backend audio device is enough for LoadSound)
+-- ---------------------------------------------------------------------------
+local frames = 800
+local wavPath = tmpdir .. "/beep.wav"
+local wf = io.open(wavPath, "wb")
+wf:write("RIFF", string.pack("<I4", 36 + frames * 2), "WAVE",
+         "fmt ", string.pack("<I4I2I2I4I4I2I2", 16, 1, 1, 8000, 16000, 2, 16),
+         "data", string.pack("<I4", frames * 2), string.rep("\0\64", frames))
+wf:close()
+
+r.InitAudioDevice()
+if r.IsAudioDeviceReady() then
+    local before = r.GetAssetCacheStats()
+    local s1 = r.LoadSound(wavPath)
+    local s2 = r.LoadSound(tmpdir .. "/./sub/../beep.wav")
+    T.assert_true("cache hit returns the same handle", rawequal(s1, s2))
+    local st = r.GetAssetCacheStats()
+    T.assert_eq("one miss", st.misses - before.misses, 1)
+    T.assert_eq("one hit", st.hits - before.hits, 1)
+    T.assert_true("hit counts saved bytes", st.bytesSaved > before.bytesSaved)
+
+    r.UnloadSound(s1)                    -- drops one of two references
+    T.assert_true("shared sound survives first unload", r.IsSoundValid(s2))
+    T.assert_true("still cached", rawequal(r.LoadSound(wavPath), s1))
+    r.UnloadSound(s1)
+    r.UnloadSound(s1)                    -- last reference: unloaded and evicted
+    T.assert_false("evicted after last unload", rawequal(r.LoadSound(wavPath), s1))
+    T.assert_false("missing file is not cached", r.IsSoundValid(r.LoadSound(tmpdir .. "/nope.wav")))
+    local function closeShared()          -- own frame: nothing lingers in registers
+        local path = tmpdir .. "/beep-close.wav"
+        local src, dst = io.open(wavPath, "rb"), io.open(path, "wb")
+        dst:write(src:read("a"))
+        src:close()
+        dst:close()
+        r.FlushUnloadQueue()
+        local shared = r.LoadSound(path)
+        do
+            local scoped <close> = r.LoadSound(path)
+        end
+        T.assert_true("__close drops one shared reference", r.IsSoundValid(shared))
+        T.assert_eq("__close keeps a shared handle off the queue", r.GetUnloadQueueSize(), 0)
+        do
+            local scoped <close> = shared
+        end
+        T.assert_eq("__close queues the last reference", r.GetUnloadQueueSize(), 1)
+        local reloaded = r.LoadSound(path)
+        T.assert_false("closed handle leaves the cache", rawequal(reloaded, shared))
+        r.UnloadSound(reloaded)
+        os.remove(path)
+    end
+    closeShared()
+    s1, s2 = nil, nil
+    collectgarbage("collect")
+    T.assert_eq("collected entries leave the cache", r.GetAssetCacheStats().entries, before.entries)
+    r.CloseAudioDevice()
+    T.assert_eq("CloseAudioDevice drains the queue", r.GetUnloadQueueSize(), 0)
+end
+os.remove(wavPath)
+
+-- ---------------------------------------------------------------------------
+-- Texture VRAM budget (needs a window; skipped where none can be opened)
+-- ---------------------------------------------------------------------------
+r.SetConfigFlags(0x80)                               -- FLAG_WINDOW_HIDDEN
+r.InitWindow(64, 64, "texture budget")
+if r.IsWindowReady() then
+    local img = r.GenImageColor(16, 16, {r = 255, g = 0, b = 0, a = 255})   -- 1 KiB as RGBA8
+    r.SetTextureBudget(2048)
+    local ta = r.LoadTextureFromImage(img)
+    local tb = r.LoadTextureFromImage(img)
+    local tc = r.LoadTextureFromImage(img)
+    local bs = r.GetTextureBudgetStats()
+    T.assert_eq("budget: all managed", bs.managed, 3)
+    T.assert_eq("budget: nothing evicted before a frame ends", bs.evictions, 0)
+
+    r.BeginDrawing()
+    r.DrawTexture(tc, 0, 0, {r = 255, g = 255, b = 255, a = 255})
+    r.EndDrawing()                                   -- oldest undrawn texture goes
+    bs = r.GetTextureBudgetStats()
+    T.assert_eq("budget: evicted the LRU texture", bs.evictions, 1)
+    T.assert_eq("budget: fits after eviction", bs.residentBytes, 2048)
+
+    r.BeginDrawing()
+    r.DrawTexture(ta, 0, 0, {r = 255, g = 255, b = 255, a = 255})       -- reloads from the image copy
+    bs = r.GetTextureBudgetStats()
+    T.assert_eq("budget: drawn texture reloaded", bs.reloads, 1)
+    T.assert_eq("budget: reload evicted the next coldest", bs.evictions, 2)
+    T.assert_true("budget: reloaded texture valid", r.IsTextureValid(ta))
+    r.EndDrawing()
+
+    r.SetTextureBudget(0)
+    r.UnloadTexture(ta)
+    r.UnloadTexture(tb)
+    r.UnloadTexture(tc)
+    T.assert_eq("budget: unloads leave the list", r.GetTextureBudgetStats().managed, 0)
+    r.UnloadImage(img)
+    r.CloseWindow()
+end
 
 -- ---------------------------------------------------------------------------
 -- Cleanup
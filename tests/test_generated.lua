@@ -0,0 +1,35 @@
+-- Tests for the bindings generated from raylib.h / raymath.h by
+-- tools/gen_bindings.lua (src/lua_raylib_generated.c).
+local T = ...
+local r = T.raylib
+
+-- Scalars
+T.assert_approx("Clamp",   r.Clamp(5, 0, 2), 2)
+T.assert_approx("Lerp",    r.Lerp(0, 10, 0.25), 2.5)
+T.assert_approx("Remap",   r.Remap(5, 0, 10, 0, 100), 50)
+T.assert_eq    ("FloatEquals", r.FloatEquals(1.0, 1.0), 1)
+
+-- Vector results are tables by default and accept any vector form as input
+local v = r.Vector2Add({x = 1, y = 2}, r.Vector2(3, 4))
+T.assert_eq    ("Vector2Add returns table", type(v), "table")
+T.assert_approx("Vector2Add x", v.x, 4)
+T.assert_approx("Vector2Add y", v.y, 6)
+T.assert_approx("Vector2Length", r.Vector2Length({x = 3, y = 4}), 5)
+T.assert_approx("Vector3Length (const param)", r.Vector3Length({x = 0, y = 3, z = 4}), 5)
+local c = r.Vector3CrossProduct({x = 1, y = 0, z = 0}, {x = 0, y = 1, z = 0})
+T.assert_approx("Vector3CrossProduct z", c.z, 1)
+
+-- Shared marshaller, optional destination
+local dst = r.Vector2()
+T.assert_true  ("Vector2Subtract fills destination", rawequal(r.Vector2Subtract({x = 5, y = 5}, {x = 1, y = 2}, dst), dst))
+T.assert_approx("Vector2Subtract destination y", dst.y, 3)
+
+-- Quaternions map onto Vector4, matrices onto the Matrix userdata
+local q = r.QuaternionFromEuler(0, 0, 0)
+T.assert_approx("QuaternionFromEuler identity w", q.w, 1)
+local m = r.QuaternionToMatrix(q)
+T.assert_true  ("QuaternionToMatrix returns Matrix", m == r.Matrix())
+local p = r.Vector3Transform({x = 1, y = 2, z = 3}, r.MatrixTranslate(1, 1, 1))
+T.assert_approx("Vector3Transform", p.z, 4)
+
+T.assert_false("generated binding checks its arguments", pcall(r.Vector2Add, 1, 2))
@@ -55,3 +55,75 @@ T.assert_false("Image rejected where Wave expected", (pcall(r.IsWaveValid, img))
 T.assert_true("UnloadImage accepts copy",     (pcall(r.UnloadImage, copy)))
 T.assert_true("UnloadImage accepts checked",  (pcall(r.UnloadImage, checked)))
 T.assert_true("UnloadImage accepts original", (pcall(r.UnloadImage, img)))
+
+-- PixelBuffer: owned RGBA8 pixels with packed-integer access
+local src = r.GenImageColor(3, 2, r.RED)
+local pb = r.LoadImageColors(src)
+T.assert_eq("LoadImageColors returns PixelBuffer", #pb, 6)
+T.assert_eq("PixelBuffer width", pb.width, 3)
+T.assert_eq("PixelBuffer height", pb.height, 2)
+T.assert_eq("PixelBuffer get packed", pb:get(1), r.RED)
+pb:set(6, 0x11223344)
+T.assert_eq("PixelBuffer set packed", pb:get(6), 0x11223344)
+pb:set(5, {r = 1, g = 2, b = 3, a = 4})
+T.assert_eq("PixelBuffer set table", pb:get(5), 0x01020304)
+T.assert_false("PixelBuffer index range", pcall(pb.get, pb, 7))
+
+local canvas = r.PixelBuffer(4, 4, r.BLACK)
+canvas:blit(pb, 2, 3)                               -- clipped to 2x1
+T.assert_eq("blit copies", canvas:get(3 * 4 + 3), r.RED)
+T.assert_eq("blit clips", canvas:get(3 * 4 + 2), r.BLACK)
+canvas:blit(pb, -1, -1)                             -- source row 2, cols 2..3
+T.assert_eq("blit negative offset", canvas:get(2), 0x11223344)
+canvas:fill(r.WHITE)
+T.assert_eq("PixelBuffer fill", canvas:get(16), r.WHITE)
+
+local fromPb = r.LoadImageFromPixelBuffer(pb)
+T.assert_eq("LoadImageFromPixelBuffer pixel", r.GetImageColor(fromPb, 2, 1).a, 0x44)
+r.UnloadImage(fromPb)
+
+local RGBA8, RGBA32F = 7, 10                            -- PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 / R32G32B32A32
+local px = r.PixelBuffer(1, 1, 0x10203040)
+T.assert_eq("GetPixelColor reads PixelBuffer", r.GetPixelColor(px, RGBA8).b, 0x30)
+r.SetPixelColor(px, 0x55667788, RGBA8)
+T.assert_eq("SetPixelColor writes PixelBuffer", px:get(1), 0x55667788)
+T.assert_eq("SetPixelColor keeps PixelBuffer header", px.width, 1)
+T.assert_false("GetPixelColor PixelBuffer too small",
+    pcall(r.GetPixelColor, px, RGBA32F))
+T.assert_false("GetPixelColor rejects full userdata", pcall(r.GetPixelColor, r.Vector2(0, 0), RGBA8))
+r.MemFree(px)
+T.assert_eq("MemFree releases PixelBuffer", #px, 0)
+T.assert_false("GetPixelColor unloaded PixelBuffer", pcall(r.GetPixelColor, px, RGBA8))
+
+r.UnloadImageColors(pb)
+T.assert_false("unloaded PixelBuffer rejected", pcall(pb.get, pb, 1))
+T.assert_eq("unloaded PixelBuffer empty", #pb, 0)
+local pal, n = r.LoadImagePalette(src, 8)
+T.assert_eq("LoadImagePalette count", n, 1)
+T.assert_eq("LoadImagePalette PixelBuffer", pal:get(1), r.RED)
+r.UnloadImage(src)
+
+-- ---------------------------------------------------------------------------
+-- Resource accounting: Images are counted from creation to UnloadImage
+-- ---------------------------------------------------------------------------
+local base = r.GetResourceStats()
+local acc = r.GenImageColor(16, 8, RED)                -- RGBA8: 512 bytes
+local st = r.GetResourceStats()
+T.assert_eq("stats count image", st.Image.count - base.Image.count, 1)
+T.assert_eq("stats image cpu bytes", st.Image.cpuBytes - base.Image.cpuBytes, 16 * 8 * 4)
+T.assert_eq("stats image no gpu bytes", st.Image.gpuBytes, base.Image.gpuBytes)
+T.assert_eq("stats total follows", st.total.cpuBytes - base.total.cpuBytes, 512)
+
+r.ImageResize(acc, 32, 8)                               -- in-place resize is re-counted
+T.assert_eq("stats after resize", r.GetResourceStats().Image.cpuBytes - base.Image.cpuBytes, 1024)
+r.ImageFormat(acc, 1)                                  -- PIXELFORMAT_UNCOMPRESSED_GRAYSCALE
+T.assert_eq("stats after format", r.GetResourceStats().Image.cpuBytes - base.Image.cpuBytes, 256)
+
+r.UnloadImage(acc)
+r.UnloadImage(acc)                                      -- second unload is ignored
+st = r.GetResourceStats()
+T.assert_eq("stats count after unload", st.Image.count, base.Image.count)
+T.assert_eq("stats bytes after unload", st.Image.cpuBytes, base.Image.cpuBytes)
+T.assert_true("peak keeps the high-water mark", st.Image.peakCpuBytes >= base.Image.cpuBytes + 1024)
+r.ResetResourcePeaks()
+T.assert_eq("ResetResourcePeaks", r.GetResourceStats().Image.peakCpuBytes, st.Image.cpuBytes)
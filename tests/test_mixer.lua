@@ -0,0 +1,336 @@
+-- tests/test_mixer.lua
+-- Audio produced or processed on the mixer thread (AudioRing, AudioGraph,
+-- Synth), PCM held in SampleBuffers and SoundPool voices
+
+local T = ...
+local r = T.raylib
+
+-- ---------------------------------------------------------------------------
+-- Argument checks (no audio device needed)
+-- ---------------------------------------------------------------------------
+T.assert_false("AudioRing: needs an AudioStream", pcall(r.AudioRing, {}))
+T.assert_false("AudioRing: rejects an unloaded stream", pcall(r.AudioRing, r.LoadAudioStream(8000, 16, 1)))
+local ok, err = pcall(r.SetAudioStreamCallback, r.LoadAudioStream(8000, 16, 1), function() end)
+T.assert_true("SetAudioStreamCallback: points to AudioRing", not ok and err:find("AudioRing", 1, true) ~= nil)
+ok, err = pcall(r.AttachAudioMixedProcessor, function() end)
+T.assert_true("AttachAudioMixedProcessor: points to AudioGraph", not ok and err:find("AudioGraph", 1, true) ~= nil)
+T.assert_false("AttachAudioStreamProcessor: removed", pcall(r.AttachAudioStreamProcessor, r.LoadAudioStream(8000, 16, 1), function() end))
+
+-- ---------------------------------------------------------------------------
+-- SampleBuffer (no audio device needed)
+-- ---------------------------------------------------------------------------
+local sb = r.SampleBuffer(4, 2)
+T.assert_eq("SampleBuffer: length is frames", #sb, 4)
+T.assert_eq("SampleBuffer: channels", sb.channels, 2)
+T.assert_eq("SampleBuffer: float by default", sb.sampleSize, 32)
+T.assert_eq("SampleBuffer: starts silent", sb:get(8), 0)
+sb:set(1, 0.5)
+T.assert_approx("SampleBuffer: set/get", sb:get(1), 0.5)
+sb:setRange(3, {0.25, -0.25})
+T.assert_approx("SampleBuffer: setRange", sb:get(4), -0.25)
+sb:fill(0.125, 4)
+T.assert_approx("SampleBuffer: fill a frame range", sb:get(8), 0.125)
+T.assert_approx("SampleBuffer: fill leaves earlier frames", sb:get(1), 0.5)
+T.assert_false("SampleBuffer: index range", pcall(sb.get, sb, 9))
+T.assert_false("SampleBuffer: setRange past the end", pcall(sb.setRange, sb, 8, {0, 0}))
+T.assert_false("SampleBuffer: rejects other sample sizes", pcall(r.SampleBuffer, 4, 2, 8))
+
+local pcm16 = r.SampleBuffer(8, 1, 16)
+T.assert_approx("SampleBuffer: sine returns the wrapped next phase", pcm16:sine(1000, 8000, 1, 0), 0, 1e-6)
+T.assert_approx("SampleBuffer: 16-bit quantizes", pcm16:get(3), 1, 1e-4)
+pcm16:set(1, 4)
+T.assert_approx("SampleBuffer: 16-bit clips", pcm16:get(1), 1, 1e-4)
+local mono = r.SampleBuffer(8, 1)
+mono:fill(0.25)
+mono:mix(pcm16, 0.5)
+T.assert_approx("SampleBuffer: mix across formats", mono:get(3), 0.75, 1e-4)
+T.assert_false("SampleBuffer: mix needs matching channels", pcall(mono.mix, mono, sb))
+
+local wave = r.LoadWaveFromSamples(sb, 22050)
+T.assert_true("LoadWaveFromSamples: valid wave", r.IsWaveValid(wave))
+local back = r.LoadWaveSamples(wave)
+T.assert_eq("LoadWaveSamples: returns a SampleBuffer", #back, 4)
+T.assert_approx("LoadWaveSamples: round trip", back:get(4), -0.25)
+r.UnloadWaveSamples(back)
+T.assert_false("UnloadWaveSamples: buffer unloaded", pcall(back.get, back, 1))
+r.UnloadWave(wave)
+local freed = r.SampleBuffer(8, 1)
+r.MemFree(freed)
+T.assert_eq("MemFree: releases SampleBuffer", #freed, 0)
+T.assert_false("MemFree: released SampleBuffer rejected", pcall(freed.get, freed, 1))
+T.assert_false("MemRealloc: rejects SampleBuffer", pcall(r.MemRealloc, r.SampleBuffer(8, 1), 64))
+
+-- ---------------------------------------------------------------------------
+-- AudioGraph, run offline (no audio device needed)
+-- ---------------------------------------------------------------------------
+local function stereo(frames, fn)
+    local t = {}
+    for i = 0, frames - 1 do
+        local l, rr = fn(i)
+        t[2 * i + 1], t[2 * i + 2] = l, rr or l
+    end
+    return t
+end
+
+local g = r.AudioGraph()
+T.assert_eq("AudioGraph: starts with the input node", #g, 1)
+local sr = g:stats().sampleRate
+T.assert_true("AudioGraph: knows its sample rate", sr > 0)
+local gain = g:add("gain", {gain = 0.5})
+T.assert_eq("add: returns the node id", gain, 2)
+local out = g:process({1, -1, 0.5, 0.25})
+T.assert_approx("gain: scales left", out[1], 0.5)
+T.assert_approx("gain: scales right", out[2], -0.5)
+T.assert_approx("gain: holds after the ramp", out[4], 0.125)
+T.assert_eq("process: keeps the frame count", #out, 4)
+local packed = g:process(string.pack("<ffff", 1, 1, 1, 1))
+T.assert_approx("process: float32 strings", (string.unpack("<f", packed, 5)), 0.5)
+T.assert_true("set: applies directly while detached", g:set(gain, "gain", 2))
+T.assert_approx("set: ramps to the new gain", g:process({1, 1, 1, 1})[3], 2)
+
+local pan = g:add("pan", {pan = 1})
+out = g:process(stereo(4, function() return 1 end))
+T.assert_approx("pan: right silences left", out[7], 0)
+T.assert_approx("pan: right keeps right", out[8], 2)
+
+local bus = g:add("bus", nil, 1, gain)
+out = g:process({1, 1})
+T.assert_approx("bus: sums its inputs", out[1], 3)
+g:setOutput(pan)
+T.assert_approx("setOutput: picks the node written back", g:process({1, 1})[2], 2)
+
+local lp = r.AudioGraph()
+lp:add("biquad", {type = "lowpass", freq = 200, q = 0.7071})
+local function rms(graph, freq)
+    local t = graph:process(stereo(4096, function(i) return math.sin(2 * math.pi * freq * i / sr) end))
+    local sum = 0
+    for i = 4001, 8192, 2 do sum = sum + t[i] * t[i] end
+    return math.sqrt(sum / 2096)
+end
+T.assert_true("biquad: lowpass passes low frequencies", rms(lp, 50) > 0.6)
+T.assert_true("biquad: lowpass cuts high frequencies", rms(lp, 8000) < 0.01)
+lp:set(2, "type", "highpass")
+T.assert_true("biquad: type changes by name", rms(lp, 8000) > 0.6)
+T.assert_false("biquad: rejects an unknown type", pcall(lp.set, lp, 2, "type", "allpass"))
+
+local dg = r.AudioGraph()
+dg:add("delay", {time = 10 / sr, feedback = 0, mix = 1, maxTime = 0.01})
+out = dg:process(stereo(16, function(i) return i == 0 and 1 or 0 end))
+T.assert_approx("delay: impulse arrives after the delay", out[21], 1)
+T.assert_approx("delay: nothing before it", out[19], 0)
+
+local cg = r.AudioGraph()
+cg:add("compressor", {threshold = -20, ratio = 10, attack = 0, release = 0.1})
+out = cg:process(stereo(64, function() return 1 end))
+T.assert_approx("compressor: reduces above the threshold", out[127], 10 ^ ((-20 + 20 * 0.1 - 0) / 20) * 1, 1e-3)
+
+T.assert_false("add: rejects an unknown kind", pcall(g.add, g, "reverb"))
+T.assert_false("add: rejects an unknown input node", pcall(g.add, g, "gain", nil, 99))
+T.assert_false("add: rejects a bad parameter", pcall(g.add, g, "gain", {gain = "loud"}))
+T.assert_eq("add: failed adds leave no node", #g, 4)
+T.assert_false("set: rejects an unknown parameter", pcall(g.set, g, gain, "freq", 1))
+T.assert_false("connect: only from earlier nodes", pcall(g.connect, g, bus, gain))
+T.assert_false("attach: rejects other values", pcall(g.attach, g, {}))
+
+-- ---------------------------------------------------------------------------
+-- Synth, rendered offline (no audio device needed)
+-- ---------------------------------------------------------------------------
+local syn = r.Synth(2, 8000)
+syn:set("attack", 0)
+syn:set("decay", 0)
+syn:set("sustain", 1)
+syn:set("release", 0)
+syn:set("volume", 1)
+local block = r.SampleBuffer(16, 2)
+syn:noteOn(69)
+syn:render(block)
+T.assert_approx("Synth: sine at the note's frequency", block:get(7), math.sin(2 * math.pi * 440 * 3 / 8000), 1e-3)
+T.assert_approx("Synth: same sample on every channel", block:get(8), block:get(7))
+T.assert_eq("Synth: one voice active", syn:stats().active, 1)
+syn:noteOff(69)
+syn:render(block)
+T.assert_eq("Synth: release ends the voice", syn:stats().active, 0)
+T.assert_eq("Synth: silent once released", block:get(31), 0)
+
+syn:set("wave", "square")
+syn:noteOn(57, 0.5)
+syn:render(block)
+T.assert_approx("Synth: square wave at the velocity", block:get(9), 0.5, 1e-3)
+syn:noteOn(60, 1, "saw")
+syn:noteOn(64)
+syn:render(block)
+T.assert_eq("Synth: polyphony is capped by the voice count", syn:stats().active, 2)
+syn:allOff()
+syn:render(block)
+T.assert_eq("Synth: allOff releases every voice", syn:stats().active, 0)
+
+local noise = r.SampleBuffer(256, 1, 16)
+syn:noteOn(60, 1, "noise")
+syn:render(noise)
+local lo, hi = 0, 0
+for i = 1, 256 do lo, hi = math.min(lo, noise:get(i)), math.max(hi, noise:get(i)) end
+T.assert_true("Synth: noise spans both signs", lo < -0.1 and hi > 0.1)
+T.assert_false("Synth: rejects an unknown wave", pcall(syn.noteOn, syn, 60, 1, "triangle"))
+T.assert_false("Synth: rejects an unknown parameter", pcall(syn.set, syn, "cutoff", 1))
+T.assert_false("Synth: note out of range", pcall(syn.noteOn, syn, 200))
+T.assert_false("Synth: sustain out of range", pcall(syn.set, syn, "sustain", 2))
+T.assert_false("Synth: attach needs an AudioStream", pcall(syn.attach, syn, {}))
+do
+    local scoped <close> = syn
+end
+T.assert_false("Synth: noteOn after __close is rejected", pcall(syn.noteOn, syn, 60))
+T.assert_false("Synth: render after __close is rejected", pcall(syn.render, syn, block))
+T.assert_false("SoundPool: needs a Sound", pcall(r.SoundPool, {}, 4))
+
+-- ---------------------------------------------------------------------------
+-- Feeding a stream (a null-backend audio device runs a real mixer thread)
+-- ---------------------------------------------------------------------------
+r.InitAudioDevice()
+if r.IsAudioDeviceReady() then
+    local stream = r.LoadAudioStream(8000, 16, 1)
+    T.assert_false("AudioRing: rejects a frame count of zero", pcall(r.AudioRing, stream, 0))
+    local ring = r.AudioRing(stream, 3000)
+    local st = ring:stats()
+    T.assert_eq("AudioRing: capacity rounds up to a power of two", st.capacity, 4096)
+    T.assert_true("AudioRing: attached on creation", st.attached)
+    T.assert_eq("AudioRing: starts empty", #ring, 0)
+    T.assert_eq("AudioRing: all space free", ring:space(), 4096)
+
+    T.assert_eq("push: raw PCM string", ring:push(string.rep("\0\64", 1000)), 1000)
+    T.assert_eq("push: float array", ring:push({0.5, -0.5, 0.25, -0.25}), 4)
+    T.assert_eq("push: explicit frame count", ring:push({0, 0, 0, 0}, 2), 2)
+    T.assert_eq("push: buffered frames", #ring, 1006)
+    T.assert_false("push: frame count past the data", pcall(ring.push, ring, "\0\0", 2))
+    T.assert_false("push: rejects non-numbers", pcall(ring.push, ring, {0, "x"}))
+
+    T.assert_eq("push: stops when full", ring:push(string.rep("\0\0", 4000)), 4096 - 1006)
+    st = ring:stats()
+    T.assert_eq("push: overrun counted", st.overruns, 1)
+    T.assert_eq("push: dropped frames counted", st.overrunFrames, 4000 - (4096 - 1006))
+    T.assert_eq("push: no space left", ring:space(), 0)
+
+    r.PlayAudioStream(stream)
+    local deadline = r.GetTime() + 2
+    while ring:stats().underruns == 0 and r.GetTime() < deadline do r.WaitTime(0.05) end
+    st = ring:stats()
+    T.assert_eq("mixer: drains the ring", st.buffered, 0)
+    T.assert_true("mixer: counts the underrun once dry", st.underruns > 0 and st.underrunFrames > 0)
+
+    local graph = r.AudioGraph()
+    local gnode = graph:add("gain", {gain = 0.5})
+    graph:attach(stream)
+    T.assert_true("AudioGraph: attached to a stream", graph:stats().attached)
+    T.assert_false("AudioGraph: nodes are fixed while attached", pcall(graph.add, graph, "pan"))
+    T.assert_false("AudioGraph: no offline processing while attached", pcall(graph.process, graph, {0, 0}))
+    T.assert_true("AudioGraph: set is queued while attached", graph:set(gnode, "gain", 0.25))
+    ring:push(string.rep("\0\64", 2000))
+    deadline = r.GetTime() + 2
+    while graph:stats().messagesApplied == 0 and r.GetTime() < deadline do r.WaitTime(0.05) end
+    local gs = graph:stats()
+    T.assert_true("AudioGraph: runs on the mixer", gs.framesProcessed > 0)
+    T.assert_eq("AudioGraph: mixer applies queued changes", gs.messagesApplied, 1)
+    graph:attach()
+    T.assert_true("AudioGraph: re-attaches to the final mix", graph:stats().attached)
+    graph:detach()
+    T.assert_false("AudioGraph: detached", graph:stats().attached)
+    dg:attach()
+    T.assert_eq("AudioGraph: attach retunes to the device rate", dg:stats().sampleRate, graph:stats().sampleRate)
+    dg:detach()
+    out = dg:process(stereo(16, function(i) return i == 0 and 1 or 0 end))
+    T.assert_true("AudioGraph: delay line survives a retune", out[1] == 0)
+    do
+        local scoped <close> = dg
+    end
+    T.assert_false("AudioGraph: add after __close is rejected", pcall(dg.add, dg, "gain"))
+    T.assert_false("AudioGraph: process after __close is rejected", pcall(dg.process, dg, {0, 0}))
+    T.assert_false("AudioGraph: attach after __close is rejected", pcall(dg.attach, dg))
+
+    local synth = r.Synth(4)
+    synth:attach(stream)
+    T.assert_false("Synth: replaces the ring as the stream's feed", ring:stats().attached)
+    local ss = synth:stats()
+    T.assert_true("Synth: attached", ss.attached)
+    T.assert_eq("Synth: adopts the stream's sample rate", ss.sampleRate, 8000)
+    T.assert_false("Synth: no offline render while attached", pcall(synth.render, synth, r.SampleBuffer(4, 1)))
+    synth:noteOn(60)
+    T.assert_eq("Synth: events are queued while attached", synth:stats().eventsQueued, 1)
+    deadline = r.GetTime() + 2
+    while synth:stats().active == 0 and r.GetTime() < deadline do r.WaitTime(0.05) end
+    ss = synth:stats()
+    T.assert_eq("Synth: mixer plays the note", ss.active, 1)
+    T.assert_true("Synth: renders on the mixer", ss.framesRendered > 0 and ss.eventsApplied == 1)
+    synth:detach()
+    T.assert_false("Synth: detached", synth:stats().attached)
+
+    ring:detach()
+    T.assert_false("detach: no longer attached", ring:stats().attached)
+    local tone = r.SampleBuffer(64, 1, 16)
+    tone:sine(440, 8000)
+    T.assert_eq("push: SampleBuffer in place", ring:push(tone), 64)
+    T.assert_false("push: SampleBuffer format must match", pcall(ring.push, ring, r.SampleBuffer(4, 2, 16)))
+    T.assert_true("UpdateAudioStream: takes a SampleBuffer", pcall(r.UpdateAudioStream, stream, tone, 32))
+    T.assert_false("UpdateAudioStream: SampleBuffer format must match", pcall(r.UpdateAudioStream, stream, r.SampleBuffer(4, 1)))
+    T.assert_false("UpdateAudioStream: no more frames than held", pcall(r.UpdateAudioStream, stream, tone, 65))
+    local snd = r.LoadSoundFromWave(r.LoadWaveFromSamples(r.SampleBuffer(100, 1), 8000))
+    T.assert_true("UpdateSound: takes a SampleBuffer", pcall(r.UpdateSound, snd, r.SampleBuffer(50, 2)))
+    T.assert_false("UpdateSound: no more frames than the sound", pcall(r.UpdateSound, snd, r.SampleBuffer(100000, 2)))
+    r.UnloadSound(snd)
+
+    local source = r.LoadSoundFromWave(r.LoadWaveFromSamples(r.SampleBuffer(8000, 1), 8000))   -- one second
+    local pool = r.SoundPool(source, 2)
+    T.assert_eq("SoundPool: preallocates its voices", #pool, 2)
+    T.assert_eq("SoundPool: idle at first", pool:active(), 0)
+    T.assert_eq("SoundPool: first free voice", pool:play(), 1)
+    T.assert_eq("SoundPool: next free voice", pool:play(0.5), 2)
+    T.assert_eq("SoundPool: every voice busy", pool:active(), 2)
+    T.assert_eq("SoundPool: steals the oldest", pool:play(), 1)
+    local ps = pool:stats()
+    T.assert_eq("SoundPool: counts steals", ps.stolen, 1)
+    T.assert_eq("SoundPool: counts plays", ps.played, 3)
+    T.assert_true("SoundPool: voices are Sounds", r.IsSoundPlaying(pool:voice(2)))
+    T.assert_false("SoundPool: a voice cannot be unloaded as an alias", pcall(r.UnloadSoundAlias, pool:voice(2)))
+    T.assert_false("SoundPool: a voice cannot be unloaded as a Sound", pcall(r.UnloadSound, pool:voice(2)))
+    do local v <close> = pool:voice(2) end
+    T.assert_true("SoundPool: closing a voice leaves it to the pool", r.IsSoundPlaying(pool:voice(2)))
+    pool:stop()
+    T.assert_eq("SoundPool: stop silences every voice", pool:active(), 0)
+
+    local quiet = r.SoundPool(source, 2, "quietest")
+    quiet:play(1)
+    quiet:play(0.25)
+    T.assert_eq("SoundPool: steals the quietest", quiet:play(0.8), 2)
+    quiet:setVolume(1, 0.1)          -- voice 1 faded after it started
+    T.assert_eq("SoundPool: quietest sees setVolume", quiet:play(0.9), 1)
+    T.assert_false("SoundPool: setVolume checks the index", pcall(quiet.setVolume, quiet, 3, 1))
+    local capped = r.SoundPool(source, 1, "none")
+    capped:play()
+    T.assert_eq("SoundPool: policy none drops the play", capped:play(), nil)
+    T.assert_eq("SoundPool: counts drops", capped:stats().dropped, 1)
+    capped:release()
+    T.assert_eq("SoundPool: release empties the pool", #capped, 0)
+    T.assert_false("SoundPool: no play after release", pcall(capped.play, capped))
+    T.assert_false("SoundPool: rejects an unknown policy", pcall(r.SoundPool, source, 2, "random"))
+    T.assert_false("SoundPool: needs at least one voice", pcall(r.SoundPool, source, 0))
+    quiet:stop()
+
+    local ring2 = r.AudioRing(stream, 64)
+    ring2:push(string.rep("\0\0", 64))
+    r.UnloadAudioStream(stream)
+    T.assert_false("UnloadAudioStream: detaches its ring", ring2:stats().attached)
+    do
+        local scoped <close> = ring2
+    end
+    T.assert_false("AudioRing: push after __close is rejected", pcall(ring2.push, ring2, "\0\0"))
+    T.assert_false("AudioRing: stats after __close is rejected", pcall(ring2.stats, ring2))
+
+    local rings = {}
+    for i = 1, 16 do
+        rings[i] = r.AudioRing(r.LoadAudioStream(8000, 32, 2), 16)
+    end
+    T.assert_false("AudioRing: slots are limited", pcall(r.AudioRing, r.LoadAudioStream(8000, 8, 1)))
+    rings[1] = nil
+    collectgarbage("collect")
+    T.assert_true("AudioRing: a collected ring frees its slot", pcall(r.AudioRing, r.LoadAudioStream(8000, 8, 1)))
+    r.CloseAudioDevice()
+    T.assert_false("CloseAudioDevice: detaches every ring", rings[2]:stats().attached)
+end
@@ -0,0 +1,215 @@
+-- Tests for the native value types added in lua_raylib_types.c
+-- (Vector2/Vector3/Vector4 userdata and their interop with table-taking bindings).
+local T = ...
+local r = T.raylib
+
+-- ---------------------------------------------------------------------------
+-- Vector2/3/4: construction, field access, assignment
+-- ---------------------------------------------------------------------------
+local v2 = r.Vector2(1.5, -2)
+T.assert_eq("Vector2 type", type(v2), "userdata")
+T.assert_approx("Vector2 x", v2.x, 1.5)
+T.assert_approx("Vector2 y", v2.y, -2)
+T.assert_eq("Vector2 z is nil", v2.z, nil)
+v2.x = 10
+T.assert_approx("Vector2 x after write", v2.x, 10)
+T.assert_false("Vector2 unknown field write errors", pcall(function() v2.z = 1 end))
+T.assert_false("Vector2 non-number write errors", pcall(function() v2.y = "a" end))
+
+local zero = r.Vector2()
+T.assert_approx("Vector2 default x", zero.x, 0)
+T.assert_approx("Vector2 default y", zero.y, 0)
+
+local v3 = r.Vector3(1, 2, 3)
+T.assert_approx("Vector3 z", v3.z, 3)
+T.assert_eq("Vector3 w is nil", v3.w, nil)
+v3.z = 4
+T.assert_approx("Vector3 z after write", v3.z, 4)
+
+local v4 = r.Vector4(1, 2, 3, 4)
+T.assert_approx("Vector4 w", v4.w, 4)
+
+T.assert_true("Vector2 __eq equal", r.Vector2(1, 2) == r.Vector2(1, 2))
+T.assert_false("Vector2 __eq differs", r.Vector2(1, 2) == r.Vector2(2, 1))
+T.assert_true("Vector2 __eq treats -0 as 0", r.Vector2(-0.0, 1) == r.Vector2(0.0, 1))
+T.assert_true("Vector2 __tostring", tostring(r.Vector2(1, 2)):sub(1, 8) == "Vector2(")
+
+-- ---------------------------------------------------------------------------
+-- Userdata vectors are accepted wherever a vector table is
+-- ---------------------------------------------------------------------------
+local rec = {x = 0, y = 0, width = 10, height = 10}
+T.assert_true("CheckCollisionPointRec userdata inside", r.CheckCollisionPointRec(r.Vector2(5, 5), rec))
+T.assert_false("CheckCollisionPointRec userdata outside", r.CheckCollisionPointRec(r.Vector2(50, 5), rec))
+T.assert_true("CheckCollisionPointRec table still works", r.CheckCollisionPointRec({x = 5, y = 5}, rec))
+
+local mid = r.GetSplinePointLinear(r.Vector2(0, 0), {x = 10, y = 20}, 0.5)
+T.assert_approx("GetSplinePointLinear mixed args x", mid.x, 5)
+T.assert_approx("GetSplinePointLinear mixed args y", mid.y, 10)
+
+local poly = { r.Vector2(0, 0), r.Vector2(10, 0), {x = 10, y = 10}, r.Vector2(0, 10) }
+T.assert_true("CheckCollisionPointPoly userdata points", r.CheckCollisionPointPoly(r.Vector2(5, 5), poly))
+
+local n = r.ColorFromNormalized(r.Vector4(1, 0, 0, 1))
+T.assert_eq("ColorFromNormalized Vector4 r", n.r, 255)
+T.assert_eq("ColorFromNormalized Vector4 g", n.g, 0)
+
+T.assert_false("Vector3 rejected where Vector2 expected",
+    pcall(r.CheckCollisionPointRec, r.Vector3(1, 2, 3), rec))
+
+-- ---------------------------------------------------------------------------
+-- Matrix: constructors, field access, destination reuse
+-- ---------------------------------------------------------------------------
+local id = r.MatrixIdentity()
+T.assert_eq("MatrixIdentity type", type(id), "userdata")
+T.assert_approx("MatrixIdentity m0", id.m0, 1)
+T.assert_approx("MatrixIdentity m5", id.m5, 1)
+T.assert_approx("MatrixIdentity m1", id.m1, 0)
+T.assert_eq("Matrix unknown field nil", id.m16, nil)
+
+local tr = r.MatrixTranslate(1, 2, 3)
+T.assert_approx("MatrixTranslate m12", tr.m12, 1)
+T.assert_approx("MatrixTranslate m13", tr.m13, 2)
+T.assert_approx("MatrixTranslate m14", tr.m14, 3)
+
+local out = r.Matrix()
+local ret = r.MatrixTranslate(4, 5, 6, out)
+T.assert_true("MatrixTranslate returns destination", rawequal(ret, out))
+T.assert_approx("MatrixTranslate into destination m12", out.m12, 4)
+
+local prod = r.MatrixMultiply(r.MatrixTranslate(1, 0, 0), r.MatrixTranslate(0, 2, 0))
+T.assert_approx("MatrixMultiply translations m12", prod.m12, 1)
+T.assert_approx("MatrixMultiply translations m13", prod.m13, 2)
+
+local inv = r.MatrixInvert(tr)
+T.assert_approx("MatrixInvert m12", inv.m12, -1)
+T.assert_true("Matrix * inverse == identity", r.MatrixMultiply(tr, inv) == r.MatrixIdentity())
+
+out.m3 = 7
+T.assert_approx("Matrix field write", out.m3, 7)
+T.assert_false("Matrix bad field write errors", pcall(function() out.m99 = 1 end))
+
+-- Table and userdata forms round-trip through the same getter
+local tbl = {}
+for i = 0, 15 do tbl["m" .. i] = i end
+local fromTbl = r.Matrix(tbl)
+T.assert_approx("Matrix from table m7", fromTbl.m7, 7)
+T.assert_approx("Matrix from table m12", fromTbl.m12, 12)
+T.assert_approx("MatrixTranspose of table m7 -> m13", r.MatrixTranspose(tbl).m13, 7)
+
+-- ---------------------------------------------------------------------------
+-- Vec2Array / Vec3Array: packed point buffers
+-- ---------------------------------------------------------------------------
+local pts = r.Vec2Array(4)
+T.assert_eq("Vec2Array length", #pts, 4)
+local x0, y0 = pts:get(1)
+T.assert_approx("Vec2Array zero-initialised", x0 + y0, 0)
+pts:set(1, 0, 0); pts:set(2, 10, 0); pts:set(3, r.Vector2(10, 10)); pts:set(4, {x = 0, y = 10})
+local x3, y3 = pts:get(3)
+T.assert_approx("Vec2Array set/get x", x3, 10)
+T.assert_approx("Vec2Array set/get y", y3, 10)
+T.assert_false("Vec2Array get out of range", pcall(pts.get, pts, 5))
+T.assert_false("Vec2Array set index 0", pcall(pts.set, pts, 0, 1, 1))
+
+T.assert_true("CheckCollisionPointPoly Vec2Array inside", r.CheckCollisionPointPoly(r.Vector2(5, 5), pts))
+T.assert_false("CheckCollisionPointPoly Vec2Array outside", r.CheckCollisionPointPoly({x = 50, y = 5}, pts))
+
+local grow = r.Vec2Array()
+for i = 1, 100 do grow:push(i, -i) end
+T.assert_eq("Vec2Array push grows", #grow, 100)
+local gx, gy = grow:get(100)
+T.assert_approx("Vec2Array pushed x", gx, 100)
+T.assert_approx("Vec2Array pushed y", gy, -100)
+grow:clear()
+T.assert_eq("Vec2Array clear", #grow, 0)
+grow:resize(3)
+T.assert_eq("Vec2Array resize", #grow, 3)
+local rx = grow:get(3)
+T.assert_approx("Vec2Array resize zero-fills", rx, 0)
+
+local fromTable = r.Vec2Array({ {x = 1, y = 2}, r.Vector2(3, 4) })
+T.assert_eq("Vec2Array from table length", #fromTable, 2)
+local fx, fy = fromTable:get(2)
+T.assert_approx("Vec2Array from table x", fx, 3)
+T.assert_approx("Vec2Array from table y", fy, 4)
+
+local p3 = r.Vec3Array({ r.Vector3(1, 2, 3) })
+p3:push(4, 5, 6)
+local a, b, c = p3:get(2)
+T.assert_eq("Vec3Array length", #p3, 2)
+T.assert_approx("Vec3Array get z", c, 6)
+T.assert_false("Vec3Array rejected as Vec2 point list",
+    pcall(r.CheckCollisionPointPoly, r.Vector2(0, 0), p3))
+
+-- Image drawing with a Vec2Array (CPU-side, no window)
+local img = r.GenImageColor(16, 16, r.BLACK)
+local tri = r.Vec2Array({ {x = 0, y = 0}, {x = 15, y = 0}, {x = 0, y = 15} })
+r.ImageDrawTriangleFan(img, tri, r.WHITE)
+T.assert_eq("ImageDrawTriangleFan Vec2Array fills", r.GetImageColor(img, 2, 2).r, 255)
+r.UnloadImage(img)
+
+-- Optional destination for vector/rect/color results
+local outV = r.Vector2()
+local got = r.GetSplinePointLinear({x = 0, y = 0}, {x = 10, y = 20}, 0.5, outV)
+T.assert_true("spline point returns the destination", rawequal(got, outV))
+T.assert_approx("spline point filled x", outV.x, 5)
+T.assert_approx("spline point filled y", outV.y, 10)
+local outT = {}
+T.assert_true("table destination returned", rawequal(r.GetSplinePointLinear({x = 0, y = 0}, {x = 2, y = 2}, 1, outT), outT))
+T.assert_approx("table destination filled", outT.y, 2)
+T.assert_false("bad destination rejected", pcall(r.GetSplinePointLinear, {x = 0, y = 0}, {x = 1, y = 1}, 0, 42))
+
+local p4 = r.Vec4Array({ r.Vector4(1, 2, 3, 4) })
+p4:push(5, 6, 7, 8)
+local _, _, _, w4 = p4:get(2)
+T.assert_eq("Vec4Array length", #p4, 2)
+T.assert_approx("Vec4Array get w", w4, 8)
+
+-- ---------------------------------------------------------------------------
+-- SpriteArray: packed DrawTexturePro parameters
+-- ---------------------------------------------------------------------------
+local sprites = r.SpriteArray(2)
+T.assert_eq("SpriteArray length", #sprites, 2)
+T.assert_eq("SpriteArray default tint is white", select(12, sprites:get(1)), 0xFFFFFFFF)
+sprites:set(2, 0, 0, 16, 16, 100, 50, 32, 32, 16, 16, 45, 0xFF0000FF)
+local sx, _, _, _, dx, dy, _, _, ox, _, rot, tint = sprites:get(2)
+T.assert_approx("SpriteArray set/get dest x", dx, 100)
+T.assert_approx("SpriteArray set/get origin x", ox, 16)
+T.assert_approx("SpriteArray set/get rotation", rot, 45)
+T.assert_eq("SpriteArray set/get tint", tint, 0xFF0000FF)
+sprites:setDest(2, 7, 8)
+sprites:setRotation(2, 90)
+sprites:setTint(2, {r = 0, g = 0, b = 255, a = 128})
+sprites:setSource(2, 16, 0, -16, 16)
+local ssx, _, ssw, _, ddx, ddy, ddw, _, _, _, rot2, tint2 = sprites:get(2)
+T.assert_approx("SpriteArray setDest keeps the size", ddw, 32)
+T.assert_approx("SpriteArray setDest position", ddx + ddy, 15)
+T.assert_approx("SpriteArray setRotation", rot2, 90)
+T.assert_eq("SpriteArray setTint", tint2, 0x0000FF80)
+T.assert_approx("SpriteArray setSource (mirrored)", ssx + ssw, 0)
+T.assert_eq("SpriteArray push returns index", sprites:push(0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0), 3)
+T.assert_false("SpriteArray get out of range", pcall(sprites.get, sprites, 4))
+T.assert_false("SpriteArray set needs every field", pcall(sprites.set, sprites, 1, 0, 0))
+sprites:clear()
+T.assert_eq("SpriteArray clear", #sprites, 0)
+sprites:resize(50)
+T.assert_eq("SpriteArray resize", #sprites, 50)
+
+local rec = {}
+r.GetCollisionRec({x = 0, y = 0, width = 10, height = 10}, {x = 5, y = 5, width = 10, height = 10}, rec)
+T.assert_approx("GetCollisionRec into destination", rec.width, 5)
+
+local col = {}
+T.assert_true("ColorTint returns destination", rawequal(r.ColorTint(r.WHITE, r.RED, col), col))
+T.assert_eq("ColorTint filled", col.r, 230)
+local hsv = r.Vector3()
+r.ColorToHSV(r.RED, hsv)
+T.assert_approx("ColorToHSV into Vector3", hsv.z, 230 / 255, 0.01)
+local cimg = r.GenImageColor(2, 2, r.BLUE)
+T.assert_eq("GetImageColor into destination", r.GetImageColor(cimg, 1, 1, col).b, 241)
+r.UnloadImage(cimg)
+
+-- Cached type checks still reject other userdata with the lauxlib message
+local okCheck, errCheck = pcall(r.IsImageValid, r.Vector2())
+T.assert_false("Vector2 rejected where Image expected", okCheck)
+T.assert_true("type error names the expected type", tostring(errCheck):find("Image expected", 1, true) ~= nil)
+T.assert_false("table rejected where Image expected", pcall(r.IsImageValid, {}))
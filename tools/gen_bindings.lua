@@ -0,0 +1,283 @@
+-- Generates src/lua_raylib_generated.c from the raylib / raymath headers.
+--
+-- Usage (from the repo root; normally via `make generate`):
+--   lua tools/gen_bindings.lua <out.c> <header.h>... -- <hand-written.c>...
+--
+-- Every RLAPI / RMAPI declaration in the headers whose parameter and return
+-- types are all in the tables below is bound, unless one of the hand-written
+-- sources already registers a Lua function of that name. Bindings are grouped
+-- by signature: each distinct signature gets one marshaller that reads its
+-- arguments with the fastest helper for each type and calls the C function it
+-- finds in its upvalue, so e.g. all (Vector2, Vector2) -> Vector2 functions
+-- share a single C wrapper.
+
+local args = { ... }
+local outPath = args[1]
+local headers, sources = {}, {}
+do
+    local list = headers
+    for i = 2, #args do
+        if args[i] == "--" then list = sources else list[#list + 1] = args[i] end
+    end
+end
+assert(outPath and #headers > 0, "usage: lua tools/gen_bindings.lua <out.c> <header.h>... -- <source.c>...")
+
+-- ---------------------------------------------------------------------------
+-- Type tables
+--
+-- code: short tag used in marshaller names.
+-- read: C expression reading stack slot %d.
+-- ret:  C statement(s) returning `r` (the call result) from the marshaller;
+--       %d is the index of the optional destination argument, one past the
+--       last parameter (see return_vector2 and friends).
+-- ---------------------------------------------------------------------------
+
+local function udata(name, tag)
+    tag = tag or name
+    return {
+        code = tag,
+        read = "*(" .. name .. " *)check_udata(L, %d, " .. tag .. ")",
+        ret  = "    " .. name .. " *p = lua_newuserdatauv(L, sizeof(" .. name .. "), 0);\n" ..
+               "    *p = r;\n" ..
+               "    luaL_setmetatable(L, \"" .. tag .. "\");\n" ..
+               "    return 1;",
+    }
+end
+
+local VALUE_TYPES = {
+    ["void"]         = { code = "v", ret = "    return 0;" },
+    ["bool"]         = { code = "b", read = "lua_toboolean(L, %d)", ret = "    lua_pushboolean(L, r);\n    return 1;" },
+    ["int"]          = { code = "i", read = "(int)luaL_checkinteger(L, %d)", ret = "    lua_pushinteger(L, r);\n    return 1;" },
+    ["unsigned int"] = { code = "u", read = "(unsigned int)luaL_checkinteger(L, %d)", ret = "    lua_pushinteger(L, (lua_Integer)r);\n    return 1;" },
+    ["float"]        = { code = "f", read = "(float)luaL_checknumber(L, %d)", ret = "    lua_pushnumber(L, r);\n    return 1;" },
+    ["double"]       = { code = "d", read = "luaL_checknumber(L, %d)", ret = "    lua_pushnumber(L, r);\n    return 1;" },
+    ["const char *"] = { code = "s", read = "luaL_checkstring(L, %d)", ret = "    lua_pushstring(L, r);\n    return 1;" },
+    ["Color"]        = { code = "C", read = "get_color_from_table(L, %d)", ret = "    return return_color(L, %d, r);" },
+    ["Vector2"]      = { code = "V2", read = "get_vector2_from_table(L, %d)", ret = "    return return_vector2(L, %d, r);" },
+    ["Vector3"]      = { code = "V3", read = "get_vector3_from_table(L, %d)", ret = "    return return_vector3(L, %d, r);" },
+    ["Vector4"]      = { code = "V4", read = "get_vector4_from_table(L, %d)", ret = "    return return_vector4(L, %d, r);" },
+    ["Rectangle"]    = { code = "R", read = "get_rectangle_from_table(L, %d)", ret = "    return return_rectangle(L, %d, r);" },
+    ["Matrix"]       = { code = "M", read = "get_matrix_from_table(L, %d)", ret = "    return return_matrix(L, %d, r);" },
+    ["Ray"]          = { code = "Ray", read = "get_ray_from_table(L, %d)" },
+    ["BoundingBox"]  = { code = "BB", read = "get_bounding_box_from_table(L, %d)",
+                         ret = "    push_bounding_box_to_table(L, r);\n    return 1;" },
+    ["RayCollision"] = { code = "RC", ret = "    push_ray_collision_to_table(L, r);\n    return 1;" },
+    ["NPatchInfo"]   = { code = "NP", read = "get_npatchinfo_from_table(L, %d)" },
+    ["Texture2D"]       = udata("Texture2D"),
+    ["TextureCubemap"]  = udata("TextureCubemap"),
+    ["RenderTexture2D"] = udata("RenderTexture2D"),
+    ["Image"]           = udata("Image"),
+    ["Font"]            = udata("Font"),
+    ["Camera"]          = udata("Camera"),
+    ["Shader"]          = udata("Shader"),
+    ["Mesh"]            = udata("Mesh"),
+    ["Material"]        = udata("Material"),
+    ["Model"]           = udata("Model"),
+    ["ModelAnimation"]  = udata("ModelAnimation"),
+    ["Wave"]            = udata("Wave"),
+    ["Sound"]           = udata("Sound"),
+    ["Music"]           = udata("Music"),
+    ["AudioStream"]     = udata("AudioStream"),
+    ["VrStereoConfig"]  = udata("VrStereoConfig"),
+}
+
+-- raylib typedef aliases onto the names above.
+local ALIASES = {
+    ["Quaternion"] = "Vector4", ["Texture"] = "Texture2D", ["RenderTexture"] = "RenderTexture2D",
+    ["Camera3D"] = "Camera",
+}
+
+-- Pointer parameters are only bound for userdata that raylib mutates in place
+-- (ImageFlipVertical(Image *image), UpdateCamera(Camera *camera), ...).
+local POINTER_TYPES = {
+    ["Image"] = true, ["Texture2D"] = true, ["Camera"] = true, ["Mesh"] = true,
+    ["Model"] = true, ["Wave"] = true, ["Font"] = true,
+}
+
+local function resolve(ctype)
+    ctype = ctype:gsub("%s+", " "):gsub(" %*", " *"):gsub("^%s+", ""):gsub("%s+$", "")
+    local base = ctype:match("^(%w+) %*$")
+    if base then
+        base = ALIASES[base] or base
+        if not POINTER_TYPES[base] then return nil end
+        return { code = "p" .. base, read = "check_udata(L, %d, " .. base .. ")", ctype = base .. " *" }
+    end
+    if ctype ~= "const char *" then
+        ctype = ctype:gsub("^const ", "")          -- by-value const is irrelevant to the caller
+        ctype = ALIASES[ctype] or ctype
+    end
+    local t = VALUE_TYPES[ctype]
+    if not t then return nil end
+    return { code = t.code, read = t.read, ret = t.ret, ctype = ctype }
+end
+
+-- ---------------------------------------------------------------------------
+-- Inputs
+-- ---------------------------------------------------------------------------
+
+local function read_file(path)
+    local f = assert(io.open(path, "r"))
+    local s = f:read("a")
+    f:close()
+    return s
+end
+
+-- Names a hand-written source already registers ({"Name", lua_Name} entries).
+local handBound = {}
+for _, path in ipairs(sources) do
+    for name in read_file(path):gmatch('{%s*"([%w_]+)"%s*,%s*lua_') do handBound[name] = true end
+end
+
+-- Splits "Vector2 v1, Vector2 v2" into resolved parameter types (nil if any
+-- parameter is unsupported or variadic).
+local function parse_params(list)
+    list = list:gsub("^%s+", ""):gsub("%s+$", "")
+    if list == "void" or list == "" then return {} end
+    local params = {}
+    for p in (list .. ","):gmatch("([^,]*),") do
+        if p:find("%.%.%.") or p:find("%[") then return nil end
+        local ctype = p:match("^%s*(.-)[%w_]+%s*$")
+        local t = ctype and resolve(ctype)
+        if not t or t.ctype == "void" then return nil end
+        params[#params + 1] = t
+    end
+    return params
+end
+
+local bindings, skipped = {}, {}
+local seen = {}
+for _, header in ipairs(headers) do
+    for line in read_file(header):gmatch("[^\n]+") do
+        local ret, name, plist = line:match("^%s*R[LM]API%s+([%w_ %*]-)%s*([%w_]+)%s*%(([^)]*)%)")
+        if name and not seen[name] then
+            seen[name] = true
+            if not handBound[name] then
+                local rt = resolve(ret)
+                local params = parse_params(plist)
+                -- plain char * returns are heap-allocated and need a matching unload, so they stay unsupported
+                if rt and rt.ret and params then
+                    bindings[#bindings + 1] = { name = name, header = header, ret = rt, params = params }
+                else
+                    skipped[#skipped + 1] = name
+                end
+            end
+        end
+    end
+end
+
+-- ---------------------------------------------------------------------------
+-- Output
+-- ---------------------------------------------------------------------------
+
+local function signature_of(b)
+    local codes = {}
+    for i, p in ipairs(b.params) do codes[i] = p.code end
+    return "gen_" .. b.ret.code .. "__" .. (#codes > 0 and table.concat(codes, "_") or "v")
+end
+
+local signatures, sigOrder = {}, {}
+for _, b in ipairs(bindings) do
+    b.sig = signature_of(b)
+    if not signatures[b.sig] then
+        signatures[b.sig] = b
+        sigOrder[#sigOrder + 1] = b.sig
+    end
+end
+table.sort(sigOrder)
+
+local out = {}
+local function emit(s) out[#out + 1] = s end
+
+emit([[
+// lua_raylib_generated.c — GENERATED by tools/gen_bindings.lua, do not edit.
+// Regenerate with `make generate` after upgrading raylib or adding a
+// hand-written binding (hand-written ones always take precedence).
+//
+// Bound here: every RLAPI/RMAPI function not registered by the hand-written
+// modules whose types the generator knows how to marshal. Functions are
+// grouped by signature; each signature has one marshaller that reads the Lua
+// arguments, calls the C function stored in its GenBinding upvalue and
+// pushes the result. Vector/rectangle/color/matrix results accept the usual
+// optional trailing destination argument.
+
+#include "raylib.h"
+#define RAYMATH_STATIC_INLINE
+#include "raymath.h"
+#include <lua.h>
+#include <lauxlib.h>
+#include "raylib_wrappers.h"
+
+typedef void (*gen_any_fn)(void);
+
+typedef struct GenBinding {
+    const char *name;
+    lua_CFunction marshal;
+    gen_any_fn fn;
+} GenBinding;
+
+// The C function behind the running marshaller.
+#define GEN_FN(type) ((type)((const GenBinding *)lua_touserdata(L, lua_upvalueindex(1)))->fn)
+]])
+
+emit("// ---------------------------------------------------------------------------")
+emit(string.format("// Marshallers (%d signatures)", #sigOrder))
+emit("// ---------------------------------------------------------------------------\n")
+
+for _, sig in ipairs(sigOrder) do
+    local b = signatures[sig]
+    local ctypes, argNames = {}, {}
+    for i, p in ipairs(b.params) do
+        ctypes[i] = p.ctype
+        argNames[i] = "a" .. i
+    end
+    local retType = b.ret.ctype
+    emit(string.format("typedef %s (*%s_fn)(%s);", retType, sig, #ctypes > 0 and table.concat(ctypes, ", ") or "void"))
+    emit(string.format("static int %s(lua_State *L) {", sig))
+    for i, p in ipairs(b.params) do
+        emit(string.format("    %s%sa%d = %s;", p.ctype, p.ctype:sub(-1) == "*" and "" or " ", i, string.format(p.read, i)))
+    end
+    local call = string.format("GEN_FN(%s_fn)(%s)", sig, table.concat(argNames, ", "))
+    if retType == "void" then
+        emit("    " .. call .. ";")
+        emit(b.ret.ret)
+    else
+        emit(string.format("    %s r = %s;", retType, call))
+        emit((b.ret.ret:gsub("%%d", tostring(#b.params + 1))))
+    end
+    emit("}\n")
+end
+
+emit("// ---------------------------------------------------------------------------")
+emit(string.format("// Binding table (%d functions)", #bindings))
+emit("// ---------------------------------------------------------------------------\n")
+emit("static const GenBinding generated_bindings[] = {")
+local lastHeader
+for _, b in ipairs(bindings) do
+    if b.header ~= lastHeader then
+        emit("    // " .. b.header:match("[^/]+$"))
+        lastHeader = b.header
+    end
+    emit(string.format('    {"%s", %s, (gen_any_fn)%s},', b.name, b.sig, b.name))
+end
+emit("    {NULL, NULL, NULL}")
+emit("};\n")
+
+emit([[
+// Adds every generated binding onto the module table on top of the stack,
+// leaving any name that is already there (hand-written) untouched.
+void register_generated(lua_State *L) {
+    for (const GenBinding *b = generated_bindings; b->name != NULL; b++) {
+        if (lua_getfield(L, -1, b->name) == LUA_TNIL) {
+            lua_pushlightuserdata(L, (void *)b);
+            lua_pushcclosure(L, b->marshal, 1);
+            lua_setfield(L, -3, b->name);
+        }
+        lua_pop(L, 1);
+    }
+}]])
+
+local f = assert(io.open(outPath, "w"))
+f:write(table.concat(out, "\n"), "\n")
+f:close()
+io.stderr:write(string.format("gen_bindings: %d functions, %d signatures -> %s (%d unsupported: %s)\n",
+    #bindings, #sigOrder, outPath, #skipped, table.concat(skipped, ", ")))